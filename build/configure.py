@@ -488,6 +488,11 @@ def main():
   n.variable('builddir', 'out')
   n.variable('cxx', CXX)
 
+  # For running scripts during the build.
+  python = 'python '
+  if platform == 'windows':
+    python = 'cmd /c python '
+
   if platform == 'windows':
     cflags = ['/nologo',  # Don't print startup banner.
               '/Zi',  # Create pdb with debug info.
@@ -606,21 +611,37 @@ def main():
   core_sources = [
                'app_thread.cc',
                #'backend/backend_native_win.cc',
+               'backend/backtrace_snapshot.cc',
                'backend/debug_core_gdb.cc',
                #'backend/debug_core_native_win.cc',
                'backend/gdb_mi_parse.cc',
                'backend/gdb_to_generic_converter.cc',
+               'backend/sample_profile.cc',
+               'backend/step_loop.cc',
                #'backend/process_native_win.cc',
                'backend/subprocess_win.cc',
+               'backend/symbolization_cache.cc',
                'basex/message_loop.cc',
+               'breakpoint_list.cc',
+               'breakpoints_view.cc',
+               'cache_util.cc',
                'cpp_lexer.cc',
                'debug_presenter.cc',
                'debug_presenter_display.cc',
                'display_util.cc',
+               'headless_display.cc',
+               'headless_script.cc',
+               'headless_session.cc',
+               'highlight_cache.cc',
                'lexer.cc',
                'lexer_state.cc',
+               'lexer_table.cc',
                'locals_view.cc',
                'main_loop.cc',
+               'module_list.cc',
+               'parallel_lexer.cc',
+               'profile_view.cc',
+               'regex_first_bytes.cc',
                'render/renderer.cc',
                'render/scoped_render_offset.cc',
                'render/texture.cc',
@@ -628,6 +649,11 @@ def main():
                'source_view.cc',
                'status_bar.cc',
                'stack_view.cc',
+               'syntax_highlight.cc',
+               'thread_list.cc',
+               'threads_view.cc',
+               'tracepoint_log.cc',
+               'tracepoint_log_view.cc',
                'ui/dockable.cc',
                'ui/docking_resizer.cc',
                'ui/docking_split_container.cc',
@@ -645,6 +671,17 @@ def main():
     sg_objs += cxx(name)
   n.newline()
 
+  n.comment('DFAs generated from the lexers\' token definitions.')
+  def gen(filename):
+    return os.path.normpath(os.path.join('$builddir', 'gen', filename))
+  n.rule('lexer_tables',
+         command=python + 'sg/generate_lexer_tables.py $in $out',
+         description='GEN $out')
+  n.build(gen('cpp_lexer_tables.cc'), 'lexer_tables', src('cpp_lexer.cc'),
+          implicit=[src('generate_lexer_tables.py')])
+  sg_objs += cxx('cpp_lexer_tables.cc', src=gen)
+  n.newline()
+
   re2_objs = []
   n.comment('RE2.')
   for base in GetRe2FileList():
@@ -725,12 +762,27 @@ def main():
 
   for name in [
                'lexer_test.cc',
+               'backend/backtrace_snapshot_test.cc',
                #'backend/debug_core_native_win_test.cc',
                'backend/debug_core_gdb_test.cc',
                'backend/gdb_mi_parse_test.cc',
+               'backend/gdb_to_generic_converter_test.cc',
+               'backend/sample_profile_test.cc',
+               'backend/step_loop_test.cc',
                'backend/subprocess_test.cc',
+               'backend/symbolization_cache_test.cc',
                'basex/concurrent_queue_test.cc',
                'basex/message_loop_test.cc',
+               'breakpoint_list_test.cc',
+               'cache_util_test.cc',
+               'headless_display_test.cc',
+               'highlight_cache_test.cc',
+               'module_list_test.cc',
+               'parallel_lexer_test.cc',
+               'regex_first_bytes_test.cc',
+               'syntax_highlight_test.cc',
+               'thread_list_test.cc',
+               'tracepoint_log_test.cc',
                'ui/docking_test.cc',
               ]:
     test_objs += cxx(name, variables=[('cflags', test_cflags)])
@@ -745,6 +797,33 @@ def main():
   all_targets += sg_test
   n.newline()
 
+  n.comment('Scripted sessions without a window, writing JSON.')
+  headless_objs = cxx('headless_main.cc')
+  sg_headless = n.build(binary('sg_headless'), 'link',
+                        inputs=headless_objs + app_objs,
+                        variables=[('ldflags', test_ldflags),
+                                   ('libs', libs)])
+  all_targets += sg_headless
+  n.newline()
+
+  n.comment('Relexing after single character edits vs. lexing the file.')
+  relex_benchmark_objs = cxx('relex_benchmark.cc')
+  relex_benchmark = n.build(binary('relex_benchmark'), 'link',
+                            inputs=relex_benchmark_objs + app_objs,
+                            variables=[('ldflags', test_ldflags),
+                                       ('libs', libs)])
+  all_targets += relex_benchmark
+  n.newline()
+
+  n.comment('Lexing throughput on test_data/lexer_corpus.')
+  lexer_benchmark_objs = cxx('lexer_benchmark.cc')
+  lexer_benchmark = n.build(binary('lexer_benchmark'), 'link',
+                            inputs=lexer_benchmark_objs + app_objs,
+                            variables=[('ldflags', test_ldflags),
+                                       ('libs', libs)])
+  all_targets += lexer_benchmark
+  n.newline()
+
   reader_writer_objs = []
   reader_writer_objs += cxx('backend/reader_writer_test.cc') + pch_objs
   reader_writer_test = n.build(binary('reader_writer_test'), 'link',
@@ -756,11 +835,8 @@ def main():
   n.newline()
 
   n.comment('Regenerate build files if build script changes.')
-  prefix = ''
-  if platform == 'windows':
-    prefix = 'cmd /c '
   n.rule('configure',
-          command=prefix + 'python build/configure.py $configure_args',
+          command=python + 'build/configure.py $configure_args',
           generator=True)
   n.build('build.ninja', 'configure',
           implicit=[os.path.normpath('build/configure.py'),
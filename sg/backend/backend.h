@@ -10,6 +10,14 @@
 
 #include "sg/basex/string16.h"
 
+// The debugger's id for a thread, e.g. gdb's thread number.
+typedef int ThreadId;
+
+enum ThreadState {
+  THREAD_STOPPED,
+  THREAD_RUNNING,
+};
+
 class TypeNameValue {
  public:
   string16 type;
@@ -26,31 +34,205 @@ class FrameData {
   std::vector<TypeNameValue> arguments;
 };
 
+// A breakpoint as the UI knows it. |id| is the UI's, not the debugger's.
+class BreakpointData {
+ public:
+  int id;
+  string16 filename;
+  int line_number;
+  bool enabled;
+};
+
+// What the debugger needs to do to bring its breakpoints in line with the
+// UI's, however many there are, by id.
+class BreakpointChangesData {
+ public:
+  std::vector<BreakpointData> inserted;
+  std::vector<int> deleted;
+  std::vector<int> enabled;
+  std::vector<int> disabled;
+};
+
+// The debugger refused to insert breakpoint |id|, e.g. because its location
+// doesn't make sense to it.
+class BreakpointInsertFailedData {
+ public:
+  int id;
+  string16 message;
+};
+
 class StoppedAtBreakpointData {
  public:
+  // The thread that stopped. In non-stop mode, the others keep running.
+  ThreadId thread_id;
   FrameData frame;
 };
 
-class LibraryLoadedData {
+class LibraryEvent {
  public:
+  enum Kind {
+    LOADED,
+    UNLOADED,
+  };
+  Kind kind;
   string16 host_path;
   string16 target_path;
   string16 thread_id;
+  // Always false for unloads.
   bool symbols_loaded;
 };
 
-class LibraryUnloadedData {
+// Library loads and unloads are batched by the backend rather than sent
+// one-by-one, as a large process can load thousands at startup.
+class LibrariesChangedData {
  public:
-  string16 host_path;
-  string16 target_path;
-  string16 thread_id;
+  // In the order they happened, so that a library that's unloaded and
+  // loaded again within a batch ends up loaded.
+  std::vector<LibraryEvent> events;
 };
 
 class StoppedAfterSteppingData {
  public:
+  ThreadId thread_id;
   FrameData frame;
 };
 
+class ProcessExitedData {
+ public:
+  int exit_code;
+  // Empty unless it was killed by a signal, e.g. "SIGSEGV".
+  string16 signal_name;
+};
+
+// A core file has been opened, and can be looked at as if the target had
+// stopped where it crashed.
+class CoreLoadedData {
+ public:
+  // The thread that received the fatal signal.
+  ThreadId thread_id;
+  FrameData frame;
+  // e.g. "Segmentation fault", or empty if the backend doesn't know.
+  string16 signal_description;
+};
+
+enum StepLoopEndReason {
+  STEP_LOOP_LIMIT_REACHED,
+  STEP_LOOP_CONDITION_MET,
+  // The condition couldn't be evaluated, e.g. a variable's out of scope.
+  STEP_LOOP_CONDITION_FAILED,
+  STEP_LOOP_CANCELLED,
+  // The target stopped for some other reason, e.g. a breakpoint.
+  STEP_LOOP_INTERRUPTED,
+  // The backend was busy stepping or profiling already, so it never started.
+  // No stop follows.
+  STEP_LOOP_REFUSED,
+};
+
+// How a series of steps run inside the backend went. The UI isn't told
+// about the steps in between, only the stop at the end, which follows this.
+class StepLoopData {
+ public:
+  int steps;
+  double duration_ms;
+  StepLoopEndReason reason;
+  // For STEP_LOOP_CONDITION_FAILED, the debugger's message.
+  string16 error;
+};
+
+// Threads that have been resumed. In all-stop mode, that's all of them.
+class ThreadsRunningData {
+ public:
+  std::vector<ThreadId> thread_ids;
+};
+
+class ThreadData {
+ public:
+  ThreadId id;
+  // The OS's name for the thread, e.g. "Thread 11652.0x2c".
+  string16 target_id;
+  ThreadState state;
+  // The top frame, as of when the thread last stopped.
+  FrameData frame;
+};
+
+// After the first retrieval, only threads that have stopped or been created
+// since the previous one are fetched, so that a stop in a process with
+// thousands of threads doesn't wait on all of them. If |complete|, |threads|
+// is all of them instead, and any that aren't in it have gone away.
+class RetrievedThreadsData {
+ public:
+  bool complete;
+  std::vector<ThreadData> threads;
+  std::vector<ThreadId> exited;
+};
+
+class ThreadStackData {
+ public:
+  ThreadId id;
+  string16 target_id;
+  // Empty if the stack couldn't be retrieved, e.g. for a running thread in
+  // non-stop mode.
+  std::vector<FrameData> frames;
+};
+
+// All the threads' stacks at one moment, with threads that have identical
+// stacks grouped together. Groups are ordered largest first, as in a hung
+// process most threads are usually waiting in the same few places.
+class BacktraceSnapshotData {
+ public:
+  struct Group {
+    std::vector<ThreadId> thread_ids;
+    std::vector<string16> target_ids;
+    std::vector<FrameData> frames;
+  };
+  std::vector<Group> groups;
+  int thread_count;
+  // Time taken to convert and group the stacks, once the debugger had
+  // supplied them.
+  double processing_ms;
+};
+
+// A function in a sampled call tree, reached by the path of calls from the
+// root to it.
+class ProfileNode {
+ public:
+  string16 function;
+  // Stacks that passed through this node, and those that ended at it.
+  int total;
+  int self;
+  // Indices into ProfileData::nodes, largest |total| first.
+  std::vector<int> children;
+};
+
+// Where the target's threads were found while it was being sampled. The
+// first node is the root, which has no function and covers every stack.
+// The target is stopped to take each sample, so how long that took is
+// reported too, as it slows the target down.
+class ProfileData {
+ public:
+  std::vector<ProfileNode> nodes;
+  // Times the target was stopped, and thread stacks captured altogether.
+  int sample_count;
+  int stack_count;
+  double duration_ms;
+  double mean_pause_us;
+  double max_pause_us;
+};
+
+// Output from tracepoints, which print and continue without stopping the
+// target. They can fire far faster than the UI could handle one
+// notification each, so their output is sent in batches.
+class TracepointHit {
+ public:
+  int tracepoint_id;
+  string16 text;
+};
+
+class TracepointOutputData {
+ public:
+  std::vector<TracepointHit> hits;
+};
+
 class RetrievedStackData {
  public:
   std::vector<FrameData> frames;
@@ -98,17 +280,27 @@ class DebugNotification {
   virtual ~DebugNotification() {}
 
   virtual void OnProcessLoaded() {}
+  virtual void OnBreakpointInsertFailed(
+      const BreakpointInsertFailedData& data) {}
   virtual void OnStoppedAtBreakpoint(const StoppedAtBreakpointData& data) {}
   virtual void OnStoppedAfterStepping(const StoppedAfterSteppingData& data) {}
-  virtual void OnLibraryLoaded(const LibraryLoadedData& data) {}
-  virtual void OnLibraryUnloaded(const LibraryUnloadedData& data) {}
+  virtual void OnStepLoopFinished(const StepLoopData& data) {}
+  virtual void OnProcessExited(const ProcessExitedData& data) {}
+  virtual void OnCoreLoaded(const CoreLoadedData& data) {}
+  virtual void OnThreadsRunning(const ThreadsRunningData& data) {}
+  virtual void OnLibrariesChanged(const LibrariesChangedData& data) {}
+  virtual void OnRetrievedThreads(const RetrievedThreadsData& data) {}
   virtual void OnRetrievedStack(const RetrievedStackData& data) {}
+  virtual void OnBacktraceSnapshot(const BacktraceSnapshotData& data) {}
+  virtual void OnProfileCollected(const ProfileData& data) {}
+  virtual void OnTracepointOutput(const TracepointOutputData& data) {}
   virtual void OnRetrievedLocals(const RetrievedLocalsData& data) {}
   virtual void OnWatchCreated(const WatchCreatedData& data) {}
   virtual void OnWatchesUpdated(const WatchesUpdatedData& data) {}
   virtual void OnWatchChildList(const WatchesChildListData& data) {}
   virtual void OnConsoleOutput(const string16& data) {}
   virtual void OnInternalDebugOutput(const string16& data) {}
+  virtual void OnSynced(int sync_id) {}
 };
 
 // TODO(backend): Generic-ize debug_core_gdb to here.
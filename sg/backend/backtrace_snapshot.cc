@@ -0,0 +1,157 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/backend/backtrace_snapshot.h"
+
+#include <algorithm>
+#include <map>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/stringprintf.h"
+#include "base/threading/worker_pool.h"
+#include "base/utf_string_conversions.h"
+#include "base/values.h"
+#include "sg/backend/gdb_to_generic_converter.h"
+
+namespace {
+
+// Below this, splitting the work up costs more than it saves.
+const size_t kMinThreadsPerTask = 32;
+
+bool LargerGroupFirst(const BacktraceSnapshotData::Group& a,
+                      const BacktraceSnapshotData::Group& b) {
+  if (a.thread_ids.size() != b.thread_ids.size())
+    return a.thread_ids.size() > b.thread_ids.size();
+  return a.thread_ids[0] < b.thread_ids[0];
+}
+
+}  // namespace
+
+BacktraceSnapshotBuilder::BacktraceSnapshotBuilder() : remaining_tasks_(0) {
+}
+
+BacktraceSnapshotBuilder::~BacktraceSnapshotBuilder() {
+  for (size_t i = 0; i < raw_frames_.size(); ++i)
+    delete raw_frames_[i];
+}
+
+void BacktraceSnapshotBuilder::AddThread(ThreadId id,
+                                         const string16& target_id,
+                                         base::ListValue* frames) {
+  ThreadStackData thread;
+  thread.id = id;
+  thread.target_id = target_id;
+  threads_.push_back(thread);
+  raw_frames_.push_back(frames);
+}
+
+void BacktraceSnapshotBuilder::Start(int max_tasks,
+                                     const DoneCallback& done) {
+  DCHECK_GE(max_tasks, 1);
+  done_ = done;
+  start_time_ = base::TimeTicks::Now();
+  size_t num_tasks = std::min(
+      static_cast<size_t>(max_tasks),
+      std::max<size_t>(1, threads_.size() / kMinThreadsPerTask));
+  if (num_tasks == 1) {
+    base::AtomicRefCountInc(&remaining_tasks_);
+    ConvertRange(0, threads_.size());
+    return;
+  }
+  // Set before any task is posted, as the first could finish before the
+  // last is posted.
+  base::AtomicRefCountIncN(&remaining_tasks_, static_cast<int>(num_tasks));
+  size_t per_task = (threads_.size() + num_tasks - 1) / num_tasks;
+  for (size_t i = 0; i < num_tasks; ++i) {
+    size_t begin = std::min(i * per_task, threads_.size());
+    size_t end = std::min(begin + per_task, threads_.size());
+    base::WorkerPool::PostTask(FROM_HERE,
+        base::Bind(&BacktraceSnapshotBuilder::ConvertRange, this, begin, end),
+        false);
+  }
+}
+
+void BacktraceSnapshotBuilder::ConvertRange(size_t begin, size_t end) {
+  // Tasks write only to their own slice of |threads_|, so don't need to
+  // lock.
+  for (size_t i = begin; i < end; ++i) {
+    if (!raw_frames_[i])
+      continue;
+    RetrievedStackData stack = RetrievedStackDataFromList(raw_frames_[i]);
+    threads_[i].frames.swap(stack.frames);
+    delete raw_frames_[i];
+    raw_frames_[i] = NULL;
+  }
+  if (base::AtomicRefCountDec(&remaining_tasks_))
+    return;
+
+  // The last to finish. The decrement is a barrier, so the other tasks'
+  // results are visible.
+  BacktraceSnapshotData data;
+  GroupThreadsByStack(threads_, &data);
+  data.processing_ms =
+      (base::TimeTicks::Now() - start_time_).InMillisecondsF();
+  done_.Run(data);
+}
+
+void GroupThreadsByStack(const std::vector<ThreadStackData>& threads,
+                         BacktraceSnapshotData* data) {
+  data->groups.clear();
+  data->thread_count = static_cast<int>(threads.size());
+  std::map<std::vector<uintptr_t>, size_t> group_for_stack;
+  std::vector<uintptr_t> addresses;
+  for (size_t i = 0; i < threads.size(); ++i) {
+    const ThreadStackData& thread = threads[i];
+    addresses.resize(thread.frames.size());
+    for (size_t j = 0; j < thread.frames.size(); ++j)
+      addresses[j] = thread.frames[j].address;
+    std::map<std::vector<uintptr_t>, size_t>::iterator it =
+        group_for_stack.find(addresses);
+    if (it == group_for_stack.end()) {
+      it = group_for_stack.insert(
+          std::make_pair(addresses, data->groups.size())).first;
+      data->groups.push_back(BacktraceSnapshotData::Group());
+      data->groups.back().frames = thread.frames;
+    }
+    BacktraceSnapshotData::Group& group = data->groups[it->second];
+    group.thread_ids.push_back(thread.id);
+    group.target_ids.push_back(thread.target_id);
+  }
+  std::sort(data->groups.begin(), data->groups.end(), LargerGroupFirst);
+}
+
+std::string FormatBacktraceSnapshot(const BacktraceSnapshotData& data) {
+  std::string result = base::StringPrintf(
+      "%d threads, %d distinct stacks\n",
+      data.thread_count, static_cast<int>(data.groups.size()));
+  for (size_t i = 0; i < data.groups.size(); ++i) {
+    const BacktraceSnapshotData::Group& group = data.groups[i];
+    result += base::StringPrintf(
+        "\n%d thread%s:", static_cast<int>(group.thread_ids.size()),
+        group.thread_ids.size() == 1 ? "" : "s");
+    for (size_t j = 0; j < group.thread_ids.size(); ++j) {
+      result += base::StringPrintf(
+          " %d (%s)", group.thread_ids[j],
+          UTF16ToUTF8(group.target_ids[j]).c_str());
+    }
+    result += "\n";
+    if (group.frames.empty())
+      result += "  (no stack)\n";
+    for (size_t j = 0; j < group.frames.size(); ++j) {
+      const FrameData& frame = group.frames[j];
+      result += base::StringPrintf(
+          "#%-3d 0x%08lx in %s", static_cast<int>(j),
+          static_cast<unsigned long>(frame.address),
+          UTF16ToUTF8(frame.function).c_str());
+      if (!frame.filename.empty()) {
+        result += base::StringPrintf(
+            " at %s:%d", UTF16ToUTF8(frame.filename).c_str(),
+            frame.line_number);
+      }
+      result += "\n";
+    }
+  }
+  return result;
+}
@@ -0,0 +1,68 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BACKEND_BACKTRACE_SNAPSHOT_H_
+#define SG_BACKEND_BACKTRACE_SNAPSHOT_H_
+
+#include <string>
+#include <vector>
+
+#include "base/atomic_ref_count.h"
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/time.h"
+#include "sg/backend/backend.h"
+
+namespace base {
+class ListValue;
+}
+
+// Builds a snapshot from the stacks gdb returned for each thread. With a
+// thousand threads that's tens of thousands of frames, so they're converted
+// on the worker pool, a slice of the threads per task. The last task to
+// finish groups them and runs the callback, on its worker pool thread.
+class BacktraceSnapshotBuilder
+    : public base::RefCountedThreadSafe<BacktraceSnapshotBuilder> {
+ public:
+  typedef base::Callback<void(const BacktraceSnapshotData&)> DoneCallback;
+
+  BacktraceSnapshotBuilder();
+
+  // Takes ownership of |frames|, the "stack" list from -stack-list-frames,
+  // which is NULL if the thread's stack couldn't be retrieved.
+  void AddThread(ThreadId id,
+                 const string16& target_id,
+                 base::ListValue* frames);
+
+  // Converts on up to |max_tasks| worker pool tasks. If that's 1, the work
+  // is done before returning instead.
+  void Start(int max_tasks, const DoneCallback& done);
+
+ private:
+  friend class base::RefCountedThreadSafe<BacktraceSnapshotBuilder>;
+  ~BacktraceSnapshotBuilder();
+
+  void ConvertRange(size_t begin, size_t end);
+
+  std::vector<ThreadStackData> threads_;
+  // Parallel to |threads_|, and freed as they're converted.
+  std::vector<base::ListValue*> raw_frames_;
+
+  base::AtomicRefCount remaining_tasks_;
+  base::TimeTicks start_time_;
+  DoneCallback done_;
+
+  DISALLOW_COPY_AND_ASSIGN(BacktraceSnapshotBuilder);
+};
+
+// Groups |threads| that have the same stack, i.e. frames at the same
+// addresses, into |data|.
+void GroupThreadsByStack(const std::vector<ThreadStackData>& threads,
+                         BacktraceSnapshotData* data);
+
+// Text for exporting a snapshot, like pstack's but a group at a time.
+std::string FormatBacktraceSnapshot(const BacktraceSnapshotData& data);
+
+#endif  // SG_BACKEND_BACKTRACE_SNAPSHOT_H_
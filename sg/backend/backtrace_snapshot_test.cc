@@ -0,0 +1,120 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "base/bind.h"
+#include "base/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/values.h"
+#include "sg/backend/backtrace_snapshot.h"
+#include "sg/backend/gdb_mi_parse.h"
+
+namespace {
+
+// A "stack" list as from -stack-list-frames, with |depth| frames, the
+// innermost at |top|.
+base::ListValue* MakeStack(int depth, uintptr_t top) {
+  std::string text = "^done,stack=[";
+  for (int i = 0; i < depth; ++i) {
+    text += base::StringPrintf(
+        "%sframe={level=\"%d\",addr=\"0x%lx\",func=\"Function%d\","
+        "file=\"test_binary.cc\",line=\"%d\"}",
+        i == 0 ? "" : ",", i, static_cast<unsigned long>(top + i * 16),
+        i, 10 + i);
+  }
+  text += "]\r";
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> record(p.Parse(text, NULL));
+  base::ListValue* list_value;
+  CHECK(record->results()[0]->value()->GetAsList(&list_value));
+  base::ListValue* frames = new base::ListValue;
+  frames->Swap(list_value);
+  return frames;
+}
+
+void SaveSnapshot(BacktraceSnapshotData* result,
+                  const BacktraceSnapshotData& data) {
+  *result = data;
+}
+
+void SaveSnapshotAndSignal(BacktraceSnapshotData* result,
+                           base::WaitableEvent* done,
+                           const BacktraceSnapshotData& data) {
+  *result = data;
+  done->Signal();
+}
+
+}  // namespace
+
+TEST(BacktraceSnapshot, Grouping) {
+  scoped_refptr<BacktraceSnapshotBuilder> builder(
+      new BacktraceSnapshotBuilder);
+  builder->AddThread(1, L"Thread 1", MakeStack(3, 0x1000));
+  builder->AddThread(2, L"Thread 2", MakeStack(5, 0x2000));
+  builder->AddThread(3, L"Thread 3", MakeStack(5, 0x2000));
+  builder->AddThread(4, L"Thread 4", NULL);
+  // Same functions, but called from somewhere else.
+  builder->AddThread(5, L"Thread 5", MakeStack(4, 0x2000));
+  BacktraceSnapshotData data;
+  builder->Start(1, base::Bind(&SaveSnapshot, &data));
+
+  EXPECT_EQ(5, data.thread_count);
+  ASSERT_EQ(4, data.groups.size());
+  ASSERT_EQ(2, data.groups[0].thread_ids.size());
+  EXPECT_EQ(2, data.groups[0].thread_ids[0]);
+  EXPECT_EQ(3, data.groups[0].thread_ids[1]);
+  EXPECT_EQ(L"Thread 3", data.groups[0].target_ids[1]);
+  ASSERT_EQ(5, data.groups[0].frames.size());
+  EXPECT_EQ(L"Function4", data.groups[0].frames[4].function);
+  EXPECT_EQ(1, data.groups[1].thread_ids[0]);
+  EXPECT_EQ(4, data.groups[2].thread_ids[0]);
+  EXPECT_EQ(0, data.groups[2].frames.size());
+  EXPECT_EQ(5, data.groups[3].thread_ids[0]);
+}
+
+TEST(BacktraceSnapshot, Format) {
+  scoped_refptr<BacktraceSnapshotBuilder> builder(
+      new BacktraceSnapshotBuilder);
+  builder->AddThread(7, L"Thread 7", MakeStack(2, 0x401000));
+  builder->AddThread(8, L"Thread 8", NULL);
+  builder->AddThread(9, L"Thread 9", MakeStack(2, 0x401000));
+  BacktraceSnapshotData data;
+  builder->Start(1, base::Bind(&SaveSnapshot, &data));
+  EXPECT_EQ("3 threads, 2 distinct stacks\n"
+            "\n"
+            "2 threads: 7 (Thread 7) 9 (Thread 9)\n"
+            "#0   0x00401000 in Function0 at test_binary.cc:10\n"
+            "#1   0x00401010 in Function1 at test_binary.cc:11\n"
+            "\n"
+            "1 thread: 8 (Thread 8)\n"
+            "  (no stack)\n",
+            FormatBacktraceSnapshot(data));
+}
+
+TEST(BacktraceSnapshot, ManyThreadsInParallel) {
+  scoped_refptr<BacktraceSnapshotBuilder> builder(
+      new BacktraceSnapshotBuilder);
+  // Mostly idle in the same place, as in a typical hang.
+  for (int i = 0; i < 1000; ++i) {
+    builder->AddThread(i + 1,
+                       L"Thread",
+                       MakeStack(50, i % 10 == 0 ? 0x10000 * i : 0x1000));
+  }
+  BacktraceSnapshotData data;
+  base::WaitableEvent done(false, false);
+  builder->Start(4, base::Bind(&SaveSnapshotAndSignal, &data, &done));
+  done.Wait();
+
+  EXPECT_EQ(1000, data.thread_count);
+  // Every tenth thread has a stack of its own.
+  ASSERT_EQ(101, data.groups.size());
+  EXPECT_EQ(900, data.groups[0].thread_ids.size());
+  EXPECT_EQ(2, data.groups[0].thread_ids[0]);
+  EXPECT_EQ(50, data.groups[0].frames.size());
+  EXPECT_EQ(0x1000 + 49 * 16, data.groups[0].frames[49].address);
+}
@@ -4,20 +4,32 @@
 
 #include "sg/backend/debug_core_gdb.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 
 #include "base/bind.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
+#include "base/memory/weak_ptr.h"
 #include "base/message_loop.h"
 #include "base/string_number_conversions.h"
 #include "base/string_util.h"
+#include "base/stl_util.h"
+#include "base/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/time.h"
 #include "base/utf_string_conversions.h"
 #include "sg/app_thread.h"
+#include "sg/backend/backtrace_snapshot.h"
 #include "sg/backend/gdb_mi_parse.h"
 #include "sg/backend/gdb_to_generic_converter.h"
+#include "sg/backend/sample_profile.h"
+#include "sg/backend/step_loop.h"
+#include "sg/backend/symbolization_cache.h"
 #include "sg/basex/string16.h"
 
 #ifndef NDEBUG
@@ -27,6 +39,95 @@ static base::FilePath g_debug_log_path =
 #endif
 #endif
 
+namespace {
+
+// Library load/unload notifications are coalesced for this long before being
+// sent to the UI. During startup of a large process gdb reports thousands of
+// them, and one UI task (and repaint) per library is far too slow.
+const int kLibraryEventCoalesceMs = 50;
+
+// When more threads than this have changed since they were last retrieved
+// (e.g. every thread, after an all-stop), one -thread-info for all of them
+// is cheaper than one per thread.
+const size_t kMaxThreadsToRefreshIndividually = 16;
+
+// Tracepoint output is batched for this long before being sent to the UI,
+// as for library events. A tracepoint in a hot loop can print many
+// thousands of lines a second.
+const int kTracepointOutputCoalesceMs = 50;
+
+// Deeper stacks are truncated in snapshots, so that one thread in a runaway
+// recursion doesn't hold up the rest.
+const int kMaxSnapshotFrames = 200;
+
+// Profiles only need the innermost frames, and gdb symbolizes every frame
+// it returns while the target waits.
+const int kMaxProfileFrames = 32;
+
+// Called on the worker pool when a snapshot has been built.
+void PostBacktraceSnapshot(DebugNotification* debug_notification,
+                           const BacktraceSnapshotData& data) {
+  AppThread::PostTask(AppThread::UI, FROM_HERE,
+      base::Bind(&DebugNotification::OnBacktraceSnapshot,
+                 base::Unretained(debug_notification), data));
+}
+
+// Identifies an image the way symbol servers do, by its link timestamp and
+// size. |image_base| is where it's linked to load, and |relocatable| is set
+// if it may be loaded elsewhere.
+bool GetImageIdentity(const string16& path,
+                      std::string* build_id,
+                      uint64* image_base,
+                      uint64* image_size,
+                      bool* relocatable) {
+  base::MemoryMappedFile file;
+  if (!file.Initialize(base::FilePath(path)) ||
+      file.length() < sizeof(IMAGE_DOS_HEADER)) {
+    return false;
+  }
+  const IMAGE_DOS_HEADER* dos_header =
+      reinterpret_cast<const IMAGE_DOS_HEADER*>(file.data());
+  if (dos_header->e_magic != IMAGE_DOS_SIGNATURE ||
+      dos_header->e_lfanew < 0 ||
+      static_cast<size_t>(dos_header->e_lfanew) + sizeof(IMAGE_NT_HEADERS64) >
+          file.length()) {
+    return false;
+  }
+  const IMAGE_NT_HEADERS32* nt_headers =
+      reinterpret_cast<const IMAGE_NT_HEADERS32*>(
+          file.data() + dos_header->e_lfanew);
+  if (nt_headers->Signature != IMAGE_NT_SIGNATURE)
+    return false;
+  WORD dll_characteristics;
+  if (nt_headers->OptionalHeader.Magic == IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+    const IMAGE_OPTIONAL_HEADER64& optional_header =
+        reinterpret_cast<const IMAGE_NT_HEADERS64*>(nt_headers)->
+            OptionalHeader;
+    *image_base = optional_header.ImageBase;
+    *image_size = optional_header.SizeOfImage;
+    dll_characteristics = optional_header.DllCharacteristics;
+  } else {
+    *image_base = nt_headers->OptionalHeader.ImageBase;
+    *image_size = nt_headers->OptionalHeader.SizeOfImage;
+    dll_characteristics = nt_headers->OptionalHeader.DllCharacteristics;
+  }
+  *relocatable =
+      (dll_characteristics & IMAGE_DLLCHARACTERISTICS_DYNAMIC_BASE) != 0;
+  *build_id = base::StringPrintf("%08X%x",
+                                 nt_headers->FileHeader.TimeDateStamp,
+                                 static_cast<uint32>(*image_size));
+  return true;
+}
+
+// Symbolizes profile samples with the names gdb gave when it returned them.
+string16 GetProfileFunction(const std::map<uint64, string16>* functions,
+                            uint64 address) {
+  std::map<uint64, string16>::const_iterator it = functions->find(address);
+  return it == functions->end() ? L"??" : it->second;
+}
+
+}  // namespace
+
 // Handles async reads and writes to subprocess. Read and write on the same
 // object to simplify blocking on shutdown.
 class ReaderWriter : public MessageLoopForIO::IOHandler {
@@ -36,7 +137,23 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
         write_state_(output),
         terminating_(false),
         debug_notification_(NULL),
-        got_stack_frames_waiting_for_arguments_(false) {
+        got_stack_frames_waiting_for_arguments_(false),
+        library_flush_scheduled_(false),
+        tracepoint_flush_scheduled_(false),
+        image_base_(0),
+        image_size_(0),
+        image_relocatable_(false),
+        image_base_known_(false),
+        selected_thread_(0),
+        target_pid_(0),
+        have_threads_(false),
+        sample_pending_(false),
+        sample_breaking_in_(false),
+        sample_break_thread_(0),
+        capturing_sample_(false),
+        stop_profiling_(false),
+        weak_factory_(this) {
+    pending_threads_.complete = false;
     MessageLoopForIO::current()->RegisterIOHandler(input, this);
     MessageLoopForIO::current()->RegisterIOHandler(output, this);
     read_state_.context.handler = this;
@@ -51,6 +168,7 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
   }
 
   virtual ~ReaderWriter() {
+    STLDeleteValues(&snapshot_stacks_);
     // Prevent read from restarting.
     terminating_ = true;
     pending_writes_.clear();
@@ -111,8 +229,20 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
     memset(write_state_.buffer, 0xcc, sizeof(write_state_.buffer));
 #endif
     if (!pending_writes_.empty()) {
+      // Everything queued meanwhile goes in one write, as much as fits, so
+      // that a batch of commands (e.g. hundreds of breakpoints) isn't a
+      // write and a completion each.
       string16 to_send = pending_writes_.front();
       pending_writes_.pop_front();
+      size_t narrow_size = UTF16ToUTF8(to_send).size();
+      while (!pending_writes_.empty()) {
+        size_t next_size = UTF16ToUTF8(pending_writes_.front()).size();
+        if (narrow_size + next_size > sizeof(write_state_.buffer))
+          break;
+        to_send += pending_writes_.front();
+        narrow_size += next_size;
+        pending_writes_.pop_front();
+      }
       SendString(to_send);
     }
   }
@@ -121,12 +251,396 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
     debug_notification_ = debug_notification;
   }
 
+  void SetExecutable(const string16& application) {
+    symbolization_cache_.reset();
+    if (!GetImageIdentity(application, &build_id_, &image_base_,
+                          &image_size_, &image_relocatable_)) {
+      return;
+    }
+    image_base_known_ = !image_relocatable_;
+    symbolization_cache_.reset(new SymbolizationCache);
+    if (!symbolization_cache_->Open(SymbolizationCache::GetDefaultPath()))
+      symbolization_cache_.reset();
+  }
+
+  // Called as the target's run. Returns true if where the executable was
+  // loaded needs to be looked up, with the result going to
+  // HandlerImageBase(), as it can be relocated differently each run.
+  bool StartRun() {
+    if (!symbolization_cache_ || !image_relocatable_)
+      return false;
+    image_base_known_ = false;
+    return true;
+  }
+
+  // The thread that last stopped, unless the user has picked another since.
+  ThreadId selected_thread() const { return selected_thread_; }
+  void set_selected_thread(ThreadId thread_id) {
+    selected_thread_ = thread_id;
+  }
+
+  // gdb reports threads from when the target starts until it exits.
+  bool target_started() const { return !thread_states_.empty(); }
+
+  // The target's process id while it's running, or 0.
+  DWORD target_pid() const { return target_pid_; }
+
+  // Threads not in here haven't been reported by gdb.
+  ThreadState GetThreadState(ThreadId thread_id) const {
+    std::map<ThreadId, ThreadState>::const_iterator it =
+        thread_states_.find(thread_id);
+    return it == thread_states_.end() ? THREAD_STOPPED : it->second;
+  }
+
+  // Decides what DebugCoreGdb::GetThreads() needs to fetch. Returns true if
+  // that's all of them, otherwise fills |thread_ids| with those that have
+  // changed since the last retrieval.
+  bool StartThreadRefresh(std::vector<ThreadId>* thread_ids) {
+    if (!have_threads_ ||
+        threads_changed_.size() > kMaxThreadsToRefreshIndividually) {
+      have_threads_ = true;
+      threads_changed_.clear();
+      threads_exited_.clear();
+      // Supersedes anything left from an earlier refresh.
+      pending_threads_.threads.clear();
+      pending_threads_.exited.clear();
+      pending_threads_.complete = true;
+      return true;
+    }
+    thread_ids->assign(threads_changed_.begin(), threads_changed_.end());
+    threads_changed_.clear();
+    pending_threads_.exited.insert(pending_threads_.exited.end(),
+                                   threads_exited_.begin(),
+                                   threads_exited_.end());
+    threads_exited_.clear();
+    return false;
+  }
+
+  // Leaves out the thread that was started in the target to break into
+  // it, whose stack is always the same.
+  void GetThreadIdsToSample(std::vector<ThreadId>* thread_ids) const {
+    for (std::map<ThreadId, ThreadState>::const_iterator it =
+             thread_states_.begin();
+         it != thread_states_.end(); ++it) {
+      if (it->first != sample_break_thread_)
+        thread_ids->push_back(it->first);
+    }
+  }
+
+  // |threads| are those gdb listed for a snapshot, whose stacks are about
+  // to be requested.
+  void StartBacktraceSnapshot(const RetrievedThreadsData& threads) {
+    STLDeleteValues(&snapshot_stacks_);
+    snapshot_threads_ = threads;
+  }
+
+  bool profiling() const { return profile_.get() != NULL; }
+
+  // Starts collecting a profile. Once the target stops for a sample and all
+  // its threads are stopped, |capture_sample| is run to request their
+  // stacks and continue it, and once it's running again |sample_done| is
+  // run to schedule the next one.
+  void StartProfiling(const base::Closure& capture_sample,
+                      const base::Closure& sample_done) {
+    DCHECK(!profiling());
+    profile_.reset(new SampleProfileBuilder);
+    profile_start_ = base::TimeTicks::Now();
+    capture_sample_ = capture_sample;
+    sample_done_ = sample_done;
+    sample_pending_ = false;
+    sample_breaking_in_ = false;
+    sample_break_thread_ = 0;
+    capturing_sample_ = false;
+    stop_profiling_ = false;
+  }
+
+  // Called just before interrupting the target for a sample, by breaking
+  // into it if |breaking_in|. Returns false if profiling has finished
+  // meanwhile.
+  bool StartProfileSample(bool breaking_in) {
+    if (!profiling())
+      return false;
+    sample_pending_ = true;
+    sample_breaking_in_ = breaking_in;
+    sample_break_thread_ = 0;
+    sample_start_ = base::TimeTicks::Now();
+    return true;
+  }
+
+  // The next interrupt stops the target for good, rather than sampling it.
+  void StopProfiling() {
+    if (profiling())
+      stop_profiling_ = true;
+  }
+
+  bool stepping() const { return step_loop_.get() != NULL; }
+
+  // Starts stepping up to |max_steps| times. After each step, |step| is run
+  // to take the next one, or |evaluate_condition| to check whether to, and
+  // the result goes to HandlerStepLoopCondition(). Only the last stop is
+  // reported.
+  void StartStepLoop(int max_steps,
+                     const base::Closure& step,
+                     const base::Closure& evaluate_condition) {
+    DCHECK(!stepping());
+    step_loop_.reset(new StepLoop(max_steps, !evaluate_condition.is_null()));
+    step_loop_start_ = base::TimeTicks::Now();
+    step_ = step;
+    evaluate_step_condition_ = evaluate_condition;
+  }
+
+  void CancelStepLoop() {
+    if (stepping())
+      step_loop_->Cancel();
+  }
+
+  // Tells the UI a step loop it asked for couldn't start, so that it doesn't
+  // wait for one.
+  void RefuseStepLoop() {
+    StepLoopData data;
+    data.steps = 0;
+    data.duration_ms = 0;
+    data.reason = STEP_LOOP_REFUSED;
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnStepLoopFinished,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  void set_step_condition_token(int64 token) {
+    step_condition_token_ = base::Int64ToString(token);
+  }
+
+  void StartBreakpointInsert(int id) {
+    inserting_breakpoints_.insert(id);
+  }
+
+  // Returns gdb's number for breakpoint |id|, and forgets it. If it's
+  // still being inserted, returns "" and deletes it once it's in.
+  string16 TakeBreakpointNumberForDelete(int id) {
+    std::map<int, string16>::iterator it = breakpoint_numbers_.find(id);
+    if (it == breakpoint_numbers_.end()) {
+      if (inserting_breakpoints_.count(id))
+        deferred_breakpoint_deletes_.insert(id);
+      return string16();
+    }
+    string16 number = it->second;
+    breakpoint_numbers_.erase(it);
+    return number;
+  }
+
+  // Likewise for enabling or disabling it.
+  string16 GetBreakpointNumberForEnable(int id, bool enabled) {
+    std::map<int, string16>::iterator it = breakpoint_numbers_.find(id);
+    if (it == breakpoint_numbers_.end()) {
+      if (inserting_breakpoints_.count(id))
+        deferred_breakpoint_enables_[id] = enabled;
+      return string16();
+    }
+    return it->second;
+  }
+
+  // Sends everything retrieved since the last flush as one notification.
+  // If a thread exits before its -thread-info is answered, gdb reports an
+  // error instead, and the batch goes out with the next refresh.
+  void FlushThreads() {
+    if (!pending_threads_.complete &&
+        pending_threads_.threads.empty() &&
+        pending_threads_.exited.empty()) {
+      return;
+    }
+    RetrievedThreadsData data;
+    std::swap(data, pending_threads_);
+    pending_threads_.complete = false;
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnRetrievedThreads,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  // Remembers where gdb said frames in the executable are, and uses that
+  // for frames it reports without line information, which happens until
+  // it's finished loading symbols for a large binary. They're keyed by
+  // their offset in the image, so that they're found wherever it's loaded.
+  void SymbolizeFrame(FrameData* frame) {
+    if (!symbolization_cache_ ||
+        !image_base_known_ ||
+        frame->address < image_base_ ||
+        frame->address - image_base_ >= image_size_) {
+      return;
+    }
+    uint64 offset = frame->address - image_base_;
+    SymbolizationCache::Entry entry;
+    if (!frame->filename.empty()) {
+      entry.function = UTF16ToUTF8(frame->function);
+      entry.file = UTF16ToUTF8(frame->filename);
+      entry.line = frame->line_number;
+      symbolization_cache_->Add(build_id_, offset, entry);
+    } else if (symbolization_cache_->Lookup(build_id_, offset, &entry)) {
+      frame->function = UTF8ToUTF16(entry.function);
+      frame->filename = UTF8ToUTF16(entry.file);
+      frame->line_number = entry.line;
+    }
+  }
+
   // Handlers for various commands that return result records.
+  void HandlerStepLoopCondition(const GdbRecord* record) {
+    step_condition_token_.clear();
+    RunStepLoopAction(step_loop_->OnConditionValue(
+        FindStringValue("value", record->results())));
+  }
+
+  // Tells the user why a command failed, as "|what|: message".
+  void HandlerErrorToOutput(const string16& what, const GdbRecord* record) {
+    string16 message =
+        UTF8ToUTF16(FindStringValue("msg", record->results()));
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnConsoleOutput,
+                   base::Unretained(debug_notification_),
+                   what + L": " + message + L"\n"));
+  }
+
+  void HandlerImageBase(const GdbRecord* record) {
+    int64 image_base;
+    if (base::StringToInt64(FindStringValue("value", record->results()),
+                            &image_base)) {
+      image_base_ = static_cast<uint64>(image_base);
+      image_base_known_ = true;
+    }
+  }
+
+  void HandlerBreakpointInserted(int id, const GdbRecord* record) {
+    inserting_breakpoints_.erase(id);
+    const base::DictionaryValue* bkpt =
+        FindDictionaryValue("bkpt", record->results());
+    std::string number;
+    if (!bkpt || !bkpt->GetString("number", &number))
+      return;
+    string16 number16 = UTF8ToUTF16(number);
+    if (deferred_breakpoint_deletes_.erase(id)) {
+      deferred_breakpoint_enables_.erase(id);
+      SendString(L"-break-delete " + number16 + L"\r\n");
+      return;
+    }
+    breakpoint_numbers_[id] = number16;
+    std::map<int, bool>::iterator it = deferred_breakpoint_enables_.find(id);
+    if (it != deferred_breakpoint_enables_.end()) {
+      SendString((it->second ? L"-break-enable " : L"-break-disable ") +
+                 number16 + L"\r\n");
+      deferred_breakpoint_enables_.erase(it);
+    }
+  }
+
+  void HandlerBreakpointInsertFailed(int id, const GdbRecord* record) {
+    inserting_breakpoints_.erase(id);
+    // It's gone already if the UI's deleted it.
+    bool deleted = deferred_breakpoint_deletes_.erase(id) != 0;
+    deferred_breakpoint_enables_.erase(id);
+    if (deleted)
+      return;
+    BreakpointInsertFailedData data;
+    data.id = id;
+    data.message = UTF8ToUTF16(FindStringValue("msg", record->results()));
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnBreakpointInsertFailed,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  void HandlerSync(int sync_id, const GdbRecord* record) {
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnSynced,
+                   base::Unretained(debug_notification_), sync_id));
+  }
+
+  void HandlerThreadInfo(bool last, const GdbRecord* record) {
+    RetrievedThreadsData data =
+        RetrievedThreadsDataFromRecordResults(record->results());
+    for (size_t i = 0; i < data.threads.size(); ++i) {
+      if (data.threads[i].state == THREAD_STOPPED)
+        SymbolizeFrame(&data.threads[i].frame);
+      pending_threads_.threads.push_back(data.threads[i]);
+    }
+    if (last)
+      FlushThreads();
+  }
+
+  void HandlerCoreThreadInfo(const GdbRecord* record) {
+    CoreLoadedData data = CoreLoadedDataFromThreadInfoResults(
+        record->results());
+    if (data.thread_id == 0)
+      return;
+    // Nothing in a core runs, so they're all stopped for good.
+    RetrievedThreadsData threads =
+        RetrievedThreadsDataFromRecordResults(record->results());
+    for (size_t i = 0; i < threads.threads.size(); ++i)
+      thread_states_[threads.threads[i].id] = THREAD_STOPPED;
+    selected_thread_ = data.thread_id;
+    SymbolizeFrame(&data.frame);
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnCoreLoaded,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  void HandlerSnapshotStack(ThreadId thread_id, const GdbRecord* record) {
+    DCHECK(record->results().size() == 1 &&
+           record->results()[0]->variable() == "stack");
+    base::ListValue* list_value;
+    CHECK(record->results()[0]->value()->GetAsList(&list_value));
+    // The record is freed once handled, so take the frames rather than
+    // copying them.
+    base::ListValue* frames = new base::ListValue;
+    frames->Swap(list_value);
+    delete snapshot_stacks_[thread_id];
+    snapshot_stacks_[thread_id] = frames;
+  }
+
+  // Sent after all the stacks, so all of those that could be retrieved are
+  // in by now.
+  void HandlerSnapshotDone(const GdbRecord* record) {
+    scoped_refptr<BacktraceSnapshotBuilder> builder(
+        new BacktraceSnapshotBuilder);
+    for (size_t i = 0; i < snapshot_threads_.threads.size(); ++i) {
+      const ThreadData& thread = snapshot_threads_.threads[i];
+      base::ListValue* frames = NULL;
+      std::map<ThreadId, base::ListValue*>::iterator it =
+          snapshot_stacks_.find(thread.id);
+      if (it != snapshot_stacks_.end()) {
+        frames = it->second;
+        snapshot_stacks_.erase(it);
+      }
+      builder->AddThread(thread.id, thread.target_id, frames);
+    }
+    // Threads that exited in the meantime.
+    STLDeleteValues(&snapshot_stacks_);
+    snapshot_threads_.threads.clear();
+    builder->Start(base::SysInfo::NumberOfProcessors(),
+                   base::Bind(&PostBacktraceSnapshot, debug_notification_));
+  }
+
+  void HandlerProfileStack(const GdbRecord* record) {
+    if (!profiling())
+      return;
+    DCHECK(record->results().size() == 1 &&
+           record->results()[0]->variable() == "stack");
+    RetrievedStackData data =
+        RetrievedStackDataFromList(record->results()[0]->value());
+    std::vector<uint64> addresses;
+    for (size_t i = 0; i < data.frames.size(); ++i) {
+      const FrameData& frame = data.frames[i];
+      addresses.push_back(frame.address);
+      // gdb has already done the work, so only the first is kept rather
+      // than symbolizing again when the profile is built.
+      profile_functions_.insert(
+          std::make_pair(static_cast<uint64>(frame.address), frame.function));
+    }
+    profile_->AddStack(addresses);
+  }
+
   void HandlerStack(const GdbRecord* record) {
     DCHECK(record->results().size() == 1 &&
            record->results()[0]->variable() == "stack");
     RetrievedStackData data =
       RetrievedStackDataFromList(record->results()[0]->value());
+    for (size_t i = 0; i < data.frames.size(); ++i)
+      SymbolizeFrame(&data.frames[i]);
     stack_without_arguments_ = data;
     got_stack_frames_waiting_for_arguments_ = true;
     // Possibly want to post here if the stack-args is too slow.
@@ -190,12 +704,164 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
                    base::Unretained(debug_notification_), data));
   }
 
+  // Batches library events and makes sure a flush is scheduled. The first
+  // event in a quiet period starts the timer; the rest just pile up.
+  void QueueLibraryEvent(const LibraryEvent& event) {
+    pending_library_events_.events.push_back(event);
+    ScheduleLibraryFlush();
+  }
+
+  void ScheduleLibraryFlush() {
+    if (library_flush_scheduled_)
+      return;
+    library_flush_scheduled_ = true;
+    AppThread::PostDelayedTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&ReaderWriter::FlushLibraryEvents,
+                   weak_factory_.GetWeakPtr()),
+        base::TimeDelta::FromMilliseconds(kLibraryEventCoalesceMs));
+  }
+
+  // Sends all batched library events as a single notification. Also called
+  // before stop notifications so the UI sees the loads that preceded a stop
+  // before the stop itself.
+  void FlushLibraryEvents() {
+    library_flush_scheduled_ = false;
+    if (pending_library_events_.events.empty())
+      return;
+    LibrariesChangedData data;
+    std::swap(data, pending_library_events_);
+    if (debug_notification_) {
+      AppThread::PostTask(AppThread::UI, FROM_HERE,
+          base::Bind(&DebugNotification::OnLibrariesChanged,
+                     base::Unretained(debug_notification_), data));
+    }
+  }
+
+  // Batches tracepoint output like library events. Returns false if
+  // |output| isn't from tracepoints.
+  bool QueueTracepointOutput(const std::string& output) {
+    if (!TracepointHitsFromConsoleOutput(output,
+                                         &partial_tracepoint_line_,
+                                         &pending_tracepoint_output_.hits)) {
+      return false;
+    }
+    if (!tracepoint_flush_scheduled_) {
+      tracepoint_flush_scheduled_ = true;
+      AppThread::PostDelayedTask(AppThread::BACKEND, FROM_HERE,
+          base::Bind(&ReaderWriter::FlushTracepointOutput,
+                     weak_factory_.GetWeakPtr()),
+          base::TimeDelta::FromMilliseconds(kTracepointOutputCoalesceMs));
+    }
+    return true;
+  }
+
+  // Also called before stop notifications, so that output before a stop
+  // shows up before it.
+  void FlushTracepointOutput() {
+    tracepoint_flush_scheduled_ = false;
+    if (pending_tracepoint_output_.hits.empty())
+      return;
+    TracepointOutputData data;
+    std::swap(data, pending_tracepoint_output_);
+    if (debug_notification_) {
+      AppThread::PostTask(AppThread::UI, FROM_HERE,
+          base::Bind(&DebugNotification::OnTracepointOutput,
+                     base::Unretained(debug_notification_), data));
+    }
+  }
+
+  void RunStepLoopAction(StepLoop::Action action) {
+    switch (action) {
+      case StepLoop::STEP:
+        step_.Run();
+        break;
+      case StepLoop::EVALUATE_CONDITION:
+        evaluate_step_condition_.Run();
+        break;
+      case StepLoop::FINISH:
+        FinishStepLoop();
+        // The stop that ended it was held back until now.
+        SymbolizeFrame(&step_loop_stop_.frame);
+        AppThread::PostTask(AppThread::UI, FROM_HERE,
+            base::Bind(&DebugNotification::OnStoppedAfterStepping,
+                       base::Unretained(debug_notification_),
+                       step_loop_stop_));
+        break;
+    }
+  }
+
+  // Tells the UI how the step loop went, ahead of the stop that ended it.
+  void FinishStepLoop() {
+    StepLoopData data;
+    step_loop_->GetResult(
+        (base::TimeTicks::Now() - step_loop_start_).InMillisecondsF(), &data);
+    step_loop_.reset();
+    step_.Reset();
+    evaluate_step_condition_.Reset();
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnStepLoopFinished,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  bool AllThreadsStopped() const {
+    for (std::map<ThreadId, ThreadState>::const_iterator it =
+             thread_states_.begin();
+         it != thread_states_.end(); ++it) {
+      if (it->second != THREAD_STOPPED)
+        return false;
+    }
+    return true;
+  }
+
+  // Sends the profile, once the target has stopped for good.
+  void FinishProfiling() {
+    ProfileData data;
+    profile_->Build(base::Bind(&GetProfileFunction, &profile_functions_),
+                    &data);
+    data.duration_ms =
+        (base::TimeTicks::Now() - profile_start_).InMillisecondsF();
+    profile_.reset();
+    profile_functions_.clear();
+    sample_pending_ = false;
+    capturing_sample_ = false;
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&DebugNotification::OnProfileCollected,
+                   base::Unretained(debug_notification_), data));
+  }
+
+  // Marks the threads in a *running or *stopped record, which are all of
+  // them in all-stop mode, as being in |state|.
+  void SetThreadStates(const base::Value* thread_list,
+                       ThreadState state,
+                       std::vector<ThreadId>* changed) {
+    std::vector<ThreadId> thread_ids;
+    if (!thread_list || !ThreadIdsFromValue(thread_list, &thread_ids)) {
+      for (std::map<ThreadId, ThreadState>::const_iterator it =
+               thread_states_.begin();
+           it != thread_states_.end(); ++it) {
+        thread_ids.push_back(it->first);
+      }
+    }
+    for (size_t i = 0; i < thread_ids.size(); ++i) {
+      thread_states_[thread_ids[i]] = state;
+      // Running ones don't need fetching, the UI is told they're running
+      // directly.
+      if (state == THREAD_STOPPED)
+        threads_changed_.insert(thread_ids[i]);
+    }
+    if (changed)
+      changed->swap(thread_ids);
+  }
+
   void SendNotifications(GdbOutput* output) {
     // TODO(scottmg): It'd be nice to not have AppThread here.
     for (size_t i = 0; i < output->size(); ++i) {
       const GdbRecord* record = output->at(i);
       switch (record->record_type()) {
         case GdbRecord::RT_RESULT_RECORD:
+          // ^running, for one, succeeds without being done.
+          if (record->ResultClass() != "error")
+            error_handler_for_result_.erase(record->token());
           if (record->ResultClass() == "done") {
             if (handler_for_result_.find(record->token()) !=
                 handler_for_result_.end()) {
@@ -203,22 +869,110 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
               // TODO(scottmg): Remove!
               continue;
             }
+          } else if (record->ResultClass() == "error" &&
+                     error_handler_for_result_.find(record->token()) !=
+                         error_handler_for_result_.end()) {
+            RecordHandler handler = error_handler_for_result_[record->token()];
+            error_handler_for_result_.erase(record->token());
+            handler_for_result_.erase(record->token());
+            handler.Run(record);
+            continue;
+          } else if (record->ResultClass() == "error" &&
+                     stepping() &&
+                     record->token() == step_condition_token_) {
+            handler_for_result_.erase(record->token());
+            step_condition_token_.clear();
+            RunStepLoopAction(step_loop_->OnConditionError(
+                UTF8ToUTF16(FindStringValue("msg", record->results()))));
+            continue;
           }
           goto notimplemented;
         case GdbRecord::RT_EXEC_ASYNC_OUTPUT:
-          if (record->AsyncClass() == "stopped") {
-            std::string reason = FindStringValue("reason", record->results());
+          if (record->AsyncClass() == "running") {
+            ThreadsRunningData data;
+            SetThreadStates(FindValue("thread-id", record->results()),
+                            THREAD_RUNNING,
+                            &data.thread_ids);
+            if (capturing_sample_) {
+              // All the stacks have been answered before this.
+              capturing_sample_ = false;
+              profile_->AddPause(base::TimeTicks::Now() - sample_start_);
+              sample_done_.Run();
+            }
+            // The UI was told when profiling started, and doesn't need to
+            // hear it again for every sample.
+            if (profiling() && profile_->sample_count() > 0)
+              continue;
+            // Likewise for each step after the first in a step loop.
+            if (stepping() && step_loop_->steps() > 0)
+              continue;
+            AppThread::PostTask(AppThread::UI, FROM_HERE,
+                base::Bind(&DebugNotification::OnThreadsRunning,
+                           base::Unretained(debug_notification_), data));
+            continue;
+          } else if (record->AsyncClass() == "stopped") {
+            FlushLibraryEvents();
+            FlushTracepointOutput();
+            SetThreadStates(FindValue("stopped-threads", record->results()),
+                            THREAD_STOPPED,
+                            NULL);
+            ThreadId thread_id = ThreadIdFromRecordResults(record->results());
+            if (thread_id != 0)
+              selected_thread_ = thread_id;
+            // There's no reason when a thread is interrupted in non-stop
+            // mode.
+            std::string reason;
+            const base::Value* reason_value =
+                FindValue("reason", record->results());
+            if (reason_value)
+              reason_value->GetAsString(&reason);
+            bool has_frame = FindValue("frame", record->results()) != NULL;
+            if (profiling()) {
+              if (sample_pending_ && !stop_profiling_ &&
+                  (reason.empty() || reason == "signal-received")) {
+                // In non-stop mode each thread's stop is reported
+                // separately.
+                if (sample_breaking_in_)
+                  sample_break_thread_ = thread_id;
+                if (AllThreadsStopped()) {
+                  sample_pending_ = false;
+                  capturing_sample_ = true;
+                  capture_sample_.Run();
+                }
+                continue;
+              }
+              // Stopped by itself, or for good, so this is reported as
+              // usual.
+              FinishProfiling();
+            }
+            if (stepping()) {
+              StepLoop::Action action =
+                  step_loop_->OnStopped(reason == "end-stepping-range");
+              if (action != StepLoop::FINISH) {
+                // Kept in case the condition turns out to be true.
+                step_loop_stop_ = StoppedAfterSteppingDataFromRecordResults(
+                    record->results());
+                RunStepLoopAction(action);
+                continue;
+              }
+              // Reported as usual, below.
+              FinishStepLoop();
+            }
             if (reason == "breakpoint-hit") {
               StoppedAtBreakpointData data =
                   StoppedAtBreakpointDataFromRecordResults(record->results());
+              SymbolizeFrame(&data.frame);
               AppThread::PostTask(AppThread::UI, FROM_HERE,
                   base::Bind(&DebugNotification::OnStoppedAtBreakpoint,
                              base::Unretained(debug_notification_), data));
               continue;
             } else if (reason == "end-stepping-range" ||
-                       reason == "function-finished") {
+                       reason == "function-finished" ||
+                       ((reason.empty() || reason == "signal-received") &&
+                        has_frame)) {
               StoppedAfterSteppingData data =
                   StoppedAfterSteppingDataFromRecordResults(record->results());
+              SymbolizeFrame(&data.frame);
               AppThread::PostTask(AppThread::UI, FROM_HERE,
                   base::Bind(&DebugNotification::OnStoppedAfterStepping,
                             base::Unretained(debug_notification_), data));
@@ -226,26 +980,73 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
             } else if (reason == "exited-normally" ||
                        reason == "exited" ||
                        reason == "exited-signalled") {
-               MessageBox(0, L"todo", L"scottmg", 0);
+              AppThread::PostTask(AppThread::UI, FROM_HERE,
+                  base::Bind(&DebugNotification::OnProcessExited,
+                             base::Unretained(debug_notification_),
+                             ProcessExitedDataFromRecordResults(
+                                 record->results())));
+              continue;
             }
           }
           goto notimplemented;
         case GdbRecord::RT_NOTIFY_ASYNC_OUTPUT:
-          if (record->AsyncClass() == "library-loaded") {
-             LibraryLoadedData data =
-                 LibraryLoadedDataFromRecordResults(record->results());
-             AppThread::PostTask(AppThread::UI, FROM_HERE,
-                 base::Bind(&DebugNotification::OnLibraryLoaded,
-                           base::Unretained(debug_notification_), data));
+          if (record->AsyncClass() == "thread-created") {
+            int thread_id;
+            if (base::StringToInt(FindStringValue("id", record->results()),
+                                  &thread_id)) {
+              thread_states_[thread_id] = THREAD_RUNNING;
+              threads_changed_.insert(thread_id);
+            }
+            continue;
+          } else if (record->AsyncClass() == "thread-exited") {
+            int thread_id;
+            if (base::StringToInt(FindStringValue("id", record->results()),
+                                  &thread_id)) {
+              thread_states_.erase(thread_id);
+              threads_changed_.erase(thread_id);
+              threads_exited_.push_back(thread_id);
+              if (selected_thread_ == thread_id)
+                selected_thread_ = 0;
+            }
+            continue;
+          } else if (record->AsyncClass() == "thread-group-started") {
+            int pid;
+            if (base::StringToInt(FindStringValue("pid", record->results()),
+                                  &pid)) {
+              target_pid_ = pid;
+            }
+            continue;
+          } else if (record->AsyncClass() == "thread-group-exited") {
+            target_pid_ = 0;
+            continue;
+          } else if (record->AsyncClass() == "breakpoint-modified") {
+            // Sent with the new hit count every time a tracepoint fires,
+            // and there's nothing to show it in.
+            continue;
+          } else if (record->AsyncClass() == "library-loaded") {
+             QueueLibraryEvent(LibraryEventFromRecordResults(
+                 LibraryEvent::LOADED, record->results()));
+             continue;
+          } else if (record->AsyncClass() == "library-unloaded") {
+             QueueLibraryEvent(LibraryEventFromRecordResults(
+                 LibraryEvent::UNLOADED, record->results()));
              continue;
           }
           goto notimplemented;
-        case GdbRecord::RT_CONSOLE_STREAM_OUTPUT:
+        case GdbRecord::RT_CONSOLE_STREAM_OUTPUT: {
+          if (QueueTracepointOutput(record->OutputString()))
+            continue;
+          // Including what looked like the start of a tracepoint's line,
+          // but wasn't.
+          std::string output = partial_tracepoint_line_ +
+                               record->OutputString();
+          partial_tracepoint_line_.clear();
           AppThread::PostTask(AppThread::UI, FROM_HERE,
               base::Bind(&DebugNotification::OnConsoleOutput,
                          base::Unretained(debug_notification_),
-                         UTF8ToUTF16(record->OutputString())));
+                         UTF8ToUTF16(output)));
           break;
+        }
         case GdbRecord::RT_LOG_STREAM_OUTPUT:
           AppThread::PostTask(AppThread::UI, FROM_HERE,
               base::Bind(&DebugNotification::OnInternalDebugOutput,
@@ -270,12 +1071,20 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
       CHECK(ERROR_IO_PENDING == GetLastError());
   }
 
+  // |handler| may be null, for commands that are only sent with a token
+  // so that they can have an error handler.
   void SendStringWithHandler(
       const string16& string, int64 token, RecordHandler handler) {
-    handler_for_result_[base::Int64ToString(token)] = handler;
+    if (!handler.is_null())
+      handler_for_result_[base::Int64ToString(token)] = handler;
     SendString(string);
   }
 
+  // Runs |handler| with the ^error if the command sent with |token| fails.
+  void SetErrorHandler(int64 token, RecordHandler handler) {
+    error_handler_for_result_[base::Int64ToString(token)] = handler;
+  }
+
   void SendString(const string16& string) {
     if (write_state_.is_pending) {
       pending_writes_.push_back(string);
@@ -334,14 +1143,93 @@ class ReaderWriter : public MessageLoopForIO::IOHandler {
   // of the command that caused them, and we may have more than one
   // submitted.
   std::map<std::string, RecordHandler> handler_for_result_;
+  // Likewise for ^error, for the commands that have one.
+  std::map<std::string, RecordHandler> error_handler_for_result_;
 
   RetrievedStackData stack_without_arguments_;
   bool got_stack_frames_waiting_for_arguments_;
 
   DebugNotification* debug_notification_;
+
+  // Library events received since the last flush to the UI.
+  LibrariesChangedData pending_library_events_;
+  bool library_flush_scheduled_;
+
+  // Tracepoint output received since the last flush to the UI.
+  TracepointOutputData pending_tracepoint_output_;
+  bool tracepoint_flush_scheduled_;
+  // The start of a line of tracepoint output, whose end is still to come.
+  std::string partial_tracepoint_line_;
+
+  // Only frames in the executable are cached. If it can be relocated,
+  // they aren't until gdb has said where it was loaded.
+  std::unique_ptr<SymbolizationCache> symbolization_cache_;
+  std::string build_id_;
+  uint64 image_base_;
+  uint64 image_size_;
+  bool image_relocatable_;
+  bool image_base_known_;
+
+  // Updated from =thread-created/exited, *running and *stopped.
+  std::map<ThreadId, ThreadState> thread_states_;
+  ThreadId selected_thread_;
+  // From =thread-group-started/exited.
+  DWORD target_pid_;
+
+  // Threads created or stopped, and those that have exited, since they were
+  // last retrieved.
+  std::set<ThreadId> threads_changed_;
+  std::vector<ThreadId> threads_exited_;
+  bool have_threads_;
+
+  // Retrieved, but waiting on the rest of the refresh.
+  RetrievedThreadsData pending_threads_;
+
+  // gdb's numbers for the UI's breakpoints, by the UI's ids.
+  std::map<int, string16> breakpoint_numbers_;
+  // Those whose -break-insert hasn't been answered yet, and what to do
+  // with them once it is.
+  std::set<int> inserting_breakpoints_;
+  std::set<int> deferred_breakpoint_deletes_;
+  std::map<int, bool> deferred_breakpoint_enables_;
+
+  // The threads for a snapshot that's being captured, and their stacks,
+  // owned.
+  RetrievedThreadsData snapshot_threads_;
+  std::map<ThreadId, base::ListValue*> snapshot_stacks_;
+
+  // Set while profiling.
+  std::unique_ptr<SampleProfileBuilder> profile_;
+  // What gdb said each address in the samples is in.
+  std::map<uint64, string16> profile_functions_;
+  base::TimeTicks profile_start_;
+  base::Closure capture_sample_;
+  base::Closure sample_done_;
+  // Interrupted for a sample, but not all stopped yet.
+  bool sample_pending_;
+  // Whether the sample was by breaking into the target, and if so the
+  // thread that was started to do that, once it's stopped.
+  bool sample_breaking_in_;
+  ThreadId sample_break_thread_;
+  // Stacks requested, but not running again yet.
+  bool capturing_sample_;
+  base::TimeTicks sample_start_;
+  bool stop_profiling_;
+
+  // Set while stepping repeatedly.
+  std::unique_ptr<StepLoop> step_loop_;
+  base::TimeTicks step_loop_start_;
+  base::Closure step_;
+  base::Closure evaluate_step_condition_;
+  // The condition's -data-evaluate-expression, whose errors end the loop.
+  std::string step_condition_token_;
+  // The last stop, not reported yet.
+  StoppedAfterSteppingData step_loop_stop_;
+
+  base::WeakPtrFactory<ReaderWriter> weak_factory_;
 };
 
-DebugCoreGdb::DebugCoreGdb() : token_(0) {
+DebugCoreGdb::DebugCoreGdb() : token_(0), non_stop_(false), core_(false) {
   CHECK(gdb_.Start(L"gdb_win_binaries/gdb-python27.exe",
                    (L"--data-directory=gdb_win_binaries\\gdb "
                       L"-ix gdb_win_binaries\\sginit "
@@ -350,6 +1238,9 @@ DebugCoreGdb::DebugCoreGdb() : token_(0) {
   reader_writer_.reset(new ReaderWriter(
         gdb_.GetInputPipe(), gdb_.GetOutputPipe()));
   SendCommand(L"-enable-pretty-printing");
+  // Console commands, such as dprintf, ask whether to make a breakpoint
+  // pending if its location isn't known yet, which can't be answered.
+  SendCommand(L"-gdb-set", L"breakpoint", L"pending", L"on");
 }
 
 DebugCoreGdb::~DebugCoreGdb() {
@@ -437,6 +1328,29 @@ void DebugCoreGdb::SendCommand(
   reader_writer_->SendStringWithHandler(command, token, handler);
 }
 
+void DebugCoreGdb::SendCommand(
+    int64 token,
+    RecordHandler handler,
+    const string16& arg0,
+    const string16& arg1,
+    const string16& arg2,
+    const string16& arg3,
+    const string16& arg4) {
+  string16 command = base::Int64ToString16(token) +
+                     Quote(arg0) + L" " +
+                     Quote(arg1) + L" " +
+                     Quote(arg2) + L" " +
+                     Quote(arg3) + L" " +
+                     Quote(arg4) + L"\r\n";
+  reader_writer_->SendStringWithHandler(command, token, handler);
+}
+
+void DebugCoreGdb::SendSyncCommand(const RecordHandler& handler) {
+  // gdb answers in order, so any cheap command that has nothing to say
+  // will do.
+  SendCommand(NewToken(), handler, L"-gdb-show", L"confirm");
+}
+
 string16 DebugCoreGdb::Quote(const string16& arg) {
   if (arg.find_first_of(L" \"") != string16::npos) {
     string16 result = arg;
@@ -453,31 +1367,304 @@ void DebugCoreGdb::LoadProcess(
     const string16& working_directory) {
   DCHECK_EQ(0, environment.size()) << "todo;";
   DCHECK_EQ(0, working_directory.size()) << "todo;";
+  reader_writer_->SetExecutable(application);
   SendCommand(L"-file-exec-and-symbols", application);
 }
 
+void DebugCoreGdb::LoadCore(const string16& application,
+                            const string16& core_path) {
+  reader_writer_->SetExecutable(application);
+  SendCommand(L"-file-exec-and-symbols", application);
+  core_ = true;
+  // gdb only reads the parts of the core it needs, so this returns quickly
+  // even for a large one.
+  SendCommand(L"-target-select", L"core", core_path);
+  SendCommand(NewToken(),
+              base::Bind(&ReaderWriter::HandlerCoreThreadInfo,
+                         base::Unretained(reader_writer_.get())),
+              L"-thread-info");
+}
+
+void DebugCoreGdb::EnableNonStop() {
+  // Non-stop needs gdb to accept commands while the target runs.
+  SendCommand(L"-gdb-set", L"target-async", L"on");
+  SendCommand(L"-gdb-set", L"pagination", L"off");
+  int64 token = NewToken();
+  reader_writer_->SetErrorHandler(
+      token, base::Bind(&DebugCoreGdb::NonStopRejected, AsWeakPtr()));
+  SendCommand(token, RecordHandler(), L"-gdb-set", L"non-stop", L"on");
+  non_stop_ = true;
+}
+
+void DebugCoreGdb::SelectThread(ThreadId thread_id) {
+  reader_writer_->set_selected_thread(thread_id);
+}
+
+void DebugCoreGdb::ContinueThread(ThreadId thread_id) {
+  if (reader_writer_->GetThreadState(thread_id) == THREAD_RUNNING)
+    return;
+  // In all-stop mode, continuing any thread continues all of them.
+  if (non_stop_) {
+    SendCommand(L"-exec-continue",
+                L"--thread",
+                base::IntToString16(thread_id));
+  } else {
+    SendCommand(L"-exec-continue");
+  }
+}
+
+void DebugCoreGdb::InterruptThread(ThreadId thread_id) {
+  if (reader_writer_->GetThreadState(thread_id) == THREAD_STOPPED)
+    return;
+  if (non_stop_) {
+    SendCommand(L"-exec-interrupt",
+                L"--thread",
+                base::IntToString16(thread_id));
+  } else {
+    BreakIntoTarget();
+  }
+}
+
+void DebugCoreGdb::InterruptAll() {
+  if (non_stop_)
+    SendCommand(L"-exec-interrupt", L"--all");
+  else
+    BreakIntoTarget();
+}
+
 void DebugCoreGdb::RunToMain() {
   SendCommand(L"-break-insert", L"-t", L"main");
-  SendCommand(L"-exec-run");
+  Run();
 }
 
 void DebugCoreGdb::Continue() {
-  SendCommand(L"-exec-run");
+  if (!reader_writer_->target_started())
+    Run();
+  else if (non_stop_)
+    SendCommand(L"-exec-continue", L"--all");
+  else
+    SendCommand(L"-exec-continue");
 }
 
 void DebugCoreGdb::StepOver() {
+  SelectCurrentThread();
   SendCommand(L"-exec-next");
 }
 
 void DebugCoreGdb::StepIn() {
+  SelectCurrentThread();
   SendCommand(L"-exec-step");
 }
 
 void DebugCoreGdb::StepOut() {
+  SelectCurrentThread();
   SendCommand(L"-exec-finish");
 }
 
+void DebugCoreGdb::StepRepeatedly(bool step_in,
+                                  int max_steps,
+                                  const string16& condition) {
+  if (reader_writer_->stepping() || reader_writer_->profiling()) {
+    reader_writer_->RefuseStepLoop();
+    return;
+  }
+  base::Closure evaluate_condition;
+  if (!condition.empty()) {
+    evaluate_condition = base::Bind(
+        &DebugCoreGdb::EvaluateStepLoopCondition, AsWeakPtr(), condition);
+  }
+  reader_writer_->StartStepLoop(
+      std::max(max_steps, 1),
+      base::Bind(&DebugCoreGdb::StepLoopStep, AsWeakPtr(), step_in),
+      evaluate_condition);
+  StepLoopStep(step_in);
+}
+
+void DebugCoreGdb::CancelStepLoop() {
+  reader_writer_->CancelStepLoop();
+}
+
+void DebugCoreGdb::StepLoopStep(bool step_in) {
+  SelectCurrentThread();
+  SendCommand(step_in ? L"-exec-step" : L"-exec-next");
+}
+
+void DebugCoreGdb::EvaluateStepLoopCondition(const string16& condition) {
+  int64 token = NewToken();
+  reader_writer_->set_step_condition_token(token);
+  // So that it's always printed as 0 or 1, or false or true in C++,
+  // whatever type the expression has.
+  SendCommand(token,
+              base::Bind(&ReaderWriter::HandlerStepLoopCondition,
+                         base::Unretained(reader_writer_.get())),
+              L"-data-evaluate-expression",
+              L"!!(" + condition + L")");
+}
+
+void DebugCoreGdb::GetThreads() {
+  std::vector<ThreadId> thread_ids;
+  if (reader_writer_->StartThreadRefresh(&thread_ids)) {
+    SendCommand(NewToken(),
+                base::Bind(&ReaderWriter::HandlerThreadInfo,
+                           base::Unretained(reader_writer_.get()),
+                           true),
+                L"-thread-info");
+    return;
+  }
+  if (thread_ids.empty()) {
+    reader_writer_->FlushThreads();
+    return;
+  }
+  for (size_t i = 0; i < thread_ids.size(); ++i) {
+    SendCommand(NewToken(),
+                base::Bind(&ReaderWriter::HandlerThreadInfo,
+                           base::Unretained(reader_writer_.get()),
+                           i == thread_ids.size() - 1),
+                L"-thread-info",
+                base::IntToString16(thread_ids[i]));
+  }
+}
+
+void DebugCoreGdb::CaptureBacktraceSnapshot() {
+  // The threads the UI's been told about may not be all of them yet, so ask
+  // gdb.
+  SendCommand(NewToken(),
+              base::Bind(&DebugCoreGdb::RequestSnapshotStacks, AsWeakPtr()),
+              L"-thread-info");
+}
+
+void DebugCoreGdb::RequestSnapshotStacks(const GdbRecord* record) {
+  RetrievedThreadsData threads =
+      RetrievedThreadsDataFromRecordResults(record->results());
+  reader_writer_->StartBacktraceSnapshot(threads);
+  // Sent all at once rather than each waiting on the last reply. gdb
+  // answers in order, so the sync comes after all the stacks, including
+  // for any that fail because the thread's running or gone.
+  for (size_t i = 0; i < threads.threads.size(); ++i) {
+    ThreadId thread_id = threads.threads[i].id;
+    SendCommand(NewToken(),
+                base::Bind(&ReaderWriter::HandlerSnapshotStack,
+                           base::Unretained(reader_writer_.get()),
+                           thread_id),
+                L"-stack-list-frames",
+                L"--thread",
+                base::IntToString16(thread_id),
+                L"0",
+                base::IntToString16(kMaxSnapshotFrames - 1));
+  }
+  SendSyncCommand(base::Bind(&ReaderWriter::HandlerSnapshotDone,
+                             base::Unretained(reader_writer_.get())));
+}
+
+void DebugCoreGdb::StartProfiling(int samples_per_second) {
+  if (reader_writer_->profiling())
+    return;
+  profile_interval_ = base::TimeDelta::FromMicroseconds(
+      1000000 / std::max(samples_per_second, 1));
+  reader_writer_->StartProfiling(
+      base::Bind(&DebugCoreGdb::CaptureProfileSample, AsWeakPtr()),
+      base::Bind(&DebugCoreGdb::ScheduleProfileSample, AsWeakPtr()));
+  if (non_stop_)
+    SendCommand(L"-exec-continue", L"--all");
+  else
+    SendCommand(L"-exec-continue");
+  ScheduleProfileSample();
+}
+
+void DebugCoreGdb::StopProfiling() {
+  reader_writer_->StopProfiling();
+}
+
+void DebugCoreGdb::InsertTracepoint(int tracepoint_id,
+                                    const string16& location,
+                                    const string16& format,
+                                    const string16& arguments) {
+  // Each hit is printed as one line, so that output can be split back up
+  // into hits however gdb batches it.
+  string16 tagged_format = ASCIIToUTF16(kTracepointOutputPrefix) +
+                           base::IntToString16(tracepoint_id) + L": " +
+                           format;
+  if (!EndsWith(tagged_format, L"\\n", true))
+    tagged_format += L"\\n";
+  // gdb 7.5 doesn't have -dprintf-insert, so it's the console command.
+  // |format| is already escaped, so it's quoted as is.
+  string16 dprintf =
+      L"dprintf " + location + L",\"" + tagged_format + L"\"";
+  if (!arguments.empty())
+    dprintf += L"," + arguments;
+  // Which is passed to -interpreter-exec as a C string.
+  ReplaceSubstringsAfterOffset(&dprintf, 0, L"\\", L"\\\\");
+  ReplaceSubstringsAfterOffset(&dprintf, 0, L"\"", L"\\\"");
+  int64 token = NewToken();
+  reader_writer_->SetErrorHandler(
+      token,
+      base::Bind(&ReaderWriter::HandlerErrorToOutput,
+                 base::Unretained(reader_writer_.get()),
+                 L"Couldn't insert tracepoint " +
+                     base::IntToString16(tracepoint_id)));
+  reader_writer_->SendStringWithHandler(
+      base::Int64ToString16(token) + L"-interpreter-exec console \"" +
+          dprintf + L"\"\r\n",
+      token,
+      RecordHandler());
+}
+
+void DebugCoreGdb::SyncBreakpoints(const BreakpointChangesData& changes) {
+  // All of it is sent at once. The deletes, enables, and disables are one
+  // command each, and the writes are coalesced, so even hundreds of
+  // inserts only take a few writes.
+  for (size_t i = 0; i < changes.inserted.size(); ++i) {
+    const BreakpointData& breakpoint = changes.inserted[i];
+    reader_writer_->StartBreakpointInsert(breakpoint.id);
+    string16 location = breakpoint.filename + L":" +
+                        base::IntToString16(breakpoint.line_number);
+    RecordHandler handler = base::Bind(
+        &ReaderWriter::HandlerBreakpointInserted,
+        base::Unretained(reader_writer_.get()),
+        breakpoint.id);
+    int64 token = NewToken();
+    reader_writer_->SetErrorHandler(
+        token,
+        base::Bind(&ReaderWriter::HandlerBreakpointInsertFailed,
+                   base::Unretained(reader_writer_.get()),
+                   breakpoint.id));
+    // -f makes it pending if it's in a library that isn't loaded yet.
+    if (breakpoint.enabled)
+      SendCommand(token, handler, L"-break-insert", L"-f", location);
+    else
+      SendCommand(token, handler, L"-break-insert", L"-f", L"-d", location);
+  }
+  string16 deletes;
+  for (size_t i = 0; i < changes.deleted.size(); ++i) {
+    string16 number =
+        reader_writer_->TakeBreakpointNumberForDelete(changes.deleted[i]);
+    if (!number.empty())
+      deletes += L" " + number;
+  }
+  if (!deletes.empty())
+    reader_writer_->SendString(L"-break-delete" + deletes + L"\r\n");
+  string16 enables;
+  for (size_t i = 0; i < changes.enabled.size(); ++i) {
+    string16 number = reader_writer_->GetBreakpointNumberForEnable(
+        changes.enabled[i], true);
+    if (!number.empty())
+      enables += L" " + number;
+  }
+  if (!enables.empty())
+    reader_writer_->SendString(L"-break-enable" + enables + L"\r\n");
+  string16 disables;
+  for (size_t i = 0; i < changes.disabled.size(); ++i) {
+    string16 number = reader_writer_->GetBreakpointNumberForEnable(
+        changes.disabled[i], false);
+    if (!number.empty())
+      disables += L" " + number;
+  }
+  if (!disables.empty())
+    reader_writer_->SendString(L"-break-disable" + disables + L"\r\n");
+}
+
 void DebugCoreGdb::GetStack() {
+  SelectCurrentThread();
   SendCommand(NewToken(),
               base::Bind(&ReaderWriter::HandlerStack,
                          base::Unretained(reader_writer_.get())),
@@ -489,7 +1676,14 @@ void DebugCoreGdb::GetStack() {
               L"--simple-values");
 }
 
+void DebugCoreGdb::Sync(int sync_id) {
+  SendSyncCommand(base::Bind(&ReaderWriter::HandlerSync,
+                             base::Unretained(reader_writer_.get()),
+                             sync_id));
+}
+
 void DebugCoreGdb::GetLocals() {
+  SelectCurrentThread();
   // We don't request values here because we need to create variables for them
   // get more information anyway.
   SendCommand(NewToken(),
@@ -500,6 +1694,7 @@ void DebugCoreGdb::GetLocals() {
 }
 
 void DebugCoreGdb::UpdateWatches() {
+  SelectCurrentThread();
   SendCommand(NewToken(),
               base::Bind(&ReaderWriter::HandlerVariableUpdates,
                          base::Unretained(reader_writer_.get())),
@@ -529,6 +1724,7 @@ void DebugCoreGdb::SetWatchExpanded(const std::string& id, bool expanded) {
 
 void DebugCoreGdb::CreateWatch(const std::string& id, const string16& name) {
   // Note, currently always "floating", should support fixed + ui for it.
+  SelectCurrentThread();
   SendCommand(NewToken(),
               base::Bind(&ReaderWriter::HandlerCreateVariable,
                          base::Unretained(reader_writer_.get())),
@@ -544,6 +1740,12 @@ void DebugCoreGdb::DeleteWatch(const std::string& id) {
 }
 
 void DebugCoreGdb::StopDebugging() {
+  // There's no process to abort for a core, and detaching drops it.
+  if (core_) {
+    SendCommand(L"-target-detach");
+    core_ = false;
+    return;
+  }
   SendCommand(L"-exec-abort");
 }
 
@@ -556,6 +1758,101 @@ base::WeakPtr<DebugCoreGdb> DebugCoreGdb::Create() {
   return result->AsWeakPtr();
 }
 
+void DebugCoreGdb::SelectCurrentThread() {
+  // In all-stop mode gdb already switches to the thread that stopped, but
+  // in non-stop mode it keeps whichever was selected last.
+  if (!non_stop_ || reader_writer_->selected_thread() == 0)
+    return;
+  SendCommand(L"-thread-select",
+              base::IntToString16(reader_writer_->selected_thread()));
+}
+
+void DebugCoreGdb::ScheduleProfileSample() {
+  AppThread::PostDelayedTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::InterruptForProfileSample, AsWeakPtr()),
+      profile_interval_);
+}
+
+void DebugCoreGdb::InterruptForProfileSample() {
+  if (reader_writer_->StartProfileSample(!non_stop_))
+    InterruptAll();
+}
+
+bool DebugCoreGdb::BreakIntoTarget() {
+  // gdb only reads commands while the target runs in async mode, which it
+  // doesn't support for Windows targets, so -exec-interrupt would wait for
+  // the target to stop by itself. Instead, a thread is started in the
+  // target that hits a breakpoint, which gdb reports as a SIGTRAP.
+  DWORD pid = reader_writer_->target_pid();
+  if (pid == 0)
+    return false;
+  HANDLE process = OpenProcess(PROCESS_ALL_ACCESS, FALSE, pid);
+  if (!process)
+    return false;
+  BOOL result = DebugBreakProcess(process);
+  CloseHandle(process);
+  return !!result;
+}
+
+void DebugCoreGdb::CaptureProfileSample() {
+  std::vector<ThreadId> thread_ids;
+  reader_writer_->GetThreadIdsToSample(&thread_ids);
+  // As for snapshots, these are all sent at once, and the target's
+  // continued straight after, as gdb handles them in order.
+  for (size_t i = 0; i < thread_ids.size(); ++i) {
+    SendCommand(NewToken(),
+                base::Bind(&ReaderWriter::HandlerProfileStack,
+                           base::Unretained(reader_writer_.get())),
+                L"-stack-list-frames",
+                L"--thread",
+                base::IntToString16(thread_ids[i]),
+                L"0",
+                base::IntToString16(kMaxProfileFrames - 1));
+  }
+  if (non_stop_)
+    SendCommand(L"-exec-continue", L"--all");
+  else
+    SendCommand(L"-exec-continue");
+}
+
+void DebugCoreGdb::Run() {
+  int64 token = NewToken();
+  reader_writer_->SetErrorHandler(
+      token, base::Bind(&DebugCoreGdb::RunFailed, AsWeakPtr()));
+  SendCommand(token, RecordHandler(), L"-exec-run");
+  if (!reader_writer_->StartRun())
+    return;
+  // gdb has relocated the executable's symbols by the time this is
+  // answered. The linker defines __ImageBase at the start of the image.
+  SendCommand(NewToken(),
+              base::Bind(&ReaderWriter::HandlerImageBase,
+                         base::Unretained(reader_writer_.get())),
+              L"-data-evaluate-expression",
+              L"(unsigned long long)&__ImageBase");
+}
+
+void DebugCoreGdb::RunFailed(const GdbRecord* record) {
+  if (!non_stop_) {
+    reader_writer_->HandlerErrorToOutput(L"Couldn't run", record);
+    return;
+  }
+  // gdb 7.5 only refuses non-stop mode for Windows targets once it's asked
+  // to run one.
+  NonStopRejected(record);
+  Run();
+}
+
+void DebugCoreGdb::NonStopRejected(const GdbRecord* record) {
+  if (!non_stop_)
+    return;
+  reader_writer_->HandlerErrorToOutput(
+      L"Non-stop mode isn't available, so all threads stop together",
+      record);
+  SendCommand(L"-gdb-set", L"non-stop", L"off");
+  SendCommand(L"-gdb-set", L"target-async", L"off");
+  non_stop_ = false;
+}
+
 int64 DebugCoreGdb::NewToken() {
   return token_++;
 }
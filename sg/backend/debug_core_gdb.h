@@ -12,6 +12,7 @@
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop.h"
 #include "base/threading/non_thread_safe.h"
+#include "base/time.h"
 #include "sg/backend/backend.h"
 #include "sg/backend/subprocess.h"
 
@@ -44,15 +45,94 @@ class DebugCoreGdb : public base::NonThreadSafe,
       const std::vector<string16> environment,
       const string16& working_directory);
 
+  // Instead of LoadProcess(), opens a core dump of |application| to look
+  // at its threads, stacks, and locals. OnCoreLoaded() follows, with the
+  // thread that received the signal. Nothing can be run.
+  virtual void LoadCore(const string16& application,
+                        const string16& core_path);
+
+  // Must be called before LoadProcess(). In non-stop mode, a thread that
+  // stops doesn't stop the others, which is much less disruptive for
+  // targets with many threads. Stepping, the stack, locals, and watches
+  // apply to the selected thread. gdb only supports it for some targets,
+  // and not for Windows ones as of 7.5. If it refuses, whether now or when
+  // the target's run, that's reported as console output and all-stop mode
+  // is used instead.
+  virtual void EnableNonStop();
+
+  // The thread that last stopped is selected automatically.
+  virtual void SelectThread(ThreadId thread_id);
+
+  // In all-stop mode, these apply to all threads. Interrupting breaks into
+  // the target, so it stops with a SIGTRAP in a thread of its own.
+  virtual void ContinueThread(ThreadId thread_id);
+  virtual void InterruptThread(ThreadId thread_id);
+  virtual void InterruptAll();
+
   virtual void RunToMain();
+  // Starts the target if it isn't running yet. Continues all threads, in
+  // non-stop mode too.
   virtual void Continue();
   virtual void StepOver();
   virtual void StepIn();
   virtual void StepOut();
 
+  // Steps over, or in, up to |max_steps| times, or until |condition| is
+  // true if it isn't empty, without a trip through the UI for each step.
+  // The condition is evaluated after every step. Once done, the UI gets
+  // OnStepLoopFinished() and then the last stop, as for a single step. A
+  // breakpoint or signal ends it early. If it can't start, the UI gets only
+  // OnStepLoopFinished(), with STEP_LOOP_REFUSED.
+  virtual void StepRepeatedly(bool step_in,
+                              int max_steps,
+                              const string16& condition);
+  // Stops once the current step is done.
+  virtual void CancelStepLoop();
+
+  // Kills the target, or closes the core.
   virtual void StopDebugging();
 
+  // Inserts, deletes, enables, and disables breakpoints, by the UI's ids.
+  // gdb keeps them from one run to the next, so only the changes since the
+  // last call are needed.
+  virtual void SyncBreakpoints(const BreakpointChangesData& changes);
+
+  // Only fetches the threads that have changed since the last call, so this
+  // is cheap to do on every stop.
+  virtual void GetThreads();
   virtual void GetStack();
+
+  // Once the replies to everything asked for before this have been posted,
+  // the UI gets OnSynced() with |sync_id|.
+  virtual void Sync(int sync_id);
+
+  // Captures every thread's stack at once, and notifies with them grouped
+  // by stack.
+  virtual void CaptureBacktraceSnapshot();
+
+  // Samples every thread's stack |samples_per_second| times a second, by
+  // interrupting the target and continuing it again once the stacks are
+  // requested, until StopProfiling() or the target stops by itself. Then
+  // notifies with the profile, and the stop as usual. Each sample is a
+  // round trip through gdb, so the target's stopped for milliseconds at a
+  // time, which is reported with the profile. As for InterruptAll(), in
+  // all-stop mode the target's broken into, and the thread that does that
+  // isn't sampled.
+  virtual void StartProfiling(int samples_per_second);
+  virtual void StopProfiling();
+
+  // Inserts a tracepoint, which prints |format| with |arguments|, a comma
+  // separated list of expressions as for printf, and carries on. It's a
+  // gdb dprintf, so the target is resumed inside gdb and the UI only gets
+  // the output, batched. |format| is escaped as it would be in a C string.
+  // |location| is anything gdb's break command takes, and may be in a
+  // library that isn't loaded yet. |tracepoint_id| tags the output, and
+  // identifies it if gdb can't insert it, which is reported as console
+  // output.
+  virtual void InsertTracepoint(int tracepoint_id,
+                                const string16& location,
+                                const string16& format,
+                                const string16& arguments);
   virtual void GetLocals();
   virtual void UpdateWatches();
   virtual void SetWatchExpanded(const std::string& id, bool expanded);
@@ -84,7 +164,32 @@ class DebugCoreGdb : public base::NonThreadSafe,
   void SendCommand(int64 token, RecordHandler handler, const string16& arg0,
                    const string16& arg1, const string16& arg2,
                    const string16& arg3);
+  void SendCommand(int64 token, RecordHandler handler, const string16& arg0,
+                   const string16& arg1, const string16& arg2,
+                   const string16& arg3, const string16& arg4);
   string16 Quote(const string16& arg);
+  // Runs |handler| once gdb has answered everything sent before it.
+  void SendSyncCommand(const RecordHandler& handler);
+
+  // Makes the selected thread gdb's current one in non-stop mode.
+  void SelectCurrentThread();
+
+  // Starts the target.
+  void Run();
+  void RunFailed(const GdbRecord* record);
+  // Goes back to all-stop mode.
+  void NonStopRejected(const GdbRecord* record);
+
+  void RequestSnapshotStacks(const GdbRecord* record);
+
+  void StepLoopStep(bool step_in);
+  void EvaluateStepLoopCondition(const string16& condition);
+
+  void ScheduleProfileSample();
+  void InterruptForProfileSample();
+  // Stops the target in all-stop mode. Returns false if it's not running.
+  bool BreakIntoTarget();
+  void CaptureProfileSample();
 
   int64 NewToken();
 
@@ -92,6 +197,10 @@ class DebugCoreGdb : public base::NonThreadSafe,
   Subprocess gdb_;
   std::unique_ptr<ReaderWriter> reader_writer_;
   int64 token_;
+  bool non_stop_;
+  // Since LoadCore().
+  bool core_;
+  base::TimeDelta profile_interval_;
 
   DISALLOW_COPY_AND_ASSIGN(DebugCoreGdb);
 };
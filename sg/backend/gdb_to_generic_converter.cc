@@ -4,9 +4,13 @@
 
 #include "sg/backend/gdb_to_generic_converter.h"
 
+#include <stdlib.h>
+
 #include "base/string_number_conversions.h"
 #include "base/utf_string_conversions.h"
 
+const char kTracepointOutputPrefix[] = "sg-tp ";
+
 std::string FindStringValue(
     const std::string& key,
     const std::vector<GdbRecordResult*>& results) {
@@ -49,6 +53,55 @@ const base::ListValue* FindListValue(
   return NULL;
 }
 
+const base::Value* FindValue(
+    const std::string& key,
+    const std::vector<GdbRecordResult*>& results) {
+  for (size_t i = 0; i < results.size(); ++i) {
+    if (results[i]->variable() == key)
+      return results[i]->value();
+  }
+  return NULL;
+}
+
+bool ThreadIdsFromValue(const base::Value* value,
+                        std::vector<ThreadId>* thread_ids) {
+  thread_ids->clear();
+  std::string single;
+  if (value->GetAsString(&single)) {
+    if (single == "all")
+      return false;
+    int thread_id;
+    if (base::StringToInt(single, &thread_id))
+      thread_ids->push_back(thread_id);
+    return true;
+  }
+  const base::ListValue* list_value;
+  CHECK(value->GetAsList(&list_value));
+  for (size_t i = 0; i < list_value->GetSize(); ++i) {
+    std::string id_string;
+    int thread_id;
+    if (list_value->GetString(i, &id_string) &&
+        base::StringToInt(id_string, &thread_id)) {
+      thread_ids->push_back(thread_id);
+    }
+  }
+  return true;
+}
+
+ThreadId ThreadIdFromRecordResults(
+    const std::vector<GdbRecordResult*>& results) {
+  // Not there if the stop wasn't in a thread, e.g. the process exited.
+  const base::Value* value = FindValue("thread-id", results);
+  std::string id_string;
+  int thread_id;
+  if (value &&
+      value->GetAsString(&id_string) &&
+      base::StringToInt(id_string, &thread_id)) {
+    return thread_id;
+  }
+  return 0;
+}
+
 FrameData FrameDataFromDictionaryValue(const base::DictionaryValue* dict) {
   std::string addr_string, filename_string, function_string, line_string;
   CHECK(dict->GetStringWithoutPathExpansion("addr", &addr_string));
@@ -72,6 +125,7 @@ FrameData FrameDataFromDictionaryValue(const base::DictionaryValue* dict) {
 StoppedAtBreakpointData StoppedAtBreakpointDataFromRecordResults(
     const std::vector<GdbRecordResult*>& results) {
   StoppedAtBreakpointData data;
+  data.thread_id = ThreadIdFromRecordResults(results);
   data.frame = FrameDataFromDictionaryValue(
       FindDictionaryValue("frame", results));
   return data;
@@ -80,11 +134,82 @@ StoppedAtBreakpointData StoppedAtBreakpointDataFromRecordResults(
 StoppedAfterSteppingData StoppedAfterSteppingDataFromRecordResults(
     const std::vector<GdbRecordResult*>& results) {
   StoppedAfterSteppingData data;
+  data.thread_id = ThreadIdFromRecordResults(results);
   data.frame = FrameDataFromDictionaryValue(
       FindDictionaryValue("frame", results));
   return data;
 }
 
+ProcessExitedData ProcessExitedDataFromRecordResults(
+    const std::vector<GdbRecordResult*>& results) {
+  ProcessExitedData data;
+  data.exit_code = 0;
+  std::string value;
+  // gdb gives the exit code in octal.
+  const base::Value* exit_code = FindValue("exit-code", results);
+  if (exit_code && exit_code->GetAsString(&value))
+    data.exit_code = static_cast<int>(strtol(value.c_str(), NULL, 8));
+  const base::Value* signal_name = FindValue("signal-name", results);
+  if (signal_name && signal_name->GetAsString(&value))
+    data.signal_name = UTF8ToUTF16(value);
+  return data;
+}
+
+RetrievedThreadsData RetrievedThreadsDataFromRecordResults(
+    const std::vector<GdbRecordResult*>& results) {
+  RetrievedThreadsData data;
+  data.complete = false;
+  const base::ListValue* list_value = FindListValue("threads", results);
+  for (size_t i = 0; i < list_value->GetSize(); ++i) {
+    const base::DictionaryValue* dict_value;
+    CHECK(list_value->GetDictionary(i, &dict_value));
+    ThreadData thread;
+    std::string id_string, state_string;
+    CHECK(dict_value->GetStringWithoutPathExpansion("id", &id_string));
+    CHECK(base::StringToInt(id_string, &thread.id));
+    dict_value->GetStringWithoutPathExpansion("target-id", &thread.target_id);
+    dict_value->GetStringWithoutPathExpansion("state", &state_string);
+    thread.state = state_string == "running" ? THREAD_RUNNING : THREAD_STOPPED;
+    // Running threads don't have one.
+    const base::DictionaryValue* frame_dict_value;
+    if (dict_value->GetDictionaryWithoutPathExpansion("frame",
+                                                      &frame_dict_value)) {
+      thread.frame = FrameDataFromDictionaryValue(frame_dict_value);
+    } else {
+      thread.frame.address = 0;
+      thread.frame.line_number = 0;
+    }
+    data.threads.push_back(thread);
+  }
+  return data;
+}
+
+CoreLoadedData CoreLoadedDataFromThreadInfoResults(
+    const std::vector<GdbRecordResult*>& results) {
+  RetrievedThreadsData threads = RetrievedThreadsDataFromRecordResults(results);
+  CoreLoadedData data;
+  data.thread_id = 0;
+  data.frame.address = 0;
+  data.frame.line_number = 0;
+  if (threads.threads.empty())
+    return data;
+  // gdb selects the thread that got the signal.
+  size_t current = 0;
+  std::string value;
+  int current_id;
+  const base::Value* current_value = FindValue("current-thread-id", results);
+  if (current_value && current_value->GetAsString(&value) &&
+      base::StringToInt(value, &current_id)) {
+    for (size_t i = 0; i < threads.threads.size(); ++i) {
+      if (threads.threads[i].id == current_id)
+        current = i;
+    }
+  }
+  data.thread_id = threads.threads[current].id;
+  data.frame = threads.threads[current].frame;
+  return data;
+}
+
 RetrievedStackData RetrievedStackDataFromList(base::Value* value) {
   base::ListValue* list_value;
   CHECK(value->GetAsList(&list_value));
@@ -148,17 +273,22 @@ RetrievedLocalsData RetrievedLocalsDataFromList(base::Value* value) {
   return data;
 }
 
-LibraryLoadedData LibraryLoadedDataFromRecordResults(
+LibraryEvent LibraryEventFromRecordResults(
+    LibraryEvent::Kind kind,
     const std::vector<GdbRecordResult*>& results) {
-  LibraryLoadedData data;
-  data.target_path = UTF8ToUTF16(FindStringValue("target-name", results));
-  data.host_path = UTF8ToUTF16(FindStringValue("host-name", results));
-  data.thread_id = UTF8ToUTF16(FindStringValue("thread-group", results));
-  std::string symbols_string = FindStringValue("symbols-loaded", results);
-  int symbols_int;
-  CHECK(base::StringToInt(symbols_string, &symbols_int));
-  data.symbols_loaded = symbols_int;
-  return data;
+  LibraryEvent event;
+  event.kind = kind;
+  event.target_path = UTF8ToUTF16(FindStringValue("target-name", results));
+  event.host_path = UTF8ToUTF16(FindStringValue("host-name", results));
+  event.thread_id = UTF8ToUTF16(FindStringValue("thread-group", results));
+  event.symbols_loaded = false;
+  if (kind == LibraryEvent::LOADED) {
+    std::string symbols_string = FindStringValue("symbols-loaded", results);
+    int symbols_int;
+    CHECK(base::StringToInt(symbols_string, &symbols_int));
+    event.symbols_loaded = symbols_int;
+  }
+  return event;
 }
 
 WatchCreatedData WatchCreatedDataFromRecordResults(
@@ -242,3 +372,51 @@ WatchesChildListData WatchesChildListDataFromRecordResults(
   }
   return data;
 }
+
+bool TracepointHitsFromConsoleOutput(const std::string& output,
+                                     std::string* partial_line,
+                                     std::vector<TracepointHit>* hits) {
+  const size_t prefix_length = arraysize(kTracepointOutputPrefix) - 1;
+  std::string text = *partial_line + output;
+  std::vector<TracepointHit> result;
+  size_t begin = 0;
+  size_t end;
+  while ((end = text.find('\n', begin)) != std::string::npos) {
+    if (text.compare(begin, prefix_length, kTracepointOutputPrefix) != 0)
+      return false;
+    size_t colon = text.find(':', begin + prefix_length);
+    if (colon == std::string::npos || colon > end)
+      return false;
+    TracepointHit hit;
+    if (!base::StringToInt(
+            text.substr(begin + prefix_length,
+                        colon - begin - prefix_length),
+            &hit.tracepoint_id)) {
+      return false;
+    }
+    size_t text_begin = colon + 1;
+    if (text_begin < end && text[text_begin] == ' ')
+      ++text_begin;
+    hit.text = UTF8ToUTF16(text.substr(text_begin, end - text_begin));
+    result.push_back(hit);
+    begin = end + 1;
+  }
+  // Whatever's left has to be the start of another, as far as it goes.
+  std::string rest = text.substr(begin);
+  if (rest.size() <= prefix_length) {
+    if (rest.compare(0, rest.size(), kTracepointOutputPrefix, rest.size()))
+      return false;
+  } else {
+    size_t id_end = rest.find_first_not_of("0123456789", prefix_length);
+    if (rest.compare(0, prefix_length, kTracepointOutputPrefix) != 0 ||
+        (id_end != std::string::npos &&
+         (id_end == prefix_length || rest[id_end] != ':'))) {
+      return false;
+    }
+  }
+  if (result.empty() && rest.empty())
+    return false;
+  hits->insert(hits->end(), result.begin(), result.end());
+  partial_line->swap(rest);
+  return true;
+}
@@ -27,12 +27,39 @@ const base::ListValue* FindListValue(
     const std::string& key,
     const std::vector<GdbRecordResult*>& results);
 
+// Returns NULL if there's no |key|, rather than asserting.
+const base::Value* FindValue(
+    const std::string& key,
+    const std::vector<GdbRecordResult*>& results);
+
+// Parses a thread-id or stopped-threads value, which is a single id, a list
+// of ids, or "all". Returns false for "all".
+bool ThreadIdsFromValue(const base::Value* value,
+                        std::vector<ThreadId>* thread_ids);
+
+// The thread-id of a stop, or 0 if there isn't one.
+ThreadId ThreadIdFromRecordResults(
+    const std::vector<GdbRecordResult*>& results);
+
 StoppedAtBreakpointData StoppedAtBreakpointDataFromRecordResults(
     const std::vector<GdbRecordResult*>& results);
 
 StoppedAfterSteppingData StoppedAfterSteppingDataFromRecordResults(
     const std::vector<GdbRecordResult*>& results);
 
+// For a stop whose reason is "exited", "exited-normally", or
+// "exited-signalled".
+ProcessExitedData ProcessExitedDataFromRecordResults(
+    const std::vector<GdbRecordResult*>& results);
+
+// From the result of -thread-info, for all threads or for one.
+RetrievedThreadsData RetrievedThreadsDataFromRecordResults(
+    const std::vector<GdbRecordResult*>& results);
+
+// From the result of -thread-info after a core file's been loaded.
+CoreLoadedData CoreLoadedDataFromThreadInfoResults(
+    const std::vector<GdbRecordResult*>& results);
+
 RetrievedStackData RetrievedStackDataFromList(base::Value* list_value);
 
 RetrievedStackData MergeArgumentsIntoStackFrameData(
@@ -41,7 +68,9 @@ RetrievedStackData MergeArgumentsIntoStackFrameData(
 
 RetrievedLocalsData RetrievedLocalsDataFromList(base::Value* list_value);
 
-LibraryLoadedData LibraryLoadedDataFromRecordResults(
+// From =library-loaded or =library-unloaded, as |kind| says.
+LibraryEvent LibraryEventFromRecordResults(
+    LibraryEvent::Kind kind,
     const std::vector<GdbRecordResult*>& results);
 
 WatchCreatedData WatchCreatedDataFromRecordResults(
@@ -52,4 +81,17 @@ WatchesUpdatedData WatchesUpdatedDataFromChangesList(base::Value* list_value);
 WatchesChildListData WatchesChildListDataFromRecordResults(
     const std::vector<GdbRecordResult*>& results);
 
+// dprintf formats are prefixed with this and the tracepoint's id, e.g.
+// "sg-tp 3: ", so that their output can be told apart from the rest of
+// gdb's console output.
+extern const char kTracepointOutputPrefix[];
+
+// Appends a hit for each line of |output|, which continues |partial_line|.
+// gdb can split a line across console records, so a tracepoint line that
+// |output| ends part way through is left in |partial_line| for the next.
+// Returns false, changing nothing, if it isn't all tracepoint output.
+bool TracepointHitsFromConsoleOutput(const std::string& output,
+                                     std::string* partial_line,
+                                     std::vector<TracepointHit>* hits);
+
 #endif  // SG_BACKEND_GDB_TO_GENERIC_CONVERTER_H_
@@ -0,0 +1,192 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "sg/backend/gdb_mi_parse.h"
+#include "sg/backend/gdb_to_generic_converter.h"
+
+TEST(GdbToGenericConverter, AllStopStop) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> stopped(p.Parse(
+      "*stopped,reason=\"end-stepping-range\",frame={addr=\"0x0040139b\","
+      "func=\"SubFunction\",args=[],file=\"test_binary.cc\",line=\"12\"},"
+      "thread-id=\"1\",stopped-threads=\"all\"\r",
+      NULL));
+  StoppedAfterSteppingData data =
+      StoppedAfterSteppingDataFromRecordResults(stopped->results());
+  EXPECT_EQ(1, data.thread_id);
+  EXPECT_EQ(12, data.frame.line_number);
+
+  std::vector<ThreadId> thread_ids;
+  EXPECT_FALSE(ThreadIdsFromValue(
+      FindValue("stopped-threads", stopped->results()), &thread_ids));
+  EXPECT_EQ(NULL, FindValue("nonexistent", stopped->results()));
+}
+
+TEST(GdbToGenericConverter, NonStopStop) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> stopped(p.Parse(
+      "*stopped,reason=\"breakpoint-hit\",disp=\"keep\",bkptno=\"1\","
+      "frame={addr=\"0x004013a3\",func=\"Function\",args=[],"
+      "file=\"test_binary.cc\",line=\"15\"},thread-id=\"217\","
+      "stopped-threads=[\"217\"],core=\"3\"\r",
+      NULL));
+  StoppedAtBreakpointData data =
+      StoppedAtBreakpointDataFromRecordResults(stopped->results());
+  EXPECT_EQ(217, data.thread_id);
+  EXPECT_EQ(15, data.frame.line_number);
+
+  std::vector<ThreadId> thread_ids;
+  ASSERT_TRUE(ThreadIdsFromValue(
+      FindValue("stopped-threads", stopped->results()), &thread_ids));
+  ASSERT_EQ(1, thread_ids.size());
+  EXPECT_EQ(217, thread_ids[0]);
+}
+
+TEST(GdbToGenericConverter, Running) {
+  GdbMiParser p;
+  std::vector<ThreadId> thread_ids;
+
+  std::unique_ptr<GdbRecord> one(p.Parse("*running,thread-id=\"5\"\r", NULL));
+  ASSERT_TRUE(ThreadIdsFromValue(FindValue("thread-id", one->results()),
+                                 &thread_ids));
+  ASSERT_EQ(1, thread_ids.size());
+  EXPECT_EQ(5, thread_ids[0]);
+
+  std::unique_ptr<GdbRecord> all(p.Parse("*running,thread-id=\"all\"\r", NULL));
+  EXPECT_FALSE(ThreadIdsFromValue(FindValue("thread-id", all->results()),
+                                  &thread_ids));
+  EXPECT_EQ(0, thread_ids.size());
+}
+
+TEST(GdbToGenericConverter, StopWithoutThread) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> exited(p.Parse(
+      "*stopped,reason=\"exited-normally\"\r", NULL));
+  EXPECT_EQ(0, ThreadIdFromRecordResults(exited->results()));
+}
+
+TEST(GdbToGenericConverter, Exited) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> normally(p.Parse(
+      "*stopped,reason=\"exited-normally\"\r", NULL));
+  ProcessExitedData data =
+      ProcessExitedDataFromRecordResults(normally->results());
+  EXPECT_EQ(0, data.exit_code);
+  EXPECT_EQ(L"", data.signal_name);
+
+  std::unique_ptr<GdbRecord> code(p.Parse(
+      "*stopped,reason=\"exited\",exit-code=\"012\"\r", NULL));
+  data = ProcessExitedDataFromRecordResults(code->results());
+  EXPECT_EQ(10, data.exit_code);
+
+  std::unique_ptr<GdbRecord> signalled(p.Parse(
+      "*stopped,reason=\"exited-signalled\",signal-name=\"SIGSEGV\","
+      "signal-meaning=\"Segmentation fault\"\r", NULL));
+  data = ProcessExitedDataFromRecordResults(signalled->results());
+  EXPECT_EQ(L"SIGSEGV", data.signal_name);
+}
+
+TEST(GdbToGenericConverter, ThreadInfo) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> info(p.Parse(
+      "^done,threads=[{id=\"2\",target-id=\"Thread 11652.0x30\","
+      "state=\"running\"},"
+      "{id=\"1\",target-id=\"Thread 11652.0x2c\",frame={level=\"0\","
+      "addr=\"0x004013a3\",func=\"Function\",args=[],"
+      "file=\"test_binary.cc\",line=\"15\"},state=\"stopped\"}],"
+      "current-thread-id=\"1\"\r",
+      NULL));
+  RetrievedThreadsData data =
+      RetrievedThreadsDataFromRecordResults(info->results());
+  EXPECT_FALSE(data.complete);
+  ASSERT_EQ(2, data.threads.size());
+  EXPECT_EQ(2, data.threads[0].id);
+  EXPECT_EQ(THREAD_RUNNING, data.threads[0].state);
+  EXPECT_EQ(0, data.threads[0].frame.line_number);
+  EXPECT_EQ(1, data.threads[1].id);
+  EXPECT_EQ(L"Thread 11652.0x2c", data.threads[1].target_id);
+  EXPECT_EQ(THREAD_STOPPED, data.threads[1].state);
+  EXPECT_EQ(L"Function", data.threads[1].frame.function);
+  EXPECT_EQ(15, data.threads[1].frame.line_number);
+}
+
+TEST(GdbToGenericConverter, CoreLoaded) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> info(p.Parse(
+      "^done,threads=[{id=\"2\",target-id=\"LWP 9301\",frame={level=\"0\","
+      "addr=\"0x00401010\",func=\"Worker\",args=[],"
+      "file=\"test_binary.cc\",line=\"30\"},state=\"stopped\"},"
+      "{id=\"1\",target-id=\"LWP 9300\",frame={level=\"0\","
+      "addr=\"0x004013a3\",func=\"Function\",args=[],"
+      "file=\"test_binary.cc\",line=\"15\"},state=\"stopped\"}],"
+      "current-thread-id=\"1\"\r",
+      NULL));
+  CoreLoadedData data = CoreLoadedDataFromThreadInfoResults(info->results());
+  EXPECT_EQ(1, data.thread_id);
+  EXPECT_EQ(L"Function", data.frame.function);
+  EXPECT_EQ(15, data.frame.line_number);
+
+  std::unique_ptr<GdbRecord> no_current(p.Parse(
+      "^done,threads=[{id=\"2\",target-id=\"LWP 9301\","
+      "state=\"stopped\"}]\r",
+      NULL));
+  data = CoreLoadedDataFromThreadInfoResults(no_current->results());
+  EXPECT_EQ(2, data.thread_id);
+}
+
+TEST(GdbToGenericConverter, TracepointOutput) {
+  GdbMiParser p;
+  std::unique_ptr<GdbRecord> output(p.Parse(
+      "~\"sg-tp 3: i=1 name=\\\"x\\\"\\nsg-tp 12: \\n\"\r", NULL));
+  std::string partial;
+  std::vector<TracepointHit> hits;
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput(
+      output->OutputString(), &partial, &hits));
+  ASSERT_EQ(2, hits.size());
+  EXPECT_EQ(3, hits[0].tracepoint_id);
+  EXPECT_EQ(L"i=1 name=\"x\"", hits[0].text);
+  EXPECT_EQ(12, hits[1].tracepoint_id);
+  EXPECT_EQ(L"", hits[1].text);
+  EXPECT_EQ("", partial);
+
+  // Anything else is left as console output.
+  EXPECT_FALSE(
+      TracepointHitsFromConsoleOutput("sg-tp 3: a\nb\n", &partial, &hits));
+  EXPECT_FALSE(
+      TracepointHitsFromConsoleOutput("sg-tp x: a\n", &partial, &hits));
+  EXPECT_FALSE(
+      TracepointHitsFromConsoleOutput("Breakpoint 1\n", &partial, &hits));
+  EXPECT_FALSE(TracepointHitsFromConsoleOutput("sg-tp x", &partial, &hits));
+  EXPECT_FALSE(TracepointHitsFromConsoleOutput("", &partial, &hits));
+  EXPECT_EQ(2, hits.size());
+  EXPECT_EQ("", partial);
+}
+
+TEST(GdbToGenericConverter, TracepointOutputSplitAcrossRecords) {
+  std::string partial;
+  std::vector<TracepointHit> hits;
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput("sg-tp 3: i=", &partial, &hits));
+  EXPECT_EQ(0, hits.size());
+  EXPECT_EQ("sg-tp 3: i=", partial);
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput("1\nsg-", &partial, &hits));
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput("tp 1", &partial, &hits));
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput("2: x\n", &partial, &hits));
+  ASSERT_EQ(2, hits.size());
+  EXPECT_EQ(3, hits[0].tracepoint_id);
+  EXPECT_EQ(L"i=1", hits[0].text);
+  EXPECT_EQ(12, hits[1].tracepoint_id);
+  EXPECT_EQ(L"x", hits[1].text);
+  EXPECT_EQ("", partial);
+
+  // A line that turns out not to be from a tracepoint is left alone.
+  ASSERT_TRUE(TracepointHitsFromConsoleOutput("sg", &partial, &hits));
+  EXPECT_FALSE(TracepointHitsFromConsoleOutput("db\n", &partial, &hits));
+  EXPECT_EQ("sg", partial);
+  EXPECT_EQ(2, hits.size());
+}
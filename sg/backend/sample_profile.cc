@@ -0,0 +1,142 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/backend/sample_profile.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "base/stringprintf.h"
+#include "base/utf_string_conversions.h"
+
+namespace {
+
+class LargerTotalFirst {
+ public:
+  explicit LargerTotalFirst(const std::vector<ProfileNode>& nodes)
+      : nodes_(&nodes) {
+  }
+
+  bool operator()(int a, int b) const {
+    const ProfileNode& node_a = (*nodes_)[a];
+    const ProfileNode& node_b = (*nodes_)[b];
+    if (node_a.total != node_b.total)
+      return node_a.total > node_b.total;
+    return node_a.function < node_b.function;
+  }
+
+ private:
+  const std::vector<ProfileNode>* nodes_;
+};
+
+void FormatNode(const ProfileData& data,
+                int index,
+                int depth,
+                std::string* result) {
+  const ProfileNode& node = data.nodes[index];
+  double scale = 100. / data.nodes[0].total;
+  result->append(base::StringPrintf("%5.1f%% %5.1f%%  ",
+                                    node.total * scale, node.self * scale));
+  result->append(depth * 2, ' ');
+  result->append(UTF16ToUTF8(node.function));
+  result->append("\n");
+  for (size_t i = 0; i < node.children.size(); ++i)
+    FormatNode(data, node.children[i], depth + 1, result);
+}
+
+}  // namespace
+
+SampleProfileBuilder::SampleProfileBuilder() {
+}
+
+SampleProfileBuilder::~SampleProfileBuilder() {
+}
+
+void SampleProfileBuilder::AddStack(const std::vector<uint64>& addresses) {
+  addresses_.insert(addresses_.end(), addresses.begin(), addresses.end());
+  stack_ends_.push_back(addresses_.size());
+}
+
+void SampleProfileBuilder::AddPause(base::TimeDelta pause) {
+  pauses_.push_back(pause);
+}
+
+void SampleProfileBuilder::Build(const SymbolizeCallback& symbolize,
+                                 ProfileData* data) const {
+  data->nodes.assign(1, ProfileNode());
+  data->nodes[0].total = 0;
+  data->nodes[0].self = 0;
+
+  std::map<uint64, string16> names;
+  // Children of each node, by function. Different addresses in the same
+  // function end up in the same node.
+  std::map<std::pair<int, string16>, int> children;
+  size_t begin = 0;
+  for (size_t i = 0; i < stack_ends_.size(); ++i) {
+    size_t end = stack_ends_[i];
+    int node = 0;
+    ++data->nodes[0].total;
+    // Outermost first, from the root down.
+    for (size_t j = end; j > begin; --j) {
+      uint64 address = addresses_[j - 1];
+      std::map<uint64, string16>::iterator name = names.find(address);
+      if (name == names.end()) {
+        name = names.insert(
+            std::make_pair(address, symbolize.Run(address))).first;
+      }
+      std::pair<std::map<std::pair<int, string16>, int>::iterator, bool>
+          child = children.insert(std::make_pair(
+              std::make_pair(node, name->second),
+              static_cast<int>(data->nodes.size())));
+      if (child.second) {
+        ProfileNode new_node;
+        new_node.function = name->second;
+        new_node.total = 0;
+        new_node.self = 0;
+        data->nodes.push_back(new_node);
+        data->nodes[node].children.push_back(child.first->second);
+      }
+      node = child.first->second;
+      ++data->nodes[node].total;
+    }
+    ++data->nodes[node].self;
+    begin = end;
+  }
+
+  LargerTotalFirst larger_total_first(data->nodes);
+  for (size_t i = 0; i < data->nodes.size(); ++i) {
+    std::sort(data->nodes[i].children.begin(),
+              data->nodes[i].children.end(),
+              larger_total_first);
+  }
+
+  data->sample_count = sample_count();
+  data->stack_count = stack_count();
+  data->duration_ms = 0;
+  base::TimeDelta total_pause;
+  base::TimeDelta max_pause;
+  for (size_t i = 0; i < pauses_.size(); ++i) {
+    total_pause += pauses_[i];
+    max_pause = std::max(max_pause, pauses_[i]);
+  }
+  data->mean_pause_us =
+      pauses_.empty() ? 0 : total_pause.InMicrosecondsF() / pauses_.size();
+  data->max_pause_us = max_pause.InMicrosecondsF();
+}
+
+std::string FormatProfile(const ProfileData& data) {
+  std::string result = base::StringPrintf(
+      "%d samples, %d stacks over %.0fms, target stopped %.0fus per sample "
+      "(max %.0fus)\n\n",
+      data.sample_count, data.stack_count, data.duration_ms,
+      data.mean_pause_us, data.max_pause_us);
+  if (data.nodes.empty() || data.nodes[0].total == 0)
+    return result;
+  result += " total   self\n";
+  const ProfileNode& root = data.nodes[0];
+  for (size_t i = 0; i < root.children.size(); ++i)
+    FormatNode(data, root.children[i], 0, &result);
+  return result;
+}
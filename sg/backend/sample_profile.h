@@ -0,0 +1,57 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BACKEND_SAMPLE_PROFILE_H_
+#define SG_BACKEND_SAMPLE_PROFILE_H_
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/time.h"
+#include "sg/backend/backend.h"
+
+// Collects the stacks seen each time the target is stopped for a sample,
+// and turns them into a call tree at the end. Samples are kept as bare
+// addresses, so that taking one costs as little of the target's time as
+// possible, and each distinct address is only symbolized once, when the
+// profile is built.
+class SampleProfileBuilder {
+ public:
+  // Returns the name of the function containing |address|.
+  typedef base::Callback<string16(uint64 address)> SymbolizeCallback;
+
+  SampleProfileBuilder();
+  ~SampleProfileBuilder();
+
+  // |addresses| is one thread's stack, innermost first. They're only
+  // passed back to the symbolizer, so callers can use whatever their
+  // symbolizer expects, e.g. adjusting return addresses to be inside the
+  // call.
+  void AddStack(const std::vector<uint64>& addresses);
+
+  // Records how long the target was stopped to capture a sample.
+  void AddPause(base::TimeDelta pause);
+
+  int sample_count() const { return static_cast<int>(pauses_.size()); }
+  int stack_count() const { return static_cast<int>(stack_ends_.size()); }
+
+  // Everything but |duration_ms|, which the caller knows best.
+  void Build(const SymbolizeCallback& symbolize, ProfileData* data) const;
+
+ private:
+  // All the stacks, one after the other, and where each one ends.
+  std::vector<uint64> addresses_;
+  std::vector<size_t> stack_ends_;
+  std::vector<base::TimeDelta> pauses_;
+
+  DISALLOW_COPY_AND_ASSIGN(SampleProfileBuilder);
+};
+
+// Text for exporting a profile: a summary, then the call tree indented by
+// depth, with the percentage of stacks through and ending at each node.
+std::string FormatProfile(const ProfileData& data);
+
+#endif  // SG_BACKEND_SAMPLE_PROFILE_H_
@@ -0,0 +1,123 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/stringprintf.h"
+#include "base/utf_string_conversions.h"
+#include "sg/backend/sample_profile.h"
+
+namespace {
+
+// Functions are 0x100 bytes long, and named after their address.
+string16 Symbolize(std::map<uint64, int>* lookups, uint64 address) {
+  ++(*lookups)[address];
+  return UTF8ToUTF16(base::StringPrintf("f%x", static_cast<int>(
+      address >> 8)));
+}
+
+std::vector<uint64> MakeStack(uint64 a, uint64 b, uint64 c) {
+  std::vector<uint64> stack;
+  stack.push_back(a);
+  stack.push_back(b);
+  if (c)
+    stack.push_back(c);
+  return stack;
+}
+
+const ProfileNode& Child(const ProfileData& data, int parent, int i) {
+  return data.nodes[data.nodes[parent].children[i]];
+}
+
+}  // namespace
+
+TEST(SampleProfile, CallTree) {
+  SampleProfileBuilder builder;
+  // main -> f2 -> f3, three times at different places in f3.
+  builder.AddStack(MakeStack(0x310, 0x220, 0x110));
+  builder.AddStack(MakeStack(0x320, 0x220, 0x110));
+  builder.AddStack(MakeStack(0x310, 0x220, 0x110));
+  // main -> f4.
+  builder.AddStack(MakeStack(0x410, 0x120, 0));
+  // main -> f2, innermost.
+  builder.AddStack(MakeStack(0x230, 0x110, 0));
+  builder.AddPause(base::TimeDelta::FromMicroseconds(100));
+  builder.AddPause(base::TimeDelta::FromMicroseconds(300));
+  EXPECT_EQ(2, builder.sample_count());
+  EXPECT_EQ(5, builder.stack_count());
+
+  std::map<uint64, int> lookups;
+  ProfileData data;
+  builder.Build(base::Bind(&Symbolize, &lookups), &data);
+
+  // Each address once, however many stacks it was in.
+  EXPECT_EQ(7, lookups.size());
+  for (std::map<uint64, int>::const_iterator it = lookups.begin();
+       it != lookups.end(); ++it) {
+    EXPECT_EQ(1, it->second);
+  }
+
+  EXPECT_EQ(2, data.sample_count);
+  EXPECT_EQ(5, data.stack_count);
+  EXPECT_DOUBLE_EQ(200., data.mean_pause_us);
+  EXPECT_DOUBLE_EQ(300., data.max_pause_us);
+
+  // root -> f1 -> {f2 -> f3, f4}.
+  ASSERT_EQ(5, data.nodes.size());
+  EXPECT_EQ(5, data.nodes[0].total);
+  EXPECT_EQ(0, data.nodes[0].self);
+  ASSERT_EQ(1, data.nodes[0].children.size());
+  const ProfileNode& f1 = Child(data, 0, 0);
+  EXPECT_EQ(L"f1", f1.function);
+  EXPECT_EQ(5, f1.total);
+  EXPECT_EQ(0, f1.self);
+  ASSERT_EQ(2, f1.children.size());
+  int f1_index = data.nodes[0].children[0];
+  const ProfileNode& f2 = Child(data, f1_index, 0);
+  EXPECT_EQ(L"f2", f2.function);
+  EXPECT_EQ(4, f2.total);
+  EXPECT_EQ(1, f2.self);
+  const ProfileNode& f4 = Child(data, f1_index, 1);
+  EXPECT_EQ(L"f4", f4.function);
+  EXPECT_EQ(1, f4.total);
+  EXPECT_EQ(1, f4.self);
+  ASSERT_EQ(1, f2.children.size());
+  const ProfileNode& f3 = Child(data, f1.children[0], 0);
+  EXPECT_EQ(L"f3", f3.function);
+  EXPECT_EQ(3, f3.total);
+  EXPECT_EQ(3, f3.self);
+  EXPECT_EQ(0, f3.children.size());
+
+  data.duration_ms = 50;
+  EXPECT_EQ(
+      "2 samples, 5 stacks over 50ms, target stopped 200us per sample "
+      "(max 300us)\n"
+      "\n"
+      " total   self\n"
+      "100.0%   0.0%  f1\n"
+      " 80.0%  20.0%    f2\n"
+      " 60.0%  60.0%      f3\n"
+      " 20.0%  20.0%    f4\n",
+      FormatProfile(data));
+}
+
+TEST(SampleProfile, Empty) {
+  SampleProfileBuilder builder;
+  ProfileData data;
+  std::map<uint64, int> lookups;
+  builder.Build(base::Bind(&Symbolize, &lookups), &data);
+  ASSERT_EQ(1, data.nodes.size());
+  EXPECT_EQ(0, data.nodes[0].total);
+  EXPECT_EQ(0, data.sample_count);
+  EXPECT_DOUBLE_EQ(0., data.mean_pause_us);
+  data.duration_ms = 0;
+  EXPECT_EQ(
+      "0 samples, 0 stacks over 0ms, target stopped 0us per sample "
+      "(max 0us)\n\n",
+      FormatProfile(data));
+}
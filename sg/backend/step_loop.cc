@@ -0,0 +1,71 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/backend/step_loop.h"
+
+#include "base/logging.h"
+
+StepLoop::StepLoop(int max_steps, bool has_condition)
+    : max_steps_(max_steps),
+      has_condition_(has_condition),
+      steps_(0),
+      cancelled_(false),
+      finished_(false),
+      reason_(STEP_LOOP_LIMIT_REACHED) {
+}
+
+StepLoop::~StepLoop() {
+}
+
+StepLoop::Action StepLoop::OnStopped(bool completed_step) {
+  DCHECK(!finished_);
+  if (!completed_step)
+    return Finish(STEP_LOOP_INTERRUPTED);
+  ++steps_;
+  if (cancelled_)
+    return Finish(STEP_LOOP_CANCELLED);
+  if (has_condition_)
+    return EVALUATE_CONDITION;
+  return StepAgainUnlessDone();
+}
+
+StepLoop::Action StepLoop::OnConditionValue(const std::string& value) {
+  DCHECK(!finished_);
+  // gdb prints C++ bools as words, and C ones as numbers.
+  if (value == "true" || (value != "false" && value != "0"))
+    return Finish(STEP_LOOP_CONDITION_MET);
+  if (cancelled_)
+    return Finish(STEP_LOOP_CANCELLED);
+  return StepAgainUnlessDone();
+}
+
+StepLoop::Action StepLoop::OnConditionError(const string16& message) {
+  DCHECK(!finished_);
+  error_ = message;
+  return Finish(STEP_LOOP_CONDITION_FAILED);
+}
+
+void StepLoop::Cancel() {
+  cancelled_ = true;
+}
+
+void StepLoop::GetResult(double duration_ms, StepLoopData* data) const {
+  DCHECK(finished_);
+  data->steps = steps_;
+  data->duration_ms = duration_ms;
+  data->reason = reason_;
+  data->error = error_;
+}
+
+StepLoop::Action StepLoop::Finish(StepLoopEndReason reason) {
+  finished_ = true;
+  reason_ = reason;
+  return FINISH;
+}
+
+StepLoop::Action StepLoop::StepAgainUnlessDone() {
+  if (steps_ >= max_steps_)
+    return Finish(STEP_LOOP_LIMIT_REACHED);
+  return STEP;
+}
@@ -0,0 +1,60 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BACKEND_STEP_LOOP_H_
+#define SG_BACKEND_STEP_LOOP_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
+
+// Decides what a backend does next while stepping repeatedly, up to a
+// number of steps, or until a condition is true, so that each step doesn't
+// need a trip through the UI. The condition is checked after every step.
+class StepLoop {
+ public:
+  enum Action {
+    STEP,
+    EVALUATE_CONDITION,
+    FINISH,
+  };
+
+  StepLoop(int max_steps, bool has_condition);
+  ~StepLoop();
+
+  // After the target stops. |completed_step| is false if it stopped for
+  // some other reason, e.g. a breakpoint or a signal, which ends the loop.
+  Action OnStopped(bool completed_step);
+
+  // |value| is what the debugger printed for the condition, which should
+  // be a boolean or an integer.
+  Action OnConditionValue(const std::string& value);
+  Action OnConditionError(const string16& message);
+
+  // Takes effect when the current step finishes.
+  void Cancel();
+
+  int steps() const { return steps_; }
+
+  // Once OnStopped() or one of the OnCondition* has returned FINISH.
+  void GetResult(double duration_ms, StepLoopData* data) const;
+
+ private:
+  Action Finish(StepLoopEndReason reason);
+  // After a step that didn't end the loop by itself.
+  Action StepAgainUnlessDone();
+
+  int max_steps_;
+  bool has_condition_;
+  int steps_;
+  bool cancelled_;
+  bool finished_;
+  StepLoopEndReason reason_;
+  string16 error_;
+
+  DISALLOW_COPY_AND_ASSIGN(StepLoop);
+};
+
+#endif  // SG_BACKEND_STEP_LOOP_H_
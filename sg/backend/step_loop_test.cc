@@ -0,0 +1,67 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include "sg/backend/step_loop.h"
+
+TEST(StepLoop, StepCount) {
+  StepLoop loop(3, false);
+  EXPECT_EQ(StepLoop::STEP, loop.OnStopped(true));
+  EXPECT_EQ(StepLoop::STEP, loop.OnStopped(true));
+  EXPECT_EQ(StepLoop::FINISH, loop.OnStopped(true));
+  StepLoopData data;
+  loop.GetResult(12.5, &data);
+  EXPECT_EQ(3, data.steps);
+  EXPECT_EQ(12.5, data.duration_ms);
+  EXPECT_EQ(STEP_LOOP_LIMIT_REACHED, data.reason);
+}
+
+TEST(StepLoop, Condition) {
+  StepLoop loop(100, true);
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, loop.OnStopped(true));
+  EXPECT_EQ(StepLoop::STEP, loop.OnConditionValue("false"));
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, loop.OnStopped(true));
+  EXPECT_EQ(StepLoop::STEP, loop.OnConditionValue("0"));
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, loop.OnStopped(true));
+  EXPECT_EQ(StepLoop::FINISH, loop.OnConditionValue("1"));
+  StepLoopData data;
+  loop.GetResult(0, &data);
+  EXPECT_EQ(3, data.steps);
+  EXPECT_EQ(STEP_LOOP_CONDITION_MET, data.reason);
+
+  // The limit still applies.
+  StepLoop limited(1, true);
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, limited.OnStopped(true));
+  EXPECT_EQ(StepLoop::FINISH, limited.OnConditionValue("false"));
+  limited.GetResult(0, &data);
+  EXPECT_EQ(STEP_LOOP_LIMIT_REACHED, data.reason);
+
+  StepLoop failed(100, true);
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, failed.OnStopped(true));
+  EXPECT_EQ(StepLoop::FINISH,
+            failed.OnConditionError(L"No symbol \"x\" in current context."));
+  failed.GetResult(0, &data);
+  EXPECT_EQ(1, data.steps);
+  EXPECT_EQ(STEP_LOOP_CONDITION_FAILED, data.reason);
+  EXPECT_EQ(L"No symbol \"x\" in current context.", data.error);
+}
+
+TEST(StepLoop, Interrupted) {
+  StepLoop loop(100, false);
+  EXPECT_EQ(StepLoop::STEP, loop.OnStopped(true));
+  // e.g. a breakpoint in a function that was stepped over.
+  EXPECT_EQ(StepLoop::FINISH, loop.OnStopped(false));
+  StepLoopData data;
+  loop.GetResult(0, &data);
+  EXPECT_EQ(1, data.steps);
+  EXPECT_EQ(STEP_LOOP_INTERRUPTED, data.reason);
+
+  StepLoop cancelled(100, true);
+  EXPECT_EQ(StepLoop::EVALUATE_CONDITION, cancelled.OnStopped(true));
+  cancelled.Cancel();
+  EXPECT_EQ(StepLoop::FINISH, cancelled.OnConditionValue("false"));
+  cancelled.GetResult(0, &data);
+  EXPECT_EQ(STEP_LOOP_CANCELLED, data.reason);
+}
@@ -0,0 +1,341 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/backend/symbolization_cache.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "sg/cache_util.h"
+
+namespace {
+
+// Bump when the layout changes, so that old files are started over.
+const uint32 kVersion = 2;
+const char kMagic[8] = { 'S', 'G', 'S', 'Y', 'M', 'C', 'C', 'H' };
+
+// Records are padded to this so that their headers can be read in place.
+const size_t kRecordAlignment = 8;
+
+// Appended records are looked up in memory, so once there are more than
+// this, or than a quarter of those indexed, Open() folds them into the
+// index.
+const size_t kMinRecordsToCompact = 1024;
+
+}  // namespace
+
+// Followed by |index_count| IndexEntry, then the indexed records, then any
+// appended since.
+struct SymbolizationCache::FileHeader {
+  char magic[8];
+  uint32 version;
+  uint32 index_count;
+  uint64 appended_offset;
+};
+
+struct SymbolizationCache::IndexEntry {
+  bool operator<(const IndexEntry& other) const {
+    if (build_id_hash != other.build_id_hash)
+      return build_id_hash < other.build_id_hash;
+    return address < other.address;
+  }
+
+  // Build ids are hashed so that entries are all the same size.
+  uint64 build_id_hash;
+  uint64 address;
+  // From the start of the file.
+  uint64 record_offset;
+};
+
+// Followed by the build id, function, and file, without terminators.
+struct SymbolizationCache::RecordHeader {
+  // Whether it's intact, given |available| bytes from its start.
+  bool IsValid(size_t available) const {
+    size_t strings_size = static_cast<size_t>(build_id_length) +
+                          function_length + file_length;
+    return size % kRecordAlignment == 0 &&
+           size <= available &&
+           sizeof(RecordHeader) + strings_size <= size &&
+           build_id_length != 0;
+  }
+
+  const char* build_id() const {
+    return reinterpret_cast<const char*>(this + 1);
+  }
+
+  // Including this header, the strings, and padding.
+  uint32 size;
+  int32 line;
+  uint64 address;
+  uint16 build_id_length;
+  uint16 function_length;
+  uint16 file_length;
+  uint16 padding;
+};
+
+SymbolizationCache::SymbolizationCache()
+    : data_(NULL),
+      index_(NULL),
+      index_count_(0),
+      appended_offset_(0) {
+}
+
+SymbolizationCache::~SymbolizationCache() {
+}
+
+bool SymbolizationCache::Open(const base::FilePath& path) {
+  path_ = path;
+  file_.reset();
+  Clear();
+
+  // At most once to start over or drop a partial record, once to compact,
+  // then once more to map the result.
+  bool compacted = false;
+  for (int attempt = 0; attempt < 3; ++attempt) {
+    std::unique_ptr<base::MemoryMappedFile> file(new base::MemoryMappedFile);
+    std::string contents;
+    size_t valid;
+    if (file->Initialize(path) &&
+        IndexFile(file->data(), file->length(), &valid)) {
+      if (valid == file->length()) {
+        if (compacted || !NeedsCompaction()) {
+          file_.swap(file);
+          return true;
+        }
+        // Anything another session appends before it's replaced is lost,
+        // which is fine for a cache.
+        Compact(&contents);
+        compacted = true;
+      } else {
+        // Appending after a partial record would lose everything after it,
+        // so rewrite the file without it.
+        contents.assign(reinterpret_cast<const char*>(file->data()), valid);
+      }
+    } else {
+      // Missing, or from another version, so started over empty.
+      Clear();
+      Compact(&contents);
+    }
+    Clear();
+    file.reset();
+    if (!file_util::CreateDirectory(path.DirName()) ||
+        !WriteFileAtomically(path, contents)) {
+      // On Windows, a file another session has mapped can't be replaced.
+      // Compacting can wait until the next time.
+      if (!compacted)
+        break;
+    }
+  }
+  path_.clear();
+  return false;
+}
+
+bool SymbolizationCache::Lookup(const std::string& build_id,
+                                uint64 address,
+                                Entry* entry) const {
+  const RecordHeader* record = LookupIndex(build_id, address);
+  if (!record) {
+    AppendedMap::const_iterator it =
+        appended_.find(std::make_pair(build_id, address));
+    if (it == appended_.end())
+      return false;
+    record = it->second;
+  }
+  const char* strings = record->build_id() + record->build_id_length;
+  entry->function.assign(strings, record->function_length);
+  entry->file.assign(strings + record->function_length, record->file_length);
+  entry->line = record->line;
+  return true;
+}
+
+void SymbolizationCache::Add(const std::string& build_id,
+                             uint64 address,
+                             const Entry& entry) {
+  if (build_id.empty() ||
+      build_id.size() > kuint16max ||
+      entry.function.size() > kuint16max ||
+      entry.file.size() > kuint16max) {
+    return;
+  }
+  Entry existing;
+  if (Lookup(build_id, address, &existing))
+    return;
+
+  // Records are larger than any small string optimization, so the data is
+  // heap allocated and suitably aligned for the header.
+  added_.push_back(std::string());
+  std::string* record = &added_.back();
+  Serialize(build_id, address, entry, record);
+  appended_[std::make_pair(build_id, address)] =
+      reinterpret_cast<const RecordHeader*>(record->data());
+  // It's only a cache, so if the write fails the entry is just forgotten
+  // at the end of the session.
+  if (!path_.empty())
+    file_util::AppendToFile(path_, record->data(), record->size());
+}
+
+// static
+base::FilePath SymbolizationCache::GetDefaultPath() {
+  base::FilePath directory = GetCacheDirectory();
+  if (directory.empty())
+    return base::FilePath();
+  return directory.AppendASCII("symbolization.cache");
+}
+
+bool SymbolizationCache::IndexFile(const uint8* data,
+                                   size_t length,
+                                   size_t* valid) {
+  if (length < sizeof(FileHeader) ||
+      memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+  const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+  uint64 index_end = sizeof(FileHeader) +
+                     static_cast<uint64>(header->index_count) *
+                         sizeof(IndexEntry);
+  if (header->version != kVersion ||
+      header->appended_offset < index_end ||
+      header->appended_offset > length ||
+      header->appended_offset % kRecordAlignment != 0) {
+    return false;
+  }
+  data_ = data;
+  index_ = reinterpret_cast<const IndexEntry*>(data + sizeof(FileHeader));
+  index_count_ = header->index_count;
+  appended_offset_ = static_cast<size_t>(header->appended_offset);
+  *valid = appended_offset_ + IndexRecords(data + appended_offset_,
+                                           length - appended_offset_);
+  return true;
+}
+
+size_t SymbolizationCache::IndexRecords(const uint8* data, size_t length) {
+  size_t pos = 0;
+  while (length - pos >= sizeof(RecordHeader)) {
+    const RecordHeader* record =
+        reinterpret_cast<const RecordHeader*>(data + pos);
+    if (!record->IsValid(length - pos))
+      break;
+    // Duplicates happen when two sessions symbolize the same address.
+    std::string build_id(record->build_id(), record->build_id_length);
+    if (!LookupIndex(build_id, record->address)) {
+      appended_.insert(std::make_pair(
+          std::make_pair(build_id, record->address), record));
+    }
+    pos += record->size;
+  }
+  return pos;
+}
+
+void SymbolizationCache::Clear() {
+  data_ = NULL;
+  index_ = NULL;
+  index_count_ = 0;
+  appended_offset_ = 0;
+  appended_.clear();
+  added_.clear();
+}
+
+const SymbolizationCache::RecordHeader* SymbolizationCache::LookupIndex(
+    const std::string& build_id,
+    uint64 address) const {
+  IndexEntry key = {};
+  key.build_id_hash = HashBytes(build_id.data(), build_id.size());
+  key.address = address;
+  for (const IndexEntry* it =
+           std::lower_bound(index_, index_ + index_count_, key);
+       it != index_ + index_count_ && !(key < *it); ++it) {
+    const RecordHeader* record = GetIndexedRecord(it->record_offset);
+    // Different build ids can hash the same.
+    if (record &&
+        record->build_id_length == build_id.size() &&
+        memcmp(record->build_id(), build_id.data(), build_id.size()) == 0) {
+      return record;
+    }
+  }
+  return NULL;
+}
+
+const SymbolizationCache::RecordHeader* SymbolizationCache::GetIndexedRecord(
+    uint64 offset) const {
+  if (offset % kRecordAlignment != 0 ||
+      offset > appended_offset_ ||
+      appended_offset_ - offset < sizeof(RecordHeader)) {
+    return NULL;
+  }
+  const RecordHeader* record =
+      reinterpret_cast<const RecordHeader*>(data_ + offset);
+  return record->IsValid(appended_offset_ - static_cast<size_t>(offset)) ?
+      record : NULL;
+}
+
+bool SymbolizationCache::NeedsCompaction() const {
+  return appended_.size() > std::max(kMinRecordsToCompact, index_count_ / 4);
+}
+
+void SymbolizationCache::Compact(std::string* contents) const {
+  std::vector<std::pair<IndexEntry, const RecordHeader*> > entries;
+  entries.reserve(entry_count());
+  for (size_t i = 0; i < index_count_; ++i) {
+    const RecordHeader* record = GetIndexedRecord(index_[i].record_offset);
+    if (record)
+      entries.push_back(std::make_pair(index_[i], record));
+  }
+  for (AppendedMap::const_iterator it = appended_.begin();
+       it != appended_.end(); ++it) {
+    IndexEntry entry = {};
+    entry.build_id_hash =
+        HashBytes(it->first.first.data(), it->first.first.size());
+    entry.address = it->first.second;
+    entries.push_back(std::make_pair(entry, it->second));
+  }
+  std::sort(entries.begin(), entries.end());
+
+  size_t records_offset =
+      sizeof(FileHeader) + entries.size() * sizeof(IndexEntry);
+  std::string index;
+  std::string records;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    IndexEntry& entry = entries[i].first;
+    const RecordHeader* record = entries[i].second;
+    entry.record_offset = records_offset + records.size();
+    index.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    records.append(reinterpret_cast<const char*>(record), record->size);
+  }
+  FileHeader header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.index_count = static_cast<uint32>(entries.size());
+  header.appended_offset = records_offset + records.size();
+  contents->reserve(static_cast<size_t>(header.appended_offset));
+  contents->assign(reinterpret_cast<const char*>(&header), sizeof(header));
+  *contents += index;
+  *contents += records;
+}
+
+// static
+void SymbolizationCache::Serialize(const std::string& build_id,
+                                   uint64 address,
+                                   const Entry& entry,
+                                   std::string* record) {
+  size_t size = sizeof(RecordHeader) + build_id.size() +
+                entry.function.size() + entry.file.size();
+  size = (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+  RecordHeader header = {};
+  header.size = static_cast<uint32>(size);
+  header.line = entry.line;
+  header.address = address;
+  header.build_id_length = static_cast<uint16>(build_id.size());
+  header.function_length = static_cast<uint16>(entry.function.size());
+  header.file_length = static_cast<uint16>(entry.file.size());
+  record->reserve(size);
+  record->assign(reinterpret_cast<const char*>(&header), sizeof(header));
+  *record += build_id;
+  *record += entry.function;
+  *record += entry.file;
+  record->resize(size);
+}
@@ -0,0 +1,112 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BACKEND_SYMBOLIZATION_CACHE_H_
+#define SG_BACKEND_SYMBOLIZATION_CACHE_H_
+
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
+
+// Remembers what addresses in a binary symbolize to, across sessions, so
+// that debugging the same build again shows symbolized stacks without
+// waiting for the line tables or the debugger to load.
+//
+// Binaries are identified by build id, and addresses are relative to the
+// image (i.e. link-time addresses, or offsets from wherever it was loaded),
+// so entries stay valid for as long as that exact binary exists, however
+// it's relocated. The file starts with an index sorted by build id and
+// address, which lookups binary search in place, so opening it doesn't
+// read the whole thing. New entries are appended after that with one write
+// each, so that several sessions can share it, and are folded into the
+// index by the next Open() once there are enough of them.
+class SymbolizationCache {
+ public:
+  struct Entry {
+    std::string function;
+    // Empty, with |line| 0, if there's no line information.
+    std::string file;
+    int line;
+  };
+
+  SymbolizationCache();
+  ~SymbolizationCache();
+
+  // Maps the cache at |path|, creating it if there isn't one. A record
+  // left partially written by a crash is dropped.
+  bool Open(const base::FilePath& path);
+
+  bool Lookup(const std::string& build_id,
+              uint64 address,
+              Entry* entry) const;
+
+  // Records |entry| in memory and appends it to the file. Does nothing if
+  // there's already an entry for |address|.
+  void Add(const std::string& build_id, uint64 address, const Entry& entry);
+
+  size_t entry_count() const { return index_count_ + appended_.size(); }
+
+  // Where the cache lives by default, in the user's cache directory.
+  static base::FilePath GetDefaultPath();
+
+ private:
+  struct FileHeader;
+  struct IndexEntry;
+  struct RecordHeader;
+
+  typedef std::map<std::pair<std::string, uint64>, const RecordHeader*>
+      AppendedMap;
+
+  // Checks the header of the file in |data|, and indexes the records
+  // appended after its index. Returns false if it's not a cache, otherwise
+  // sets |valid| to how many bytes were.
+  bool IndexFile(const uint8* data, size_t length, size_t* valid);
+  // Parses the appended records in |data|, returning how many bytes were
+  // valid.
+  size_t IndexRecords(const uint8* data, size_t length);
+  void Clear();
+
+  const RecordHeader* LookupIndex(const std::string& build_id,
+                                  uint64 address) const;
+  // The record at |offset| in the indexed part of the file, or NULL if it
+  // doesn't fit there.
+  const RecordHeader* GetIndexedRecord(uint64 offset) const;
+
+  // Whether enough has been appended to be worth rewriting the file.
+  bool NeedsCompaction() const;
+  // Lays out everything in the index and appended since as a new file,
+  // all indexed.
+  void Compact(std::string* contents) const;
+
+  static void Serialize(const std::string& build_id,
+                        uint64 address,
+                        const Entry& entry,
+                        std::string* record);
+
+  base::FilePath path_;
+  std::unique_ptr<base::MemoryMappedFile> file_;
+
+  // Within |file_|. The indexed records are before |appended_offset_|.
+  const uint8* data_;
+  const IndexEntry* index_;
+  size_t index_count_;
+  size_t appended_offset_;
+
+  // Records appended since the index was written, by other sessions and
+  // this one. These are few, as they're compacted into the index.
+  AppendedMap appended_;
+
+  // Records added since the file was mapped.
+  std::list<std::string> added_;
+
+  DISALLOW_COPY_AND_ASSIGN(SymbolizationCache);
+};
+
+#endif  // SG_BACKEND_SYMBOLIZATION_CACHE_H_
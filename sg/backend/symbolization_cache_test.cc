@@ -0,0 +1,161 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "base/file_util.h"
+#include "sg/backend/symbolization_cache.h"
+
+namespace {
+
+const base::FilePath::CharType kCachePath[] =
+    FILE_PATH_LITERAL("out/symbolization_cache_test.cache");
+
+SymbolizationCache::Entry MakeEntry(const std::string& function,
+                                    const std::string& file,
+                                    int line) {
+  SymbolizationCache::Entry entry;
+  entry.function = function;
+  entry.file = file;
+  entry.line = line;
+  return entry;
+}
+
+}  // namespace
+
+TEST(SymbolizationCache, AcrossSessions) {
+  base::FilePath path(kCachePath);
+  file_util::Delete(path, false);
+  {
+    SymbolizationCache cache;
+    ASSERT_TRUE(cache.Open(path));
+    EXPECT_EQ(0, cache.entry_count());
+    cache.Add("abcd", 0x1000, MakeEntry("Function()", "/src/a.cc", 12));
+    cache.Add("abcd", 0x1004, MakeEntry("Function()", "/src/a.cc", 13));
+    cache.Add("1234", 0x1000, MakeEntry("Other(int)", "", 0));
+    // Already there.
+    cache.Add("abcd", 0x1000, MakeEntry("Wrong()", "/src/b.cc", 1));
+    EXPECT_EQ(3, cache.entry_count());
+
+    SymbolizationCache::Entry entry;
+    ASSERT_TRUE(cache.Lookup("abcd", 0x1000, &entry));
+    EXPECT_EQ("Function()", entry.function);
+    EXPECT_EQ(12, entry.line);
+  }
+
+  SymbolizationCache cache;
+  ASSERT_TRUE(cache.Open(path));
+  EXPECT_EQ(3, cache.entry_count());
+  SymbolizationCache::Entry entry;
+  ASSERT_TRUE(cache.Lookup("abcd", 0x1004, &entry));
+  EXPECT_EQ("Function()", entry.function);
+  EXPECT_EQ("/src/a.cc", entry.file);
+  EXPECT_EQ(13, entry.line);
+  ASSERT_TRUE(cache.Lookup("1234", 0x1000, &entry));
+  EXPECT_EQ("Other(int)", entry.function);
+  EXPECT_EQ("", entry.file);
+  EXPECT_EQ(0, entry.line);
+  EXPECT_FALSE(cache.Lookup("abcd", 0x1008, &entry));
+  EXPECT_FALSE(cache.Lookup("abc", 0x1000, &entry));
+
+  // Appending to a mapped cache works too.
+  cache.Add("abcd", 0x1008, MakeEntry("Function()", "/src/a.cc", 14));
+  ASSERT_TRUE(cache.Lookup("abcd", 0x1008, &entry));
+  EXPECT_EQ(14, entry.line);
+  SymbolizationCache reopened;
+  ASSERT_TRUE(reopened.Open(path));
+  EXPECT_EQ(4, reopened.entry_count());
+  file_util::Delete(path, false);
+}
+
+TEST(SymbolizationCache, PartialRecord) {
+  base::FilePath path(kCachePath);
+  file_util::Delete(path, false);
+  {
+    SymbolizationCache cache;
+    ASSERT_TRUE(cache.Open(path));
+    cache.Add("abcd", 0x1000, MakeEntry("Function()", "/src/a.cc", 12));
+  }
+  // As if a session crashed part way through appending.
+  std::string contents;
+  ASSERT_TRUE(file_util::ReadFileToString(path, &contents));
+  contents += contents.substr(16, 20);
+  ASSERT_EQ(static_cast<int>(contents.size()),
+            file_util::WriteFile(path, contents.data(), contents.size()));
+
+  {
+    SymbolizationCache cache;
+    ASSERT_TRUE(cache.Open(path));
+    EXPECT_EQ(1, cache.entry_count());
+    cache.Add("abcd", 0x2000, MakeEntry("Next()", "/src/a.cc", 20));
+  }
+  SymbolizationCache cache;
+  ASSERT_TRUE(cache.Open(path));
+  EXPECT_EQ(2, cache.entry_count());
+  SymbolizationCache::Entry entry;
+  ASSERT_TRUE(cache.Lookup("abcd", 0x2000, &entry));
+  EXPECT_EQ("Next()", entry.function);
+  file_util::Delete(path, false);
+}
+
+TEST(SymbolizationCache, NotACache) {
+  base::FilePath path(kCachePath);
+  ASSERT_EQ(4, file_util::WriteFile(path, "junk", 4));
+  // Started over.
+  SymbolizationCache cache;
+  ASSERT_TRUE(cache.Open(path));
+  EXPECT_EQ(0, cache.entry_count());
+  file_util::Delete(path, false);
+}
+
+TEST(SymbolizationCache, Compaction) {
+  base::FilePath path(kCachePath);
+  file_util::Delete(path, false);
+  const int kCount = 3000;
+  {
+    SymbolizationCache cache;
+    ASSERT_TRUE(cache.Open(path));
+    // Another session, which symbolizes one of the same addresses.
+    SymbolizationCache other;
+    ASSERT_TRUE(other.Open(path));
+    for (int i = 0; i < kCount; ++i)
+      cache.Add("abcd", 0x1000 + i * 4, MakeEntry("F()", "/src/a.cc", i));
+    cache.Add("1234", 0x2000, MakeEntry("G()", "/src/b.cc", 5));
+    other.Add("1234", 0x2000, MakeEntry("G()", "/src/b.cc", 5));
+  }
+  std::string before;
+  ASSERT_TRUE(file_util::ReadFileToString(path, &before));
+
+  // That was enough to be folded into the index when next opened.
+  SymbolizationCache cache;
+  ASSERT_TRUE(cache.Open(path));
+  EXPECT_EQ(kCount + 1, cache.entry_count());
+  std::string after;
+  ASSERT_TRUE(file_util::ReadFileToString(path, &after));
+  EXPECT_NE(before, after);
+  SymbolizationCache::Entry entry;
+  for (int i = 0; i < kCount; ++i) {
+    ASSERT_TRUE(cache.Lookup("abcd", 0x1000 + i * 4, &entry));
+    EXPECT_EQ(i, entry.line);
+  }
+  EXPECT_FALSE(cache.Lookup("abcd", 0x1002, &entry));
+  EXPECT_FALSE(cache.Lookup("1234", 0x1000, &entry));
+  ASSERT_TRUE(cache.Lookup("1234", 0x2000, &entry));
+  EXPECT_EQ("G()", entry.function);
+
+  // Added after the index.
+  cache.Add("1234", 0x2004, MakeEntry("G()", "/src/b.cc", 6));
+  cache.Add("abcd", 0x1000, MakeEntry("Wrong()", "/src/b.cc", 1));
+  EXPECT_EQ(kCount + 2, cache.entry_count());
+  SymbolizationCache reopened;
+  ASSERT_TRUE(reopened.Open(path));
+  EXPECT_EQ(kCount + 2, reopened.entry_count());
+  ASSERT_TRUE(reopened.Lookup("1234", 0x2004, &entry));
+  EXPECT_EQ(6, entry.line);
+  ASSERT_TRUE(reopened.Lookup("abcd", 0x1000, &entry));
+  EXPECT_EQ("F()", entry.function);
+  file_util::Delete(path, false);
+}
@@ -0,0 +1,177 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/breakpoint_list.h"
+
+#include <algorithm>
+
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "base/strings/string_split.h"
+#include "base/utf_string_conversions.h"
+
+namespace {
+
+class FileAndLineLess {
+ public:
+  bool operator()(const BreakpointData& a,
+                  const std::pair<string16, int>& b) const {
+    if (a.filename != b.first)
+      return a.filename < b.first;
+    return a.line_number < b.second;
+  }
+};
+
+}  // namespace
+
+BreakpointList::BreakpointList() : next_id_(1) {
+}
+
+BreakpointList::~BreakpointList() {
+}
+
+int BreakpointList::Add(const string16& filename,
+                        int line_number,
+                        bool enabled) {
+  size_t index = LowerBound(filename, line_number);
+  if (index < breakpoints_.size() &&
+      breakpoints_[index].filename == filename &&
+      breakpoints_[index].line_number == line_number) {
+    return 0;
+  }
+  BreakpointData breakpoint;
+  breakpoint.id = next_id_++;
+  breakpoint.filename = filename;
+  breakpoint.line_number = line_number;
+  breakpoint.enabled = enabled;
+  breakpoints_.insert(breakpoints_.begin() + index, breakpoint);
+  return breakpoint.id;
+}
+
+bool BreakpointList::Toggle(const string16& filename, int line_number) {
+  const BreakpointData* existing = Find(filename, line_number);
+  if (existing) {
+    Remove(existing->id);
+    return false;
+  }
+  Add(filename, line_number, true);
+  return true;
+}
+
+bool BreakpointList::Remove(int id) {
+  int index = IndexOf(id);
+  if (index < 0)
+    return false;
+  breakpoints_.erase(breakpoints_.begin() + index);
+  return true;
+}
+
+bool BreakpointList::SetEnabled(int id, bool enabled) {
+  int index = IndexOf(id);
+  if (index < 0)
+    return false;
+  breakpoints_[index].enabled = enabled;
+  return true;
+}
+
+void BreakpointList::Clear() {
+  breakpoints_.clear();
+}
+
+int BreakpointList::IndexOf(int id) const {
+  for (size_t i = 0; i < breakpoints_.size(); ++i) {
+    if (breakpoints_[i].id == id)
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+const BreakpointData* BreakpointList::Find(const string16& filename,
+                                           int line_number) const {
+  size_t index = LowerBound(filename, line_number);
+  if (index < breakpoints_.size() &&
+      breakpoints_[index].filename == filename &&
+      breakpoints_[index].line_number == line_number) {
+    return &breakpoints_[index];
+  }
+  return NULL;
+}
+
+void BreakpointList::FindInRange(const string16& filename,
+                                 int first_line,
+                                 int last_line,
+                                 size_t* begin,
+                                 size_t* end) const {
+  *begin = LowerBound(filename, first_line);
+  *end = last_line < first_line ? *begin
+                                : LowerBound(filename, last_line + 1);
+}
+
+bool BreakpointList::TakeChanges(BreakpointChangesData* changes) {
+  BreakpointChangesData result;
+  std::map<int, bool> current;
+  for (size_t i = 0; i < breakpoints_.size(); ++i) {
+    const BreakpointData& breakpoint = breakpoints_[i];
+    current[breakpoint.id] = breakpoint.enabled;
+    std::map<int, bool>::const_iterator it = synced_.find(breakpoint.id);
+    if (it == synced_.end())
+      result.inserted.push_back(breakpoint);
+    else if (!it->second && breakpoint.enabled)
+      result.enabled.push_back(breakpoint.id);
+    else if (it->second && !breakpoint.enabled)
+      result.disabled.push_back(breakpoint.id);
+  }
+  for (std::map<int, bool>::const_iterator it = synced_.begin();
+       it != synced_.end(); ++it) {
+    if (current.find(it->first) == current.end())
+      result.deleted.push_back(it->first);
+  }
+  synced_.swap(current);
+  if (result.inserted.empty() && result.deleted.empty() &&
+      result.enabled.empty() && result.disabled.empty()) {
+    return false;
+  }
+  std::swap(*changes, result);
+  return true;
+}
+
+void BreakpointList::ForgetSynced(int id) {
+  synced_.erase(id);
+}
+
+size_t BreakpointList::LowerBound(const string16& filename,
+                                  int line_number) const {
+  return std::lower_bound(breakpoints_.begin(),
+                          breakpoints_.end(),
+                          std::make_pair(filename, line_number),
+                          FileAndLineLess()) -
+         breakpoints_.begin();
+}
+
+bool ParseBreakpointFile(const std::string& utf8_text,
+                         std::vector<std::pair<string16, int> >* locations,
+                         string16* error) {
+  std::vector<string16> lines;
+  base::SplitString(UTF8ToUTF16(utf8_text), L'\n', &lines);
+  std::vector<std::pair<string16, int> > result;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    string16 line;
+    TrimWhitespace(lines[i], TRIM_ALL, &line);
+    if (line.empty() || line[0] == L'#')
+      continue;
+    // The last colon, as Windows paths have one too.
+    size_t colon = line.rfind(L':');
+    int line_number;
+    if (colon == string16::npos || colon == 0 ||
+        !base::StringToInt(line.substr(colon + 1), &line_number) ||
+        line_number <= 0) {
+      *error = L"line " + base::SizeTToString16(i + 1) +
+               L": expected file:line";
+      return false;
+    }
+    result.push_back(std::make_pair(line.substr(0, colon), line_number));
+  }
+  locations->swap(result);
+  return true;
+}
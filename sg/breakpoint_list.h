@@ -0,0 +1,81 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BREAKPOINT_LIST_H_
+#define SG_BREAKPOINT_LIST_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
+#include "sg/basex/string16.h"
+
+// Model for the user's breakpoints, which may number in the hundreds or
+// thousands. They're kept sorted by file and line, so each file's are
+// together and the source view can find those on the lines it shows in
+// O(log n). The model also tracks what the debugger has, so that each edit,
+// or a whole file of them, goes to it as one batch of differences.
+class BreakpointList {
+ public:
+  BreakpointList();
+  ~BreakpointList();
+
+  // Returns the new breakpoint's id, or 0 if there's already one there.
+  int Add(const string16& filename, int line_number, bool enabled);
+  // Removes the breakpoint at |filename|:|line_number| if there is one,
+  // otherwise adds one. Returns whether there's one there now.
+  bool Toggle(const string16& filename, int line_number);
+  // Returns false if there's no breakpoint |id|.
+  bool Remove(int id);
+  bool SetEnabled(int id, bool enabled);
+  void Clear();
+
+  size_t size() const { return breakpoints_.size(); }
+  const BreakpointData& at(size_t i) const { return breakpoints_[i]; }
+
+  // Returns -1 if there's no breakpoint |id|.
+  int IndexOf(int id) const;
+
+  // Returns NULL if there's no breakpoint there.
+  const BreakpointData* Find(const string16& filename, int line_number) const;
+
+  // The breakpoints in |filename| from |first_line| to |last_line|
+  // inclusive, in line order, as indices [*begin, *end).
+  void FindInRange(const string16& filename,
+                   int first_line,
+                   int last_line,
+                   size_t* begin,
+                   size_t* end) const;
+
+  // Fills |changes| with what's changed since the last call, which the
+  // debugger needs to be told about, and returns false if nothing has.
+  // Breakpoints that were added and removed in between aren't mentioned.
+  bool TakeChanges(BreakpointChangesData* changes);
+
+  // For a breakpoint the debugger couldn't insert, so that it isn't told to
+  // delete it either.
+  void ForgetSynced(int id);
+
+ private:
+  // Index of the first breakpoint at or after |filename|:|line_number|.
+  size_t LowerBound(const string16& filename, int line_number) const;
+
+  std::vector<BreakpointData> breakpoints_;
+  // Ids of what the debugger has, and whether they're enabled there.
+  std::map<int, bool> synced_;
+  int next_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(BreakpointList);
+};
+
+// One file:line per line, ignoring blank lines and those starting with #.
+// On failure, |error| says which line is wrong.
+bool ParseBreakpointFile(const std::string& utf8_text,
+                         std::vector<std::pair<string16, int> >* locations,
+                         string16* error);
+
+#endif  // SG_BREAKPOINT_LIST_H_
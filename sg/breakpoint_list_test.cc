@@ -0,0 +1,120 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/breakpoint_list.h"
+
+#include <gtest/gtest.h>
+
+TEST(BreakpointList, SortedLookup) {
+  BreakpointList breakpoints;
+  int b20 = breakpoints.Add(L"b.cc", 20, true);
+  int a5 = breakpoints.Add(L"a.cc", 5, true);
+  int b3 = breakpoints.Add(L"b.cc", 3, false);
+  EXPECT_NE(0, b20);
+  EXPECT_EQ(0, breakpoints.Add(L"b.cc", 20, false));
+  ASSERT_EQ(3, breakpoints.size());
+  EXPECT_EQ(a5, breakpoints.at(0).id);
+  EXPECT_EQ(b3, breakpoints.at(1).id);
+  EXPECT_EQ(b20, breakpoints.at(2).id);
+  EXPECT_EQ(2, breakpoints.IndexOf(b20));
+  EXPECT_EQ(-1, breakpoints.IndexOf(100));
+
+  ASSERT_TRUE(breakpoints.Find(L"b.cc", 3));
+  EXPECT_FALSE(breakpoints.Find(L"b.cc", 3)->enabled);
+  EXPECT_FALSE(breakpoints.Find(L"b.cc", 4));
+  EXPECT_FALSE(breakpoints.Find(L"c.cc", 3));
+
+  size_t begin, end;
+  breakpoints.FindInRange(L"b.cc", 1, 100, &begin, &end);
+  EXPECT_EQ(1, begin);
+  EXPECT_EQ(3, end);
+  breakpoints.FindInRange(L"b.cc", 3, 19, &begin, &end);
+  EXPECT_EQ(1, begin);
+  EXPECT_EQ(2, end);
+  breakpoints.FindInRange(L"a.cc", 6, 100, &begin, &end);
+  EXPECT_EQ(begin, end);
+  breakpoints.FindInRange(L"c.cc", 1, 100, &begin, &end);
+  EXPECT_EQ(begin, end);
+
+  EXPECT_FALSE(breakpoints.Toggle(L"a.cc", 5));
+  EXPECT_FALSE(breakpoints.Find(L"a.cc", 5));
+  EXPECT_TRUE(breakpoints.Toggle(L"a.cc", 5));
+  EXPECT_TRUE(breakpoints.Find(L"a.cc", 5));
+  EXPECT_NE(a5, breakpoints.Find(L"a.cc", 5)->id);
+}
+
+TEST(BreakpointList, Changes) {
+  BreakpointList breakpoints;
+  BreakpointChangesData changes;
+  EXPECT_FALSE(breakpoints.TakeChanges(&changes));
+
+  for (int i = 1; i <= 500; ++i)
+    breakpoints.Add(L"log.cc", i, true);
+  int disabled = breakpoints.Add(L"other.cc", 1, false);
+  ASSERT_TRUE(breakpoints.TakeChanges(&changes));
+  EXPECT_EQ(501, changes.inserted.size());
+  EXPECT_FALSE(changes.inserted[500].enabled);
+  EXPECT_EQ(0, changes.deleted.size());
+  EXPECT_FALSE(breakpoints.TakeChanges(&changes));
+
+  // Only the differences.
+  int first = breakpoints.at(0).id;
+  int second = breakpoints.at(1).id;
+  breakpoints.Remove(first);
+  breakpoints.SetEnabled(second, false);
+  breakpoints.SetEnabled(disabled, true);
+  int added = breakpoints.Add(L"new.cc", 7, true);
+  // Added and gone again before the debugger hears about it.
+  breakpoints.Toggle(L"new.cc", 8);
+  breakpoints.Toggle(L"new.cc", 8);
+  ASSERT_TRUE(breakpoints.TakeChanges(&changes));
+  ASSERT_EQ(1, changes.inserted.size());
+  EXPECT_EQ(added, changes.inserted[0].id);
+  EXPECT_EQ(L"new.cc", changes.inserted[0].filename);
+  EXPECT_EQ(7, changes.inserted[0].line_number);
+  ASSERT_EQ(1, changes.deleted.size());
+  EXPECT_EQ(first, changes.deleted[0]);
+  ASSERT_EQ(1, changes.enabled.size());
+  EXPECT_EQ(disabled, changes.enabled[0]);
+  ASSERT_EQ(1, changes.disabled.size());
+  EXPECT_EQ(second, changes.disabled[0]);
+
+  // Toggling back and forth in between is no change.
+  breakpoints.SetEnabled(second, true);
+  breakpoints.SetEnabled(second, false);
+  EXPECT_FALSE(breakpoints.TakeChanges(&changes));
+
+  // One the debugger couldn't insert is removed without telling it.
+  breakpoints.ForgetSynced(second);
+  EXPECT_TRUE(breakpoints.Remove(second));
+  EXPECT_FALSE(breakpoints.TakeChanges(&changes));
+  // Anything else it's forgotten is inserted again.
+  breakpoints.ForgetSynced(disabled);
+  ASSERT_TRUE(breakpoints.TakeChanges(&changes));
+  ASSERT_EQ(1, changes.inserted.size());
+  EXPECT_EQ(disabled, changes.inserted[0].id);
+  EXPECT_EQ(0, changes.deleted.size());
+}
+
+TEST(BreakpointList, ParseFile) {
+  std::vector<std::pair<string16, int> > locations;
+  string16 error;
+  ASSERT_TRUE(ParseBreakpointFile(
+      "# From grep -n LOG(FATAL).\n"
+      "\n"
+      "base/logging.cc:123\r\n"
+      "  C:/src/foo.cc:7\n",
+      &locations, &error));
+  ASSERT_EQ(2, locations.size());
+  EXPECT_EQ(L"base/logging.cc", locations[0].first);
+  EXPECT_EQ(123, locations[0].second);
+  EXPECT_EQ(L"C:/src/foo.cc", locations[1].first);
+  EXPECT_EQ(7, locations[1].second);
+
+  EXPECT_FALSE(ParseBreakpointFile("a.cc:1\nb.cc\n", &locations, &error));
+  EXPECT_EQ(L"line 2: expected file:line", error);
+  EXPECT_FALSE(ParseBreakpointFile("a.cc:0\n", &locations, &error));
+  EXPECT_FALSE(ParseBreakpointFile(":3\n", &locations, &error));
+  EXPECT_EQ(2, locations.size());
+}
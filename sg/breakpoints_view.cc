@@ -0,0 +1,183 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/breakpoints_view.h"
+
+#include <algorithm>
+
+#include "sg/breakpoint_list.h"
+#include "sg/debug_presenter_notify.h"
+#include "sg/display_util.h"
+#include "sg/render/renderer.h"
+#include "sg/render/texture.h"
+#include "sg/ui/skin.h"
+
+namespace {
+
+const int kHeaderPadding = 3;
+const int kFromSidePadding = 3;
+const int kLeftMargin = 5;
+const int kRightMargin = 5;
+
+// Disabled breakpoints are drawn faded.
+const double kDisabledAlpha = .3;
+
+}  // namespace
+
+BreakpointsView::BreakpointsView()
+    : breakpoints_(NULL),
+      debug_presenter_notify_(NULL),
+      selected_(-1),
+      scroll_helper_(this, Skin::current().text_line_height()) {
+}
+
+BreakpointsView::~BreakpointsView() {
+}
+
+void BreakpointsView::SetBreakpoints(const BreakpointList* breakpoints) {
+  breakpoints_ = breakpoints;
+  BreakpointsChanged();
+}
+
+void BreakpointsView::BreakpointsChanged() {
+  selected_ = std::min(selected_, static_cast<int>(GetRowCount()) - 1);
+  Invalidate();
+}
+
+void BreakpointsView::SetDebugPresenterNotify(
+    DebugPresenterNotify* debug_presenter) {
+  debug_presenter_notify_ = debug_presenter;
+}
+
+void BreakpointsView::Render(Renderer* renderer) {
+  const Skin& skin = Skin::current();
+
+  if (scroll_helper_.Update())
+    Invalidate();
+
+  renderer->SetDrawColor(skin.GetColorScheme().background());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), Height()));
+
+  int line_height = skin.text_line_height();
+  int indicator_size = line_height;
+  int full_margin_width = kLeftMargin + indicator_size + kRightMargin;
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, full_margin_width, Height()));
+
+  int header_height = GetHeaderHeight();
+  int y_pixel_scroll = scroll_helper_.GetOffset();
+
+  // Only the rows in view, however many breakpoints there are.
+  int first_row = y_pixel_scroll / line_height;
+  int last_row = std::min(
+      static_cast<int>(GetRowCount()),
+      first_row + (Height() - header_height) / line_height + 2);
+  for (int i = first_row; i < last_row; ++i) {
+    const BreakpointData& breakpoint = breakpoints_->at(i);
+    int y = header_height + i * line_height - y_pixel_scroll;
+    if (i == selected_) {
+      renderer->SetDrawColor(skin.GetColorScheme().border());
+      renderer->DrawFilledRect(
+          Rect(full_margin_width, y, Width() - full_margin_width,
+               line_height));
+    }
+    renderer->DrawTexturedRectAlpha(
+        skin.breakpoint_texture(),
+        Rect(kLeftMargin, y, indicator_size, indicator_size),
+        breakpoint.enabled ? 1. : kDisabledAlpha,
+        0, 0, 1, 1);
+    renderer->SetDrawColor(breakpoint.enabled
+                               ? skin.GetColorScheme().text()
+                               : skin.GetColorScheme().margin_text());
+    renderer->RenderText(
+        skin.ui_font(),
+        Point(full_margin_width + kFromSidePadding, y),
+        ToPlatformFileAndLine(breakpoint.filename, breakpoint.line_number));
+  }
+
+  // Drawn last, so that it covers any partially scrolled out row.
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), header_height));
+  renderer->SetDrawColor(skin.GetColorScheme().border());
+  renderer->DrawHorizontalLine(0, 0, Width());
+  renderer->DrawFilledRect(Rect(0, header_height - 1, Width(), 1));
+  renderer->SetDrawColor(skin.GetColorScheme().margin_text());
+  renderer->RenderText(
+      skin.ui_font(),
+      Point(full_margin_width + kFromSidePadding, kHeaderPadding),
+      L"Location");
+
+  scroll_helper_.RenderScrollIndicators(renderer, skin);
+}
+
+bool BreakpointsView::NotifyMouseMoved(
+    int x, int y, int dx, int dy, const InputModifiers& modifiers) {
+  mouse_position_ = Point(x, y);
+  return false;
+}
+
+bool BreakpointsView::NotifyMouseWheel(
+    int delta, const InputModifiers& modifiers) {
+  bool invalidate, handled;
+  scroll_helper_.CommonMouseWheel(delta, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+bool BreakpointsView::NotifyMouseButton(
+    int index, bool down, const InputModifiers& modifiers) {
+  if (index != 0 || !down)
+    return false;
+  int y = mouse_position_.y - Y() - GetHeaderHeight();
+  if (y < 0)
+    return false;
+  int row = (y + scroll_helper_.GetOffset()) /
+            Skin::current().text_line_height();
+  if (row >= static_cast<int>(GetRowCount()))
+    return false;
+  selected_ = row;
+  Invalidate();
+  return true;
+}
+
+bool BreakpointsView::NotifyKey(
+    InputKey key, bool down, const InputModifiers& modifiers) {
+  int row_count = static_cast<int>(GetRowCount());
+  if (down && (key == kUp || key == kDown) && row_count > 0) {
+    selected_ = key == kUp ? std::max(selected_ - 1, 0)
+                           : std::min(selected_ + 1, row_count - 1);
+    Invalidate();
+    return true;
+  }
+  if (down && selected_ >= 0 && key == kSpace) {
+    const BreakpointData& breakpoint = breakpoints_->at(selected_);
+    debug_presenter_notify_->NotifyBreakpointEnabledChanged(
+        breakpoint.id, !breakpoint.enabled);
+    return true;
+  }
+  if (down && selected_ >= 0 && key == kDelete) {
+    debug_presenter_notify_->NotifyBreakpointRemoved(
+        breakpoints_->at(selected_).id);
+    return true;
+  }
+  bool invalidate, handled;
+  scroll_helper_.CommonNotifyKey(key, down, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+int BreakpointsView::GetContentSize() {
+  return GetHeaderHeight() +
+         Skin::current().text_line_height() * GetRowCount();
+}
+
+int BreakpointsView::GetHeaderHeight() const {
+  return Skin::current().text_line_height() + kHeaderPadding * 2;
+}
+
+size_t BreakpointsView::GetRowCount() const {
+  return breakpoints_ ? breakpoints_->size() : 0;
+}
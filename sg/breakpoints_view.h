@@ -0,0 +1,64 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_BREAKPOINTS_VIEW_H_
+#define SG_BREAKPOINTS_VIEW_H_
+
+#include "sg/basex/compiler_specific.h"
+#include "sg/basex/string16.h"
+#include "sg/ui/dockable.h"
+#include "sg/ui/scroll_helper.h"
+
+class BreakpointList;
+class DebugPresenterNotify;
+
+// Lists the breakpoints, by file and line. Rows are only drawn when they're
+// scrolled into view, so it's fine with thousands. Up and Down select,
+// Space enables or disables the selected one, and Delete removes it.
+class BreakpointsView : public Dockable, public ScrollHelperDataProvider {
+ public:
+  BreakpointsView();
+  virtual ~BreakpointsView();
+
+  virtual void Render(Renderer* renderer) OVERRIDE;
+
+  // |breakpoints| is owned by the presenter, which calls
+  // BreakpointsChanged() whenever it's modified.
+  virtual void SetBreakpoints(const BreakpointList* breakpoints);
+  virtual void BreakpointsChanged();
+  virtual void SetDebugPresenterNotify(DebugPresenterNotify* debug_presenter);
+
+  // Implementation of InputHandler:
+  virtual bool NotifyMouseMoved(
+      int x, int y, int dx, int dy, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyMouseWheel(
+      int delta, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyMouseButton(
+      int index, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyKey(
+      InputKey key, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool WantMouseEvents() OVERRIDE { return true; }
+  virtual bool WantKeyEvents() OVERRIDE { return true; }
+
+  // Implementation of ScrollHelperDataProvider:
+  virtual int GetContentSize() OVERRIDE;
+  virtual const Rect& GetScreenRect() const OVERRIDE {
+    return Dockable::GetScreenRect();
+  }
+
+ private:
+  int GetHeaderHeight() const;
+  size_t GetRowCount() const;
+
+  const BreakpointList* breakpoints_;
+  DebugPresenterNotify* debug_presenter_notify_;
+  // Row index, or -1 if nothing's selected.
+  int selected_;
+  Point mouse_position_;
+  ScrollHelper scroll_helper_;
+
+  DISALLOW_COPY_AND_ASSIGN(BreakpointsView);
+};
+
+#endif  // SG_BREAKPOINTS_VIEW_H_
@@ -0,0 +1,94 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/cache_util.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "base/environment.h"
+#include "base/file_util.h"
+#include "base/time.h"
+
+namespace {
+
+struct CacheFile {
+  base::FilePath path;
+  int64 size;
+  base::Time last_modified;
+};
+
+bool WrittenBefore(const CacheFile& a, const CacheFile& b) {
+  return a.last_modified < b.last_modified;
+}
+
+}  // namespace
+
+base::FilePath GetCacheDirectory() {
+  std::unique_ptr<base::Environment> environment(base::Environment::Create());
+  std::string directory;
+#if defined(OS_WIN)
+  if (!environment->GetVar("LOCALAPPDATA", &directory) || directory.empty())
+    return base::FilePath();
+  return base::FilePath::FromUTF8Unsafe(directory).AppendASCII("Seaborgium");
+#else
+  if (!environment->GetVar("XDG_CACHE_HOME", &directory) ||
+      directory.empty()) {
+    if (!environment->GetVar("HOME", &directory) || directory.empty())
+      return base::FilePath();
+    directory += "/.cache";
+  }
+  return base::FilePath::FromUTF8Unsafe(directory).AppendASCII("seaborgium");
+#endif
+}
+
+bool WriteFileAtomically(const base::FilePath& path,
+                         const std::string& data) {
+  base::FilePath temp(path.value() + FILE_PATH_LITERAL(".tmp"));
+  if (file_util::WriteFile(temp, data.data(), data.size()) !=
+      static_cast<int>(data.size())) {
+    file_util::Delete(temp, false);
+    return false;
+  }
+  return file_util::Move(temp, path);
+}
+
+uint64 HashBytes(const char* data, size_t length) {
+  uint64 hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void TrimCacheDirectory(const base::FilePath& directory,
+                        const base::FilePath::StringType& pattern,
+                        int64 max_bytes) {
+  std::vector<CacheFile> files;
+  int64 total = 0;
+  file_util::FileEnumerator enumerator(
+      directory, false, file_util::FileEnumerator::FILES, pattern);
+  for (base::FilePath path = enumerator.Next(); !path.empty();
+       path = enumerator.Next()) {
+    file_util::FileEnumerator::FindInfo info;
+    enumerator.GetFindInfo(&info);
+    CacheFile file;
+    file.path = path;
+    file.size = file_util::FileEnumerator::GetFilesize(info);
+    file.last_modified = file_util::FileEnumerator::GetLastModifiedTime(info);
+    total += file.size;
+    files.push_back(file);
+  }
+  if (total <= max_bytes)
+    return;
+  std::sort(files.begin(), files.end(), WrittenBefore);
+  for (size_t i = 0; i < files.size() && total > max_bytes; ++i) {
+    // On Windows, one that another session has open can't be deleted, so
+    // it's left for next time.
+    if (file_util::Delete(files[i].path, false))
+      total -= files[i].size;
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_CACHE_UTIL_H_
+#define SG_CACHE_UTIL_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+
+// Helpers for the caches that are kept from one session to the next, and
+// shared between sessions running at once.
+
+// Where they're kept: %LOCALAPPDATA%\Seaborgium on Windows, and
+// $XDG_CACHE_HOME/seaborgium (~/.cache/seaborgium by default) elsewhere.
+// Empty if the environment doesn't say.
+base::FilePath GetCacheDirectory();
+
+// Writes |data| to a temporary name, then moves it over |path|, so that
+// another session reading |path| never sees it partially written.
+bool WriteFileAtomically(const base::FilePath& path, const std::string& data);
+
+// FNV-1a, which is the same from one build to the next, for keys that are
+// saved.
+uint64 HashBytes(const char* data, size_t length);
+
+// Deletes the files in |directory| whose names match |pattern|, the least
+// recently written first, until the rest total no more than |max_bytes|.
+void TrimCacheDirectory(const base::FilePath& directory,
+                        const base::FilePath::StringType& pattern,
+                        int64 max_bytes);
+
+#endif  // SG_CACHE_UTIL_H_
@@ -0,0 +1,77 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/cache_util.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "base/file_util.h"
+#include "base/time.h"
+
+namespace {
+
+const base::FilePath::CharType kCacheDirectory[] =
+    FILE_PATH_LITERAL("out/cache_util_test");
+
+// Writes |size| bytes to |name| in |directory|, as though |age_hours| ago.
+base::FilePath WriteCacheFile(const base::FilePath& directory,
+                              const char* name,
+                              size_t size,
+                              int age_hours) {
+  base::FilePath path = directory.AppendASCII(name);
+  std::string data(size, 'x');
+  EXPECT_TRUE(WriteFileAtomically(path, data));
+  base::Time written =
+      base::Time::Now() - base::TimeDelta::FromHours(age_hours);
+  EXPECT_TRUE(file_util::TouchFile(path, written, written));
+  return path;
+}
+
+}  // namespace
+
+TEST(CacheUtil, WriteFileAtomically) {
+  base::FilePath directory(kCacheDirectory);
+  file_util::Delete(directory, true);
+  ASSERT_TRUE(file_util::CreateDirectory(directory));
+  base::FilePath path = directory.AppendASCII("a.cache");
+  ASSERT_TRUE(WriteFileAtomically(path, "first"));
+  ASSERT_TRUE(WriteFileAtomically(path, "second"));
+  std::string contents;
+  ASSERT_TRUE(file_util::ReadFileToString(path, &contents));
+  EXPECT_EQ("second", contents);
+  EXPECT_FALSE(file_util::PathExists(
+      base::FilePath(path.value() + FILE_PATH_LITERAL(".tmp"))));
+  file_util::Delete(directory, true);
+}
+
+TEST(CacheUtil, HashBytes) {
+  // The FNV-1a test vectors.
+  EXPECT_EQ(14695981039346656037ULL, HashBytes("", 0));
+  EXPECT_EQ(0xaf63dc4c8601ec8cULL, HashBytes("a", 1));
+  EXPECT_EQ(0x85944171f73967e8ULL, HashBytes("foobar", 6));
+}
+
+TEST(CacheUtil, TrimCacheDirectory) {
+  base::FilePath directory(kCacheDirectory);
+  file_util::Delete(directory, true);
+  ASSERT_TRUE(file_util::CreateDirectory(directory));
+  base::FilePath oldest = WriteCacheFile(directory, "1.cache", 100, 3);
+  base::FilePath older = WriteCacheFile(directory, "2.cache", 100, 2);
+  base::FilePath newest = WriteCacheFile(directory, "3.cache", 100, 1);
+  base::FilePath other = WriteCacheFile(directory, "other", 1000, 4);
+
+  // Nothing's deleted while they fit.
+  TrimCacheDirectory(directory, FILE_PATH_LITERAL("*.cache"), 300);
+  EXPECT_TRUE(file_util::PathExists(oldest));
+
+  // Then the least recently written go first, and only those that match.
+  TrimCacheDirectory(directory, FILE_PATH_LITERAL("*.cache"), 150);
+  EXPECT_FALSE(file_util::PathExists(oldest));
+  EXPECT_FALSE(file_util::PathExists(older));
+  EXPECT_TRUE(file_util::PathExists(newest));
+  EXPECT_TRUE(file_util::PathExists(other));
+  file_util::Delete(directory, true);
+}
@@ -5,10 +5,44 @@
 // Originally generated by generate_cpp_lexer_data.py, but hand-modified
 // to be slightly worse, but work with RE2's regex style.
 
+#include "sg/cpp_lexer.h"
+
+#include <memory>
+
+#include "base/lazy_instance.h"
 #include "sg/lexer.h"
 #include "sg/lexer_state.h"
+#include "sg/lexer_table.h"
+
+// Generated from this file at build time, by generate_lexer_tables.py.
+extern const LexerTable kCppLexerTables[];
+extern const size_t kCppLexerTableCount;
+
+namespace {
+
+struct SharedCppLexer {
+  SharedCppLexer() : lexer(MakeCppLexer()) {}
+
+  std::unique_ptr<const Lexer> lexer;
+};
+
+// Created on first use by whichever thread gets there first.
+base::LazyInstance<SharedCppLexer>::Leaky g_cpp_lexer =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
 
 Lexer* MakeCppLexer() {
+  Lexer* lexer = MakeCppLexerWithoutTables();
+  lexer->SetTables(kCppLexerTables, kCppLexerTableCount);
+  return lexer;
+}
+
+const Lexer* GetCppLexer() {
+  return g_cpp_lexer.Get().lexer.get();
+}
+
+Lexer* MakeCppLexerWithoutTables() {
   Lexer* lexer = new Lexer("C++");
 
   // States
@@ -5,7 +5,23 @@
 #ifndef SG_CPP_LEXER_H_
 #define SG_CPP_LEXER_H_
 
+#include "base/basictypes.h"
+
 class Lexer;
 Lexer* MakeCppLexer();
 
+// A hash of the token definitions, generated along with the tables, so that
+// colors saved by a lexer with other rules (see highlight_cache.h) aren't
+// used.
+extern const uint32 kCppLexerVersion;
+
+// A C++ lexer made the first time it's needed, and shared from then on
+// rather than compiling all the regexes again each time. It's never
+// changed, so can be used on any thread, or several at once.
+const Lexer* GetCppLexer();
+
+// The same lexer, matching its regexes with RE2 rather than the generated
+// tables. For checking that they agree.
+Lexer* MakeCppLexerWithoutTables();
+
 #endif  // SG_CPP_LEXER_H_
@@ -9,12 +9,59 @@
 
 #include "base/bind.h"
 #include "base/command_line.h"
+#include "base/file_util.h"
+#include "base/logging.h"
 #include "base/string_number_conversions.h"
 #include "base/string_util.h"
 #include "sg/app_thread.h"
+#include "sg/backend/backtrace_snapshot.h"
 #include "sg/backend/debug_core_gdb.h"
+#include "sg/backend/sample_profile.h"
 #include "sg/debug_presenter_display.h"
+#include "sg/display_util.h"
 #include "sg/source_files.h"
+#include "sg/tracepoint_log.h"
+
+namespace {
+
+// "All threads" snapshots are exported next to the binary, overwriting the
+// last one.
+const base::FilePath::CharType kBacktraceSnapshotName[] =
+    FILE_PATH_LITERAL("backtrace_snapshot.txt");
+
+// Makes |path| absolute, so that it can be reported exactly, or clears it
+// if it couldn't be written.
+void WriteBacktraceSnapshotOnFILE(const std::string& text,
+                                  base::FilePath* path) {
+  if (!file_util::AbsolutePath(path) ||
+      file_util::WriteFile(*path, text.data(), text.size()) !=
+          static_cast<int>(text.size())) {
+    *path = base::FilePath();
+  }
+}
+
+// Where the last profile is exported, likewise.
+const base::FilePath::CharType kProfilePath[] =
+    FILE_PATH_LITERAL("profile.txt");
+
+// Often enough for a useful profile in a few seconds, without slowing the
+// target down too much when each sample is a trip through gdb. Can be
+// changed with --profile-rate.
+const int kDefaultProfileSamplesPerSecond = 100;
+
+// Steps taken by C-F10 and C-F11, or the most taken looking for
+// --step-until to be true. Can be changed with --step-count.
+const int kDefaultStepLoopCount = 1000;
+
+void WriteProfileOnFILE(const std::string& text) {
+  file_util::WriteFile(base::FilePath(kProfilePath), text.data(), text.size());
+}
+
+void ReadSwitchFileOnFILE(const base::FilePath& path, std::string* result) {
+  file_util::ReadFileToString(path, result);
+}
+
+}  // namespace
 
 // TODO(scottmg): Maintaining running_ here is probably wrong and going to
 // cause pain. It should be semi-async updated from the backend somehow.
@@ -22,8 +69,28 @@
 DebugPresenter::DebugPresenter(SourceFiles* source_files)
     : source_files_(source_files),
       variable_counter_(0),
-      running_(false) {
+      passive_update_id_(0),
+      creating_watches_(false),
+      running_(false),
+      profiling_(false),
+      profile_samples_per_second_(kDefaultProfileSamplesPerSecond),
+      step_looping_(false),
+      step_loop_count_(kDefaultStepLoopCount) {
   const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  int rate;
+  if (base::StringToInt(command_line.GetSwitchValueASCII("profile-rate"),
+                        &rate) &&
+      rate > 0) {
+    profile_samples_per_second_ = rate;
+  }
+  int count;
+  if (base::StringToInt(command_line.GetSwitchValueASCII("step-count"),
+                        &count) &&
+      count > 0) {
+    step_loop_count_ = count;
+  }
+  step_loop_condition_ = command_line.GetSwitchValueNative("step-until");
+  core_path_ = command_line.GetSwitchValueNative("core");
   // TODO(scottmg): Temporary obviously.
   if (command_line.GetArgs().size() != 1)
     binary_ = L"test_data/test_binary_mingw.exe";
@@ -36,6 +103,7 @@ DebugPresenter::~DebugPresenter() {
 
 void DebugPresenter::SetDisplay(DebugPresenterDisplay* display) {
   display_ = display;
+  display_->SetBreakpoints(&breakpoints_);
   if (!running_)
     display_->SetFileData("\n"
                           "Binary from command line (or sample) loaded.\n"
@@ -45,14 +113,28 @@ void DebugPresenter::SetDisplay(DebugPresenterDisplay* display) {
                           "F10: step over (and run to main() on startup)\n"
                           "F11: step in\n"
                           "S-F11: step out\n"
-                          // "F9: add/remove breakpoint\n"
-                          // "C-F9: enable/disable breakpoint\n"
+                          "C-F10/C-F11: step over/in --step-count times\n"
+                          "    (or until --step-until=EXPR), again to cancel\n"
+                          "C-F12: snapshot all threads' stacks\n"
+                          "C-F5: start/stop the sampling profiler\n"
+                          "F6: break into the target\n"
+                          "--tracepoints=FILE: one location,\"format\",args\n"
+                          "    per line, printed without stopping\n"
+                          "Click line number margin: add/remove breakpoint\n"
+                          "Space/Delete in Breakpoints: enable/disable/remove\n"
+                          "--breakpoints=FILE: one file:line per line\n"
+                          "--core=FILE: look at a core dump of the binary\n"
+                          "--non-stop: only stop the thread that stopped,\n"
+                          "    where gdb can (not for Windows targets)\n"
+                          "Enter in Threads: switch to thread\n"
+                          "Space in Threads: continue/interrupt thread\n"
                           // "S-F9: edit breakpoint properties\n"
                           "F5: run (not too useful yet)\n"
                           "S-F5: stop debugging\n"
                           "C-S-F5: restart debugging\n"
                           "\n"
-                          "Resize/redock windows with mouse\n");
+                          "Resize/redock windows with mouse\n",
+                          0);
 }
 
 void DebugPresenter::NotifyFramePainted(double frame_time_in_ms) {
@@ -64,45 +146,142 @@ bool DebugPresenter::NotifyKey(
     InputKey key, bool down, const InputModifiers& modifiers) {
   // TODO(config): I guess.
   if (key == kF10 && down && modifiers.None()) {
-    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
-        base::Bind(running_ ?
-                       &DebugCoreGdb::StepOver :
-                       &DebugCoreGdb::RunToMain,
-                   debug_core_));
-    running_ = true;
+    StepOver();
     return true;
   } else if (key == kF11 && down && modifiers.None()) {
-    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
-        base::Bind(running_ ?
-                       &DebugCoreGdb::StepIn :
-                       &DebugCoreGdb::RunToMain,
-                   debug_core_));
-    running_ = true;
+    StepIn();
+    return true;
+  } else if ((key == kF10 || key == kF11) && down &&
+             modifiers.ControlPressed()) {
+    if (step_looping_) {
+      AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+          base::Bind(&DebugCoreGdb::CancelStepLoop, debug_core_));
+      return true;
+    }
+    StepRepeatedly(key == kF11, step_loop_count_, step_loop_condition_);
     return true;
   } else if (key == kF11 && down && modifiers.ShiftPressed()) {
+    StepOut();
+    return true;
+  } else if (key == kF12 && down && modifiers.ControlPressed()) {
     AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
-        base::Bind(&DebugCoreGdb::StepOut, debug_core_));
+        base::Bind(&DebugCoreGdb::CaptureBacktraceSnapshot, debug_core_));
     return true;
   } else if (key == kF5 && down && modifiers.None()) {
-    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
-        base::Bind(&DebugCoreGdb::Continue, debug_core_));
+    Continue();
     return true;
   } else if (key == kF5 && down &&
              modifiers.ShiftPressed() &&
              modifiers.ControlPressed()) {
     AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
         base::Bind(&DebugCoreGdb::StopDebugging, debug_core_));
+    // The new run loads its modules again.
+    module_list_.Clear();
+    if (!core_path_.empty()) {
+      // A core can't be run, so it's opened again instead.
+      core_load_start_ = base::TimeTicks::Now();
+      AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+          base::Bind(&DebugCoreGdb::LoadCore, debug_core_, binary_,
+                     core_path_));
+      return true;
+    }
+    // gdb keeps its breakpoints across runs, so only what's been edited
+    // since needs sending.
+    SyncBreakpoints();
     AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
         base::Bind(&DebugCoreGdb::RunToMain, debug_core_));
     return true;
+  } else if (key == kF5 && down && modifiers.ControlPressed()) {
+    if (profiling_) {
+      AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+          base::Bind(&DebugCoreGdb::StopProfiling, debug_core_));
+      return true;
+    }
+    if (!CanRun())
+      return true;
+    profiling_ = true;
+    display_->AddOutput(
+        L"Profiling at " +
+        base::IntToString16(profile_samples_per_second_) +
+        L" samples per second, C-F5 to stop.\n");
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::StartProfiling, debug_core_,
+                   profile_samples_per_second_));
+    return true;
   } else if (key == kF5 && down && modifiers.ShiftPressed()) {
     AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
         base::Bind(&DebugCoreGdb::StopDebugging, debug_core_));
     return true;
+  } else if (key == kF6 && down && modifiers.None()) {
+    if (!CanRun())
+      return true;
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::InterruptAll, debug_core_));
+    return true;
   }
   return false;
 }
 
+void DebugPresenter::SetBinary(const string16& binary) {
+  binary_ = binary;
+}
+
+void DebugPresenter::RunToMain() {
+  if (!CanRun())
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::RunToMain, debug_core_));
+  running_ = true;
+}
+
+void DebugPresenter::StepOver() {
+  if (!CanRun())
+    return;
+  if (!running_) {
+    RunToMain();
+    return;
+  }
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::StepOver, debug_core_));
+}
+
+void DebugPresenter::StepIn() {
+  if (!CanRun())
+    return;
+  if (!running_) {
+    RunToMain();
+    return;
+  }
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::StepIn, debug_core_));
+}
+
+void DebugPresenter::StepOut() {
+  if (!CanRun())
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::StepOut, debug_core_));
+}
+
+void DebugPresenter::Continue() {
+  if (!CanRun())
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::Continue, debug_core_));
+  running_ = true;
+}
+
+void DebugPresenter::StepRepeatedly(bool step_in,
+                                    int max_steps,
+                                    const string16& condition) {
+  if (!CanRun() || !running_ || step_looping_ || profiling_)
+    return;
+  step_looping_ = true;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::StepRepeatedly, debug_core_,
+                 step_in, max_steps, condition));
+}
+
 void DebugPresenter::NotifyVariableExpansionStateChanged(
     const std::string& id, bool expanded) {
   if (!expanded) {
@@ -114,27 +293,175 @@ void DebugPresenter::NotifyVariableExpansionStateChanged(
       base::Bind(&DebugCoreGdb::SetWatchExpanded, debug_core_, id, expanded));
 }
 
-void DebugPresenter::FileLoadCompleted(string16 path, std::string* result) {
-  // TODO(scottmg): mtime.
-  source_files_->SetFileData(path, 0, *result);
+void DebugPresenter::NotifyBreakpointToggled(
+    const string16& filename, int line_number) {
+  breakpoints_.Toggle(filename, line_number);
+  display_->BreakpointsChanged();
+  SyncBreakpoints();
+}
+
+void DebugPresenter::NotifyBreakpointEnabledChanged(int id, bool enabled) {
+  if (!breakpoints_.SetEnabled(id, enabled))
+    return;
+  display_->BreakpointsChanged();
+  SyncBreakpoints();
+}
+
+void DebugPresenter::NotifyBreakpointRemoved(int id) {
+  if (!breakpoints_.Remove(id))
+    return;
+  display_->BreakpointsChanged();
+  SyncBreakpoints();
+}
+
+void DebugPresenter::NotifyThreadSelected(ThreadId thread_id) {
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::SelectThread, debug_core_, thread_id));
+  display_->SetCurrentThread(thread_id);
+  UpdatePassiveDisplays();
+}
+
+void DebugPresenter::NotifyThreadContinue(ThreadId thread_id) {
+  if (!CanRun())
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::ContinueThread, debug_core_, thread_id));
+}
+
+void DebugPresenter::NotifyThreadInterrupt(ThreadId thread_id) {
+  if (!CanRun())
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::InterruptThread, debug_core_, thread_id));
+}
+
+void DebugPresenter::SyncBreakpoints() {
+  BreakpointChangesData changes;
+  if (!breakpoints_.TakeChanges(&changes))
+    return;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::SyncBreakpoints, debug_core_, changes));
+}
+
+void DebugPresenter::FileLoadCompleted(string16 path,
+                                       std::string* result,
+                                       base::PlatformFileInfo* info) {
+  uint64 contents_hash = source_files_->SetFileData(
+      path, info->last_modified, info->size, *result);
   display_->SetFileName(path);
-  display_->SetFileData(*result);
+  display_->SetFileData(*result, contents_hash);
   delete result;
+  delete info;
 }
 
 void DebugPresenter::SetDebugCore(base::WeakPtr<DebugCoreGdb> debug_core) {
   debug_core_ = debug_core;
   AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
       base::Bind(&DebugCoreGdb::SetDebugNotification, debug_core_, this));
-  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
-      base::Bind(&DebugCoreGdb::LoadProcess,
-                 debug_core, binary_, L"", std::vector<string16>(), L""));
+  // For targets with many threads, where stopping all of them to look at one
+  // is too slow or disturbs the others too much. The backend says so and
+  // carries on in all-stop mode if gdb can't do it for this target.
+  if (CommandLine::ForCurrentProcess()->HasSwitch("non-stop")) {
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::EnableNonStop, debug_core_));
+  }
+  if (!core_path_.empty()) {
+    // Breakpoints and tracepoints are still set, so they're there to look
+    // at, but they'll never be hit.
+    core_load_start_ = base::TimeTicks::Now();
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::LoadCore, debug_core, binary_, core_path_));
+  } else {
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::LoadProcess,
+                   debug_core, binary_, L"", std::vector<string16>(), L""));
+  }
+  base::FilePath breakpoints_path =
+      CommandLine::ForCurrentProcess()->GetSwitchValuePath("breakpoints");
+  if (!breakpoints_path.empty()) {
+    std::string* result = new std::string;
+    AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
+      base::Bind(&ReadSwitchFileOnFILE, breakpoints_path, result),
+      base::Bind(&DebugPresenter::BreakpointsLoadCompleted,
+                 base::Unretained(this), breakpoints_path, result));
+  }
+  base::FilePath tracepoints_path =
+      CommandLine::ForCurrentProcess()->GetSwitchValuePath("tracepoints");
+  if (!tracepoints_path.empty()) {
+    std::string* result = new std::string;
+    AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
+      base::Bind(&ReadSwitchFileOnFILE, tracepoints_path, result),
+      base::Bind(&DebugPresenter::TracepointsLoadCompleted,
+                 base::Unretained(this), tracepoints_path, result));
+  }
 }
 
-void DebugPresenter::ReadFileOnFILE(string16 path, std::string* result) {
-#if 0
-  file_util::ReadFileToString(path, result);
-#endif
+void DebugPresenter::BreakpointsLoadCompleted(base::FilePath path,
+                                              std::string* result) {
+  std::vector<std::pair<string16, int> > locations;
+  string16 error;
+  if (!ParseBreakpointFile(*result, &locations, &error)) {
+    display_->AddOutput(path.LossyDisplayName() + L", " + error + L"\n");
+  } else {
+    for (size_t i = 0; i < locations.size(); ++i)
+      breakpoints_.Add(locations[i].first, locations[i].second, true);
+    display_->BreakpointsChanged();
+    // All of them in one go, rather than a round trip each.
+    SyncBreakpoints();
+    display_->AddOutput(
+        L"Inserted " + base::SizeTToString16(locations.size()) +
+        L" breakpoints from " + path.LossyDisplayName() + L"\n");
+  }
+  delete result;
+}
+
+void DebugPresenter::TracepointsLoadCompleted(base::FilePath path,
+                                              std::string* result) {
+  std::vector<TracepointSpec> specs;
+  string16 error;
+  if (!ParseTracepointFile(*result, &specs, &error)) {
+    display_->AddOutput(path.LossyDisplayName() + L", " + error + L"\n");
+  } else {
+    // Numbered from 1 in file order, which is what the log shows.
+    for (size_t i = 0; i < specs.size(); ++i) {
+      AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+          base::Bind(&DebugCoreGdb::InsertTracepoint, debug_core_,
+                     static_cast<int>(i + 1), specs[i].location,
+                     specs[i].format, specs[i].arguments));
+    }
+    display_->AddOutput(
+        L"Inserted " + base::SizeTToString16(specs.size()) +
+        L" tracepoints from " + path.LossyDisplayName() + L"\n");
+  }
+  delete result;
+}
+
+void DebugPresenter::ReadFileOnFILE(string16 path,
+                                    std::string* result,
+                                    base::PlatformFileInfo* info) {
+  base::FilePath file_path(path);
+  // Stat first, so that a write between the two leaves a stale mtime, and
+  // the next load hashes again, rather than the other way around.
+  if (!file_util::GetFileInfo(file_path, info))
+    return;
+  if (!file_util::ReadFileToString(file_path, result))
+    *info = base::PlatformFileInfo();
+}
+
+void DebugPresenter::OnBreakpointInsertFailed(
+    const BreakpointInsertFailedData& data) {
+  int index = breakpoints_.IndexOf(data.id);
+  if (index < 0)
+    return;
+  const BreakpointData& breakpoint = breakpoints_.at(index);
+  display_->AddOutput(
+      L"Couldn't insert breakpoint at " +
+      ToPlatformFileAndLine(breakpoint.filename, breakpoint.line_number) +
+      L": " + data.message + L"\n");
+  // gdb doesn't have it, so there's nothing to delete.
+  breakpoints_.ForgetSynced(data.id);
+  breakpoints_.Remove(data.id);
+  display_->BreakpointsChanged();
 }
 
 void DebugPresenter::OnStoppedAtBreakpoint(
@@ -143,18 +470,96 @@ void DebugPresenter::OnStoppedAtBreakpoint(
   // TODO(scottmg): Need to relativize to binary location (or search in some
   // reasonable way anyway).
   string16 path(string16(L"test_data/") + data.frame.filename);
+  base::PlatformFileInfo* info = new base::PlatformFileInfo;
+  AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
+    base::Bind(&DebugPresenter::ReadFileOnFILE,
+               base::Unretained(this), path, result, info),
+    base::Bind(&DebugPresenter::FileLoadCompleted,
+               base::Unretained(this), path, result, info));
+  display_->SetProgramCounterLine(data.frame.line_number);
+  display_->SetCurrentThread(data.thread_id);
+  UpdatePassiveDisplays();
+}
+
+void DebugPresenter::OnCoreLoaded(const CoreLoadedData& data) {
+  string16 signal = data.signal_description.empty()
+                        ? string16(L"a signal")
+                        : data.signal_description;
+  display_->AddOutput(L"Core file " + core_path_ + L": thread " +
+                      base::IntToString16(data.thread_id) + L" stopped by " +
+                      signal + L"\n");
+  std::string* result = new std::string;
+  string16 path(string16(L"test_data/") + data.frame.filename);
+  base::PlatformFileInfo* info = new base::PlatformFileInfo;
   AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
     base::Bind(&DebugPresenter::ReadFileOnFILE,
-               base::Unretained(this), path, result),
+               base::Unretained(this), path, result, info),
     base::Bind(&DebugPresenter::FileLoadCompleted,
-               base::Unretained(this), path, result));
+               base::Unretained(this), path, result, info));
   display_->SetProgramCounterLine(data.frame.line_number);
+  display_->SetCurrentThread(data.thread_id);
   UpdatePassiveDisplays();
 }
 
+void DebugPresenter::OnRetrievedThreads(const RetrievedThreadsData& data) {
+  display_->UpdateThreads(data);
+}
+
 void DebugPresenter::OnRetrievedStack(const RetrievedStackData& data) {
   // TODO(scottmg): Stack frame selection. Where should that live?
   display_->SetStackData(data.frames, 0);
+  if (!core_load_start_.is_null()) {
+    base::TimeDelta elapsed = base::TimeTicks::Now() - core_load_start_;
+    display_->AddOutput(
+        L"First stack from core in " +
+        base::Int64ToString16(elapsed.InMilliseconds()) + L"ms\n");
+    core_load_start_ = base::TimeTicks();
+  }
+}
+
+void DebugPresenter::OnBacktraceSnapshot(const BacktraceSnapshotData& data) {
+  string16 summary =
+      L"Captured " + base::IntToString16(data.thread_count) + L" threads in " +
+      base::SizeTToString16(data.groups.size()) + L" distinct stacks (" +
+      base::IntToString16(static_cast<int>(data.processing_ms)) + L"ms)";
+  base::FilePath* path = new base::FilePath(
+      base::FilePath(binary_).DirName().Append(kBacktraceSnapshotName));
+  AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
+      base::Bind(&WriteBacktraceSnapshotOnFILE,
+                 FormatBacktraceSnapshot(data), path),
+      base::Bind(&DebugPresenter::BacktraceSnapshotWritten,
+                 base::Unretained(this), summary, path));
+}
+
+void DebugPresenter::BacktraceSnapshotWritten(string16 summary,
+                                              base::FilePath* path) {
+  if (path->empty()) {
+    display_->AddOutput(summary + L", couldn't save it next to " + binary_ +
+                        L"\n");
+  } else {
+    display_->AddOutput(summary + L", saved to " + path->LossyDisplayName() +
+                        L"\n");
+  }
+  delete path;
+}
+
+void DebugPresenter::OnProfileCollected(const ProfileData& data) {
+  profiling_ = false;
+  display_->SetProfileData(data);
+  base::FilePath path(kProfilePath);
+  display_->AddOutput(
+      L"Profiled " + base::IntToString16(data.sample_count) +
+      L" samples in " +
+      base::IntToString16(static_cast<int>(data.duration_ms)) +
+      L"ms, target stopped " +
+      base::IntToString16(static_cast<int>(data.mean_pause_us)) +
+      L"us per sample, saved to " + path.LossyDisplayName() + L"\n");
+  AppThread::PostTask(AppThread::FILE, FROM_HERE,
+      base::Bind(&WriteProfileOnFILE, FormatProfile(data)));
+}
+
+void DebugPresenter::OnTracepointOutput(const TracepointOutputData& data) {
+  display_->AddTracepointOutput(data);
 }
 
 // This should be moved to the debug core so that the ids can be created in a
@@ -179,6 +584,7 @@ void DebugPresenter::OnRetrievedLocals(const RetrievedLocalsData& data) {
       AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
           base::Bind(&DebugCoreGdb::CreateWatch,
                      debug_core_, id, local));
+      creating_watches_ = true;
       active_locals[id] = local;
     } else {
       active_locals[j->second] = j->first;
@@ -253,30 +659,104 @@ void DebugPresenter::OnInternalDebugOutput(const string16& data) {
   display_->AddLog(data);
 }
 
+void DebugPresenter::OnSynced(int sync_id) {
+  // From an update that a later stop has replaced.
+  if (sync_id != passive_update_id_)
+    return;
+  if (creating_watches_) {
+    creating_watches_ = false;
+    AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+        base::Bind(&DebugCoreGdb::Sync, debug_core_, sync_id));
+    return;
+  }
+  display_->PassiveDisplaysUpdated();
+}
+
 void DebugPresenter::OnStoppedAfterStepping(
     const StoppedAfterSteppingData& data) {
   // TODO(scottmg): File change reload, etc.
   display_->SetProgramCounterLine(data.frame.line_number);
+  display_->SetCurrentThread(data.thread_id);
   UpdatePassiveDisplays();
 }
 
-void DebugPresenter::OnLibraryLoaded(const LibraryLoadedData& data) {
-  string16 output = L"Loaded '" + data.host_path + L"'";
-  if (data.host_path != data.target_path)
-    output += L" (" + data.target_path + L")";
-  if (data.symbols_loaded)
-    output += L", Symbols loaded.";
-  display_->AddOutput(output);
+void DebugPresenter::OnStepLoopFinished(const StepLoopData& data) {
+  step_looping_ = false;
+  if (data.reason == STEP_LOOP_REFUSED) {
+    display_->AddOutput(L"Couldn't step repeatedly, debugger is busy\n");
+    return;
+  }
+  string16 how;
+  switch (data.reason) {
+    case STEP_LOOP_LIMIT_REACHED:
+      how = L"step count reached";
+      break;
+    case STEP_LOOP_CONDITION_MET:
+      how = L"condition is true";
+      break;
+    case STEP_LOOP_CONDITION_FAILED:
+      how = L"couldn't evaluate condition: " + data.error;
+      break;
+    case STEP_LOOP_CANCELLED:
+      how = L"cancelled";
+      break;
+    case STEP_LOOP_INTERRUPTED:
+      how = L"stopped";
+      break;
+    case STEP_LOOP_REFUSED:
+      NOTREACHED();
+      break;
+  }
+  int steps_per_second = data.duration_ms > 0
+      ? static_cast<int>(data.steps * 1000 / data.duration_ms)
+      : 0;
+  display_->AddOutput(
+      L"Stepped " + base::IntToString16(data.steps) + L" times in " +
+      base::IntToString16(static_cast<int>(data.duration_ms)) + L"ms (" +
+      base::IntToString16(steps_per_second) + L" steps/s), " + how + L"\n");
+}
+
+void DebugPresenter::OnProcessExited(const ProcessExitedData& data) {
+  running_ = false;
+  step_looping_ = false;
+  module_list_.Clear();
+  if (data.signal_name.empty()) {
+    display_->AddOutput(L"Process exited with code " +
+                        base::IntToString16(data.exit_code) + L"\n");
+  } else {
+    display_->AddOutput(L"Process killed by " + data.signal_name + L"\n");
+  }
+  display_->SetProcessExited(data);
+}
+
+void DebugPresenter::OnThreadsRunning(const ThreadsRunningData& data) {
+  display_->SetThreadsRunning(data);
+}
+
+void DebugPresenter::OnLibrariesChanged(const LibrariesChangedData& data) {
+  module_list_.Apply(data);
+  display_->AddOutput(SummarizeLibrariesChanged(data));
 }
 
-void DebugPresenter::OnLibraryUnloaded(const LibraryUnloadedData& data) {
+bool DebugPresenter::CanRun() {
+  if (core_path_.empty())
+    return true;
+  display_->AddOutput(L"Can't run a core file.\n");
+  return false;
 }
 
 void DebugPresenter::UpdatePassiveDisplays() {
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::GetThreads, debug_core_));
   AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
       base::Bind(&DebugCoreGdb::GetStack, debug_core_));
   AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
       base::Bind(&DebugCoreGdb::GetLocals, debug_core_));
   AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
       base::Bind(&DebugCoreGdb::UpdateWatches, debug_core_));
+  // The locals arrive before this does, so any watches they need are asked
+  // for by then.
+  creating_watches_ = false;
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::Sync, debug_core_, ++passive_update_id_));
 }
@@ -9,9 +9,14 @@
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/files/file_path.h"
 #include "base/memory/weak_ptr.h"
+#include "base/platform_file.h"
+#include "base/time.h"
 #include "sg/backend/backend.h"
+#include "sg/breakpoint_list.h"
 #include "sg/debug_presenter_notify.h"
+#include "sg/module_list.h"
 
 class DebugCoreGdb;
 class DebugPresenterDisplay;
@@ -26,33 +31,79 @@ class DebugPresenter : public DebugPresenterNotify,
   virtual void SetDisplay(DebugPresenterDisplay* display);
   virtual void SetDebugCore(base::WeakPtr<DebugCoreGdb> debug_core);
 
+  // Instead of the one from the command line. Must be called before
+  // SetDebugCore().
+  void SetBinary(const string16& binary);
+
+  // What the keys do, for driving it without a window. Stepping starts the
+  // target and runs it to main() if it isn't running yet.
+  void RunToMain();
+  void StepOver();
+  void StepIn();
+  void StepOut();
+  void Continue();
+  // See DebugCoreGdb::StepRepeatedly().
+  void StepRepeatedly(bool step_in, int max_steps, const string16& condition);
+
   // Implementation of DebugPresenterNotify:
   virtual void NotifyFramePainted(double frame_time_in_ms) OVERRIDE;
   virtual bool NotifyKey(
       InputKey key, bool down, const InputModifiers& modifiers) OVERRIDE;
   virtual void NotifyVariableExpansionStateChanged(
       const std::string& id, bool expanded) OVERRIDE;
+  virtual void NotifyBreakpointToggled(
+      const string16& filename, int line_number) OVERRIDE;
+  virtual void NotifyBreakpointEnabledChanged(int id, bool enabled) OVERRIDE;
+  virtual void NotifyBreakpointRemoved(int id) OVERRIDE;
+  virtual void NotifyThreadSelected(ThreadId thread_id) OVERRIDE;
+  virtual void NotifyThreadContinue(ThreadId thread_id) OVERRIDE;
+  virtual void NotifyThreadInterrupt(ThreadId thread_id) OVERRIDE;
 
   // Implementation of DebugNotification:
+  virtual void OnBreakpointInsertFailed(
+      const BreakpointInsertFailedData& data) OVERRIDE;
   virtual void OnStoppedAtBreakpoint(
       const StoppedAtBreakpointData& data) OVERRIDE;
   virtual void OnStoppedAfterStepping(
       const StoppedAfterSteppingData& data) OVERRIDE;
-  virtual void OnLibraryLoaded(const LibraryLoadedData& data) OVERRIDE;
-  virtual void OnLibraryUnloaded(const LibraryUnloadedData& data) OVERRIDE;
+  virtual void OnStepLoopFinished(const StepLoopData& data) OVERRIDE;
+  virtual void OnProcessExited(const ProcessExitedData& data) OVERRIDE;
+  virtual void OnCoreLoaded(const CoreLoadedData& data) OVERRIDE;
+  virtual void OnThreadsRunning(const ThreadsRunningData& data) OVERRIDE;
+  virtual void OnLibrariesChanged(const LibrariesChangedData& data) OVERRIDE;
+  virtual void OnRetrievedThreads(const RetrievedThreadsData& data) OVERRIDE;
   virtual void OnRetrievedStack(const RetrievedStackData& data) OVERRIDE;
+  virtual void OnBacktraceSnapshot(
+      const BacktraceSnapshotData& data) OVERRIDE;
+  virtual void OnProfileCollected(const ProfileData& data) OVERRIDE;
+  virtual void OnTracepointOutput(const TracepointOutputData& data) OVERRIDE;
   virtual void OnRetrievedLocals(const RetrievedLocalsData& data) OVERRIDE;
   virtual void OnWatchCreated(const WatchCreatedData& data) OVERRIDE;
   virtual void OnWatchesUpdated(const WatchesUpdatedData& data) OVERRIDE;
   virtual void OnWatchChildList(const WatchesChildListData& data) OVERRIDE;
   virtual void OnConsoleOutput(const string16& data) OVERRIDE;
   virtual void OnInternalDebugOutput(const string16& data) OVERRIDE;
+  virtual void OnSynced(int sync_id) OVERRIDE;
 
  private:
-  void ReadFileOnFILE(string16 path, std::string* result);
-  void FileLoadCompleted(string16 path, std::string* result);
-
-  // On stopping, starts requests for stack, values of locals, etc.
+  void ReadFileOnFILE(string16 path,
+                      std::string* result,
+                      base::PlatformFileInfo* info);
+  void FileLoadCompleted(string16 path,
+                         std::string* result,
+                         base::PlatformFileInfo* info);
+  void TracepointsLoadCompleted(base::FilePath path, std::string* result);
+  void BreakpointsLoadCompleted(base::FilePath path, std::string* result);
+  void BacktraceSnapshotWritten(string16 summary, base::FilePath* path);
+
+  // Sends whatever's changed in |breakpoints_| to the backend, as one batch.
+  void SyncBreakpoints();
+
+  // False, after saying why, when looking at a core file.
+  bool CanRun();
+
+  // On stopping, starts requests for stack, values of locals, etc., and
+  // tells the display once they've all arrived.
   void UpdatePassiveDisplays();
 
   std::string GenerateNewVariableIdentifier();
@@ -67,8 +118,34 @@ class DebugPresenter : public DebugPresenterNotify,
   // Map from name to backend variable id, used for locals.
   std::map<string16, std::string> local_to_backend_;
 
+  // Which UpdatePassiveDisplays() is being waited for, as the backend's
+  // sync id. Locals that are new create watches, which need another sync.
+  int passive_update_id_;
+  bool creating_watches_;
+
   bool running_;
 
+  // From --core, when looking at a core dump of |binary_| instead of
+  // running it.
+  string16 core_path_;
+  // Until the first stack from the core arrives, to report how long it took.
+  base::TimeTicks core_load_start_;
+
+  // Between starting the profiler and receiving its profile.
+  bool profiling_;
+  int profile_samples_per_second_;
+
+  // Between starting a step loop and it finishing.
+  bool step_looping_;
+  // From --step-count and --step-until.
+  int step_loop_count_;
+  string16 step_loop_condition_;
+
+  BreakpointList breakpoints_;
+
+  // Modules loaded in the target, for a future Modules view.
+  ModuleList module_list_;
+
   DISALLOW_COPY_AND_ASSIGN(DebugPresenter);
 };
 
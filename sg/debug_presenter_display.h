@@ -8,10 +8,11 @@
 #include <string>
 #include <vector>
 
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
 #include "sg/basex/string16.h"
 
-class FrameData;
-class TypeNameValue;
+class BreakpointList;
 
 class DebugPresenterVariable {
  public:
@@ -37,11 +38,31 @@ class DebugPresenterDisplay {
   virtual ~DebugPresenterDisplay();
 
   virtual void SetFileName(const string16& filename) = 0;
-  virtual void SetFileData(const std::string& utf8_text) = 0;
+  // |contents_hash| is the file's key in the HighlightCache, or 0 if it
+  // isn't a file and shouldn't be cached.
+  virtual void SetFileData(const std::string& utf8_text,
+                           uint64 contents_hash) = 0;
   virtual void SetProgramCounterLine(int line_number) = 0;
+  virtual void SetProcessExited(const ProcessExitedData& data) = 0;
 
   virtual void SetStackData(const std::vector<FrameData>& frame_data,
                             int active) = 0;
+  // The threads, stack, locals and watches for the last stop have all
+  // arrived.
+  virtual void PassiveDisplaysUpdated() = 0;
+
+  virtual void UpdateThreads(const RetrievedThreadsData& data) = 0;
+  virtual void SetThreadsRunning(const ThreadsRunningData& data) = 0;
+  virtual void SetCurrentThread(ThreadId thread_id) = 0;
+
+  // |breakpoints| stays owned by the presenter, which calls
+  // BreakpointsChanged() after each edit.
+  virtual void SetBreakpoints(const BreakpointList* breakpoints) = 0;
+  virtual void BreakpointsChanged() = 0;
+
+  virtual void SetProfileData(const ProfileData& data) = 0;
+
+  virtual void AddTracepointOutput(const TracepointOutputData& data) = 0;
 
   virtual void AddLocalsChild(
       const std::string& parent_id, const std::string& child_id) = 0;
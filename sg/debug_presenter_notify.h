@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "sg/backend/backend.h"
 #include "sg/basex/string16.h"
 #include "sg/ui/input.h"
 
@@ -19,6 +20,13 @@ class DebugPresenterNotify {
       InputKey key, bool down, const InputModifiers& modifiers) = 0;
   virtual void NotifyVariableExpansionStateChanged(
       const std::string& id, bool expanded) = 0;
+  virtual void NotifyBreakpointToggled(
+      const string16& filename, int line_number) = 0;
+  virtual void NotifyBreakpointEnabledChanged(int id, bool enabled) = 0;
+  virtual void NotifyBreakpointRemoved(int id) = 0;
+  virtual void NotifyThreadSelected(ThreadId thread_id) = 0;
+  virtual void NotifyThreadContinue(ThreadId thread_id) = 0;
+  virtual void NotifyThreadInterrupt(ThreadId thread_id) = 0;
 };
 
 #endif  // SG_DEBUG_PRESENTER_NOTIFY_H_
@@ -0,0 +1,598 @@
+# Copyright 2013 The Chromium Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+"""Compiles the token definitions in a lexer source file (i.e. cpp_lexer.cc)
+into a DFA per lexer state, written out as tables for LexerState to run
+instead of RE2. See lexer_table.h.
+
+  python generate_lexer_tables.py sg/cpp_lexer.cc out/gen/cpp_lexer_tables.cc
+
+The rules are read from the TokenDefinitions::Add calls rather than from
+pygments (as generate_cpp_lexer_data.py did), because cpp_lexer.cc has been
+hand-modified since, and the tables have to match it exactly. States with a
+regex that can't be compiled here are left to RE2.
+
+A state's DFA runs all of its regexes at once. The first regex (in order)
+that matches anywhere wins, taking its match end from the last position it
+accepted at, i.e. its longest match. Regexes with a non-greedy repetition
+instead stop at their first match: they're dropped from the DFA once they've
+accepted. That's what RE2 does for all the regexes that are in lexers here,
+and the lexer test checks that the token streams agree.
+
+It also writes out a version for the lexer (i.e. kCppLexerVersion), a hash of
+the lines that define the states and tokens, so that colors saved by a lexer
+with other rules aren't used.
+"""
+
+from __future__ import print_function
+
+import hashlib
+import os
+import re
+import sys
+
+
+NO_RULE = 0x7fff
+MAX_RUNE = 0x10ffff
+
+
+class Unsupported(Exception):
+  pass
+
+
+# Token definitions in the lexer source.
+
+def UnescapeCString(literal):
+  result = []
+  i = 0
+  while i < len(literal):
+    c = literal[i]
+    if c == '\\':
+      i += 1
+      c = literal[i]
+      if c == 'n':
+        c = '\n'
+      elif c == 't':
+        c = '\t'
+      elif c not in '\\"\'':
+        raise Unsupported('escape \\%s in C string' % c)
+    result.append(c)
+    i += 1
+  return ''.join(result)
+
+
+ADD_STATE = re.compile(r'^\s*LexerState\* (\w+) = lexer->AddState\("(\w+)"\)')
+ADD = re.compile(r'^\s*(\w+)_defs\.(?:Add|AddWithTransition)'
+                 r'\("((?:[^"\\]|\\.)*)"')
+
+
+def ReadTokenDefinitions(path):
+  """Returns [(state name, [regex, ...]), ...] in the order the states were
+  added."""
+  states = []
+  state_for_variable = {}
+  regexes_for_variable = {}
+  with open(path) as f:
+    for line in f:
+      match = ADD_STATE.match(line)
+      if match:
+        state_for_variable[match.group(1)] = match.group(2)
+        regexes_for_variable[match.group(1)] = []
+        states.append(match.group(1))
+        continue
+      match = ADD.match(line)
+      if match:
+        regexes_for_variable[match.group(1)].append(
+            UnescapeCString(match.group(2)))
+  return [(state_for_variable[v], regexes_for_variable[v]) for v in states]
+
+
+def HashTokenDefinitions(path):
+  """Returns the first 32 bits of a SHA-1 of the lines that ReadTokenDefinitions
+  reads, so that it changes along with the token types and transitions as well
+  as the regexes, but not with comments or formatting."""
+  digest = hashlib.sha1()
+  with open(path) as f:
+    for line in f:
+      if ADD_STATE.match(line) or ADD.match(line):
+        line = line.strip()
+        if line.endswith('// NOLINT'):
+          line = line[:-len('// NOLINT')].rstrip()
+        digest.update((line + '\n').encode('utf-8'))
+  return int(digest.hexdigest()[:8], 16)
+
+
+# Parsing regexes, in the subset of RE2's syntax that the lexers use.
+
+def Negate(ranges):
+  result = []
+  next_lo = 0
+  for lo, hi in sorted(ranges):
+    if lo > next_lo:
+      result.append((next_lo, lo - 1))
+    next_lo = max(next_lo, hi + 1)
+  if next_lo <= MAX_RUNE:
+    result.append((next_lo, MAX_RUNE))
+  return result
+
+
+DIGIT = [(ord('0'), ord('9'))]
+SPACE = [(ord('\t'), ord('\n')), (ord('\f'), ord('\r')), (ord(' '), ord(' '))]
+WORD = [(ord('0'), ord('9')), (ord('A'), ord('Z')), (ord('_'), ord('_')),
+        (ord('a'), ord('z'))]
+
+
+class RegexParser(object):
+  """Parses to a tree of tuples: ('set', ranges), ('cat', [nodes]),
+  ('alt', [nodes]), ('rep', node, min, max or None), ('empty',),
+  ('bol',) and ('word_boundary',)."""
+
+  def __init__(self, regex):
+    self.regex = regex
+    self.pos = 0
+    self.lazy = False
+
+  def Parse(self):
+    node = self.ParseAlternation()
+    if self.pos != len(self.regex):
+      raise Unsupported('unexpected ) in %r' % self.regex)
+    return node
+
+  def Peek(self):
+    if self.pos < len(self.regex):
+      return self.regex[self.pos]
+    return None
+
+  def Next(self):
+    c = self.Peek()
+    if c is None:
+      raise Unsupported('unexpected end of %r' % self.regex)
+    self.pos += 1
+    return c
+
+  def ParseAlternation(self):
+    branches = [self.ParseConcatenation()]
+    while self.Peek() == '|':
+      self.pos += 1
+      branches.append(self.ParseConcatenation())
+    if len(branches) == 1:
+      return branches[0]
+    return ('alt', branches)
+
+  def ParseConcatenation(self):
+    items = []
+    while self.Peek() not in (None, '|', ')'):
+      items.append(self.ParseRepetition(self.ParseAtom()))
+    if not items:
+      return ('empty',)
+    if len(items) == 1:
+      return items[0]
+    return ('cat', items)
+
+  def ParseRepetition(self, atom):
+    c = self.Peek()
+    if c == '*':
+      bounds = (0, None)
+    elif c == '+':
+      bounds = (1, None)
+    elif c == '?':
+      bounds = (0, 1)
+    elif c == '{':
+      match = re.compile(r'\{(\d+)(,(\d*))?\}').match(self.regex, self.pos)
+      if not match:
+        raise Unsupported('bad repetition in %r' % self.regex)
+      lo = int(match.group(1))
+      if not match.group(2):
+        hi = lo
+      elif match.group(3):
+        hi = int(match.group(3))
+      else:
+        hi = None
+      bounds = (lo, hi)
+      self.pos = match.end() - 1
+    else:
+      return atom
+    self.pos += 1
+    if self.Peek() == '?':
+      self.pos += 1
+      self.lazy = True
+    if atom[0] in ('bol', 'word_boundary'):
+      raise Unsupported('repeated assertion in %r' % self.regex)
+    return self.ParseRepetition(('rep', atom, bounds[0], bounds[1]))
+
+  def ParseAtom(self):
+    c = self.Next()
+    if c == '(':
+      if self.regex.startswith('?:', self.pos):
+        self.pos += 2
+      elif self.Peek() == '?':
+        raise Unsupported('group flags in %r' % self.regex)
+      node = self.ParseAlternation()
+      if self.Next() != ')':
+        raise Unsupported('missing ) in %r' % self.regex)
+      return node
+    if c == '[':
+      return ('set', self.ParseClass())
+    if c == '.':
+      return ('set', Negate([(ord('\n'), ord('\n'))]))
+    if c == '^':
+      return ('bol',)
+    if c == '$':
+      raise Unsupported('$ in %r' % self.regex)
+    if c == '\\':
+      c = self.Next()
+      if c == 'b':
+        return ('word_boundary',)
+      return ('set', self.ParseEscape(c))
+    if ord(c) >= 0x80:
+      raise Unsupported('non-ASCII literal in %r' % self.regex)
+    return ('set', [(ord(c), ord(c))])
+
+  def ParseEscape(self, c):
+    """The ranges for \\c, outside or inside a class."""
+    simple = {'n': '\n', 't': '\t', 'r': '\r', 'f': '\f', 'v': '\v',
+              'a': '\a'}
+    if c in simple:
+      return [(ord(simple[c]), ord(simple[c]))]
+    classes = {'d': DIGIT, 's': SPACE, 'w': WORD}
+    if c in classes:
+      return classes[c]
+    if c.lower() in classes:
+      return Negate(classes[c.lower()])
+    if c.isalnum():
+      raise Unsupported('escape \\%s in %r' % (c, self.regex))
+    return [(ord(c), ord(c))]
+
+  def ParseClass(self):
+    negated = False
+    if self.Peek() == '^':
+      self.pos += 1
+      negated = True
+    ranges = []
+    first = True
+    while True:
+      c = self.Next()
+      if c == ']' and not first:
+        break
+      first = False
+      if c == '\\':
+        items = self.ParseEscape(self.Next())
+        if len(items) != 1 or items[0][0] != items[0][1]:
+          ranges += items
+          continue
+        lo = items[0][0]
+      elif c == '[':
+        raise Unsupported('nested class in %r' % self.regex)
+      else:
+        lo = ord(c)
+      hi = lo
+      if (self.Peek() == '-' and
+          self.pos + 1 < len(self.regex) and self.regex[self.pos + 1] != ']'):
+        self.pos += 1
+        c = self.Next()
+        if c == '\\':
+          items = self.ParseEscape(self.Next())
+          if len(items) != 1 or items[0][0] != items[0][1]:
+            raise Unsupported('bad range in %r' % self.regex)
+          hi = items[0][0]
+        else:
+          hi = ord(c)
+      if lo >= 0x80 or hi >= 0x80:
+        raise Unsupported('non-ASCII class in %r' % self.regex)
+      ranges.append((lo, hi))
+    if negated:
+      return Negate(ranges)
+    return ranges
+
+
+# UTF-8 encoding of rune ranges, as RE2 compiles them: sequences of byte
+# ranges, e.g. [0x80, 0x7ff] is [C2-DF][80-BF].
+
+def EncodeUtf8(rune):
+  if rune < 0x80:
+    return [rune]
+  if rune < 0x800:
+    return [0xc0 | (rune >> 6), 0x80 | (rune & 0x3f)]
+  if rune < 0x10000:
+    return [0xe0 | (rune >> 12), 0x80 | ((rune >> 6) & 0x3f),
+            0x80 | (rune & 0x3f)]
+  return [0xf0 | (rune >> 18), 0x80 | ((rune >> 12) & 0x3f),
+          0x80 | ((rune >> 6) & 0x3f), 0x80 | (rune & 0x3f)]
+
+
+def Utf8SequencesOfSameLength(lo, hi, result):
+  length = len(EncodeUtf8(lo))
+  for i in range(1, length):
+    mask = (1 << (6 * i)) - 1
+    if (lo & ~mask) != (hi & ~mask):
+      if (lo & mask) != 0:
+        Utf8SequencesOfSameLength(lo, lo | mask, result)
+        Utf8SequencesOfSameLength((lo | mask) + 1, hi, result)
+        return
+      if (hi & mask) != mask:
+        Utf8SequencesOfSameLength(lo, (hi & ~mask) - 1, result)
+        Utf8SequencesOfSameLength(hi & ~mask, hi, result)
+        return
+  result.append(list(zip(EncodeUtf8(lo), EncodeUtf8(hi))))
+
+
+def Utf8Sequences(ranges):
+  result = []
+  for lo, hi in ranges:
+    for length_lo, length_hi in ((0, 0x7f), (0x80, 0x7ff), (0x800, 0xffff),
+                                 (0x10000, MAX_RUNE)):
+      l = max(lo, length_lo)
+      h = min(hi, length_hi)
+      if l <= h:
+        Utf8SequencesOfSameLength(l, h, result)
+  return result
+
+
+# Thompson NFA, with each state belonging to one rule.
+
+class Nfa(object):
+  def __init__(self):
+    self.rule = []
+    self.epsilon = []
+    self.bytes = []  # [(lo, hi, target)]
+    # Rule index for accepting states, and whether they need a word
+    # boundary after.
+    self.accept = {}
+
+  def AddState(self, rule):
+    self.rule.append(rule)
+    self.epsilon.append([])
+    self.bytes.append([])
+    return len(self.rule) - 1
+
+  def Build(self, node, start, rule):
+    """Adds |node| from |start|, returning its end state."""
+    kind = node[0]
+    if kind in ('empty', 'bol'):
+      # Anchors are at the start of the rule (checked before), which is
+      # always the start of the text that's being matched.
+      return start
+    if kind == 'set':
+      end = self.AddState(rule)
+      for sequence in Utf8Sequences(node[1]):
+        state = start
+        for i, (lo, hi) in enumerate(sequence):
+          target = end if i == len(sequence) - 1 else self.AddState(rule)
+          self.bytes[state].append((lo, hi, target))
+          state = target
+      return end
+    if kind == 'cat':
+      for item in node[1]:
+        start = self.Build(item, start, rule)
+      return start
+    if kind == 'alt':
+      end = self.AddState(rule)
+      for branch in node[1]:
+        branch_start = self.AddState(rule)
+        self.epsilon[start].append(branch_start)
+        self.epsilon[self.Build(branch, branch_start, rule)].append(end)
+      return end
+    if kind == 'rep':
+      sub, lo, hi = node[1], node[2], node[3]
+      for _ in range(lo):
+        start = self.Build(sub, start, rule)
+      if hi is None:
+        loop = self.AddState(rule)
+        self.epsilon[start].append(loop)
+        self.epsilon[self.Build(sub, loop, rule)].append(loop)
+        return loop
+      for _ in range(hi - lo):
+        skip = self.AddState(rule)
+        self.epsilon[start].append(skip)
+        self.epsilon[self.Build(sub, start, rule)].append(skip)
+        start = skip
+      return start
+    raise Unsupported('%s here' % kind)
+
+
+def CheckAssertions(node, at_start, at_end):
+  """Only allows ^ first and \\b last, which are all the lexers use."""
+  kind = node[0]
+  if kind == 'bol' and not at_start:
+    raise Unsupported('^ not at the start')
+  if kind == 'word_boundary' and not at_end:
+    raise Unsupported('\\b not at the end')
+  if kind == 'cat':
+    items = node[1]
+    for i, item in enumerate(items):
+      CheckAssertions(item, at_start and i == 0,
+                      at_end and i == len(items) - 1)
+  elif kind == 'alt':
+    for branch in node[1]:
+      CheckAssertions(branch, at_start, False)
+  elif kind == 'rep':
+    CheckAssertions(node[1], False, False)
+
+
+def AddRule(nfa, regex, rule, start):
+  parser = RegexParser(regex)
+  node = parser.Parse()
+  CheckAssertions(node, True, True)
+  needs_word_boundary = False
+  if node[0] == 'word_boundary':
+    raise Unsupported('only \\b')
+  if node[0] == 'cat' and node[1][-1][0] == 'word_boundary':
+    needs_word_boundary = True
+    node = ('cat', node[1][:-1])
+  if needs_word_boundary and parser.lazy:
+    raise Unsupported('non-greedy with \\b')
+  rule_start = nfa.AddState(rule)
+  nfa.epsilon[start].append(rule_start)
+  end = nfa.Build(node, rule_start, rule)
+  nfa.accept[end] = (rule, needs_word_boundary)
+  return parser.lazy
+
+
+# Subset construction.
+
+def Closure(nfa, states):
+  result = set(states)
+  stack = list(states)
+  while stack:
+    for target in nfa.epsilon[stack.pop()]:
+      if target not in result:
+        result.add(target)
+        stack.append(target)
+  return frozenset(result)
+
+
+def BuildDfa(regexes):
+  nfa = Nfa()
+  start = nfa.AddState(-1)
+  lazy_rules = set()
+  for rule, regex in enumerate(regexes):
+    if AddRule(nfa, regex, rule, start):
+      lazy_rules.add(rule)
+
+  # State 0 is dead, and 1 the start.
+  dead = frozenset()
+  sets = [dead, Closure(nfa, [start])]
+  index_for_set = {dead: 0, sets[1]: 1}
+  transitions = [[0] * 256, None]
+  accept = [NO_RULE, None]
+  accept_at_word_boundary = [NO_RULE, None]
+  min_live = [NO_RULE, None]
+  i = 1
+  while i < len(sets):
+    current = sets[i]
+    accepted = [nfa.accept[s] for s in current if s in nfa.accept]
+    accept[i] = min([r for r, boundary in accepted if not boundary] +
+                    [NO_RULE])
+    accept_at_word_boundary[i] = min([r for r, _ in accepted] + [NO_RULE])
+    # A non-greedy rule is done as soon as it's matched.
+    done = set(r for r, _ in accepted if r in lazy_rules)
+    live = [s for s in current if nfa.rule[s] not in done and nfa.bytes[s]]
+    min_live[i] = min([nfa.rule[s] for s in live] + [NO_RULE])
+    row = []
+    for byte in range(256):
+      targets = [t for s in live for lo, hi, t in nfa.bytes[s]
+                 if lo <= byte <= hi]
+      target_set = Closure(nfa, targets)
+      if target_set not in index_for_set:
+        index_for_set[target_set] = len(sets)
+        sets.append(target_set)
+        transitions.append(None)
+        accept.append(None)
+        accept_at_word_boundary.append(None)
+        min_live.append(None)
+      row.append(index_for_set[target_set])
+    transitions[i] = row
+    i += 1
+  if len(sets) > 0xffff:
+    raise Unsupported('too many states')
+
+  # Bytes that every state treats the same share a column.
+  class_for_column = {}
+  byte_classes = []
+  for byte in range(256):
+    column = tuple(row[byte] for row in transitions)
+    byte_classes.append(class_for_column.setdefault(column,
+                                                    len(class_for_column)))
+  class_count = len(class_for_column)
+  class_transitions = []
+  for row in transitions:
+    compressed = [0] * class_count
+    for byte in range(256):
+      compressed[byte_classes[byte]] = row[byte]
+    class_transitions.append(compressed)
+
+  return {
+    'byte_classes': byte_classes,
+    'class_count': class_count,
+    'transitions': class_transitions,
+    'accept': accept,
+    'accept_at_word_boundary': accept_at_word_boundary,
+    'min_live': min_live,
+  }
+
+
+# Output.
+
+def CString(string):
+  escaped = string.replace('\\', '\\\\').replace('"', '\\"')
+  return '"%s"' % escaped.replace('\n', '\\n').replace('\t', '\\t')
+
+
+def WriteArray(out, declaration, values, per_line):
+  out.write('%s = {\n' % declaration)
+  for i in range(0, len(values), per_line):
+    out.write('  %s,\n' % ', '.join(str(v) for v in values[i:i + per_line]))
+  out.write('};\n\n')
+
+
+def Identifier(name):
+  """e.g. cpp_lexer to kCppLexer."""
+  return 'k' + ''.join(part.capitalize() for part in name.split('_'))
+
+
+def main():
+  if len(sys.argv) != 3:
+    print('usage: generate_lexer_tables.py LEXER_SOURCE OUTPUT',
+          file=sys.stderr)
+    return 1
+  source, output = sys.argv[1], sys.argv[2]
+  # e.g. cpp_lexer.cc makes kCppLexerTables, with kCppLexerRoot... for its
+  # root state.
+  prefix = Identifier(os.path.splitext(os.path.basename(source))[0])
+
+  out_dir = os.path.dirname(output)
+  if out_dir and not os.path.isdir(out_dir):
+    os.makedirs(out_dir)
+  out = open(output, 'w')
+  out.write('// THIS FILE AUTOGENERATED BY %s FROM %s. DO NOT EDIT.\n\n' % (
+      os.path.basename(__file__), os.path.basename(source)))
+  out.write('#include "sg/lexer_table.h"\n\n')
+  out.write('namespace {\n\n')
+
+  tables = []
+  for state, regexes in ReadTokenDefinitions(source):
+    name = prefix + Identifier(state)[1:]
+    try:
+      dfa = BuildDfa(regexes)
+    except Unsupported as e:
+      out.write('// %s is left to RE2: %s.\n\n' % (state, e))
+      continue
+    tables.append((state, name, len(regexes), dfa))
+    WriteArray(out, 'const char* const %sRegexes[]' % name,
+               [CString(r) for r in regexes], 1)
+    WriteArray(out, 'const uint8 %sByteClasses[256]' % name,
+               dfa['byte_classes'], 16)
+    WriteArray(out, 'const uint16 %sTransitions[]' % name,
+               [t for row in dfa['transitions'] for t in row],
+               dfa['class_count'])
+    WriteArray(out, 'const int16 %sAccept[]' % name, dfa['accept'], 16)
+    WriteArray(out, 'const int16 %sAcceptAtWordBoundary[]' % name,
+               dfa['accept_at_word_boundary'], 16)
+    WriteArray(out, 'const int16 %sMinLive[]' % name, dfa['min_live'], 16)
+
+  out.write('}  // namespace\n\n')
+  out.write('extern const LexerTable %sTables[] = {\n' % prefix)
+  for state, name, rule_count, dfa in tables:
+    out.write('  {\n')
+    out.write('    "%s",\n' % state)
+    out.write('    %d,\n' % rule_count)
+    out.write('    %sRegexes,\n' % name)
+    out.write('    %d,\n' % len(dfa['transitions']))
+    out.write('    %d,\n' % dfa['class_count'])
+    out.write('    %sByteClasses,\n' % name)
+    out.write('    %sTransitions,\n' % name)
+    out.write('    %sAccept,\n' % name)
+    out.write('    %sAcceptAtWordBoundary,\n' % name)
+    out.write('    %sMinLive,\n' % name)
+    out.write('  },\n')
+  out.write('};\n\n')
+  out.write('extern const size_t %sTableCount = %d;\n' % (prefix, len(tables)))
+  out.write('extern const uint32 %sVersion = 0x%08x;\n' % (
+      prefix, HashTokenDefinitions(source)))
+  out.close()
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
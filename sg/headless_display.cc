@@ -0,0 +1,233 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/headless_display.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/string_number_conversions.h"
+#include "base/stringprintf.h"
+#include "base/utf_string_conversions.h"
+
+HeadlessDisplay::HeadlessDisplay()
+    : stop_count_(0),
+      updated_stop_count_(0),
+      exited_(false),
+      line_number_(0),
+      thread_id_(0) {
+  locals_[""] = LocalsNode();
+}
+
+HeadlessDisplay::~HeadlessDisplay() {
+}
+
+std::string HeadlessDisplay::TakeStopJson() {
+  std::string json = "{\"event\":\"stop\",\"stop\":" +
+                     base::IntToString(stop_count_) +
+                     ",\"thread\":" + base::IntToString(thread_id_) +
+                     ",\"line\":" + base::IntToString(line_number_) +
+                     ",\"frames\":[";
+  for (size_t i = 0; i < frames_.size(); ++i) {
+    const FrameData& frame = frames_[i];
+    if (i > 0)
+      json += ",";
+    json += base::StringPrintf(
+        "{\"address\":\"0x%llx\",\"function\":",
+        static_cast<unsigned long long>(frame.address));
+    json += ToJsonString(frame.function) +
+            ",\"file\":" + ToJsonString(frame.filename) +
+            ",\"line\":" + base::IntToString(frame.line_number) + "}";
+  }
+  json += "],\"locals\":";
+  AppendLocalsJson("", &json);
+  json += ",\"output\":" + ToJsonString(output_) + "}\n";
+  output_.clear();
+  return json;
+}
+
+std::string HeadlessDisplay::TakeExitedJson() {
+  DCHECK(exited_);
+  std::string json = "{\"event\":\"exited\",\"exit_code\":" +
+                     base::IntToString(exited_data_.exit_code);
+  if (!exited_data_.signal_name.empty())
+    json += ",\"signal\":" + ToJsonString(exited_data_.signal_name);
+  json += ",\"output\":" + ToJsonString(output_) + "}\n";
+  output_.clear();
+  return json;
+}
+
+void HeadlessDisplay::AppendLocalsJson(const std::string& id,
+                                       std::string* json) const {
+  std::map<std::string, LocalsNode>::const_iterator it = locals_.find(id);
+  DCHECK(it != locals_.end());
+  *json += "[";
+  for (size_t i = 0; i < it->second.children.size(); ++i) {
+    const std::string& child_id = it->second.children[i];
+    const LocalsNode& child = locals_.find(child_id)->second;
+    if (i > 0)
+      *json += ",";
+    *json += "{\"name\":" + ToJsonString(child.expression) +
+             ",\"type\":" + ToJsonString(child.type) +
+             ",\"value\":" + ToJsonString(child.value) +
+             ",\"has_children\":" +
+             (child.has_children ? "true" : "false");
+    // Only those the presenter has been asked to expand.
+    if (!child.children.empty()) {
+      *json += ",\"children\":";
+      AppendLocalsJson(child_id, json);
+    }
+    *json += "}";
+  }
+  *json += "]";
+}
+
+void HeadlessDisplay::SetFileName(const string16& filename) {
+}
+
+void HeadlessDisplay::SetFileData(const std::string& utf8_text,
+                                  uint64 contents_hash) {
+}
+
+void HeadlessDisplay::SetProgramCounterLine(int line_number) {
+  // Called for every stop, before the stack and locals are requested.
+  line_number_ = line_number;
+  ++stop_count_;
+}
+
+void HeadlessDisplay::SetProcessExited(const ProcessExitedData& data) {
+  exited_ = true;
+  exited_data_ = data;
+  if (!changed_.is_null())
+    changed_.Run();
+}
+
+void HeadlessDisplay::SetStackData(const std::vector<FrameData>& frame_data,
+                                   int active) {
+  frames_ = frame_data;
+}
+
+void HeadlessDisplay::PassiveDisplaysUpdated() {
+  updated_stop_count_ = stop_count_;
+  if (!changed_.is_null())
+    changed_.Run();
+}
+
+void HeadlessDisplay::UpdateThreads(const RetrievedThreadsData& data) {
+}
+
+void HeadlessDisplay::SetThreadsRunning(const ThreadsRunningData& data) {
+}
+
+void HeadlessDisplay::SetCurrentThread(ThreadId thread_id) {
+  thread_id_ = thread_id;
+}
+
+void HeadlessDisplay::SetBreakpoints(const BreakpointList* breakpoints) {
+}
+
+void HeadlessDisplay::BreakpointsChanged() {
+}
+
+void HeadlessDisplay::SetProfileData(const ProfileData& data) {
+}
+
+void HeadlessDisplay::AddTracepointOutput(const TracepointOutputData& data) {
+  for (size_t i = 0; i < data.hits.size(); ++i)
+    output_ += data.hits[i].text + L"\n";
+}
+
+void HeadlessDisplay::AddLocalsChild(
+    const std::string& parent_id, const std::string& child_id) {
+  DCHECK(locals_.find(parent_id) != locals_.end());
+  DCHECK(locals_.find(child_id) == locals_.end());
+  locals_[parent_id].children.push_back(child_id);
+  locals_[child_id].parent = parent_id;
+}
+
+void HeadlessDisplay::SetLocalsNodeData(
+    const std::string& id,
+    const string16* expression,
+    const string16* value,
+    const string16* type,
+    const bool* has_children) {
+  std::map<std::string, LocalsNode>::iterator it = locals_.find(id);
+  // Replies for a variable that's gone already.
+  if (it == locals_.end())
+    return;
+  LocalsNode& node = it->second;
+  if (expression)
+    node.expression = *expression;
+  if (value)
+    node.value = *value;
+  if (type)
+    node.type = *type;
+  if (has_children)
+    node.has_children = *has_children;
+}
+
+void HeadlessDisplay::RemoveLocalsNode(const std::string& id) {
+  std::map<std::string, LocalsNode>::iterator it = locals_.find(id);
+  if (it == locals_.end())
+    return;
+  std::vector<std::string> children = it->second.children;
+  for (size_t i = 0; i < children.size(); ++i)
+    RemoveLocalsNode(children[i]);
+  std::vector<std::string>& siblings = locals_[it->second.parent].children;
+  siblings.erase(std::remove(siblings.begin(), siblings.end(), id),
+                 siblings.end());
+  locals_.erase(id);
+}
+
+int HeadlessDisplay::GetLocalsChildCount(const std::string& id) {
+  std::map<std::string, LocalsNode>::const_iterator it = locals_.find(id);
+  return it == locals_.end() ? 0 :
+                               static_cast<int>(it->second.children.size());
+}
+
+std::string HeadlessDisplay::GetLocalsIdOfChild(
+    const std::string& parent_id, int child_index) {
+  return locals_[parent_id].children[child_index];
+}
+
+void HeadlessDisplay::AddOutput(const string16& text) {
+  output_ += text;
+}
+
+void HeadlessDisplay::AddLog(const string16& text) {
+}
+
+void HeadlessDisplay::SetRenderTime(double ms_per_frame) {
+}
+
+std::string ToJsonString(const string16& text) {
+  std::string utf8 = UTF16ToUTF8(text);
+  std::string result = "\"";
+  for (size_t i = 0; i < utf8.size(); ++i) {
+    unsigned char c = utf8[i];
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (c < 0x20)
+          result += base::StringPrintf("\\u%04x", c);
+        else
+          result += c;
+    }
+  }
+  return result + "\"";
+}
@@ -0,0 +1,102 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_HEADLESS_DISPLAY_H_
+#define SG_HEADLESS_DISPLAY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "sg/debug_presenter_display.h"
+
+// A DebugPresenterDisplay that draws nothing, and keeps what it's told so
+// that a scripted session can write out the state at each stop as JSON.
+class HeadlessDisplay : public DebugPresenterDisplay {
+ public:
+  HeadlessDisplay();
+  virtual ~HeadlessDisplay();
+
+  // Run when everything for a stop has arrived, and when the target exits.
+  void set_changed_callback(const base::Closure& changed) {
+    changed_ = changed;
+  }
+
+  // Stops so far, and how many of them have everything the stop JSON needs.
+  int stop_count() const { return stop_count_; }
+  int updated_stop_count() const { return updated_stop_count_; }
+  bool exited() const { return exited_; }
+
+  // One line of JSON with the current thread, the stack, the locals, and
+  // any output since the last one.
+  std::string TakeStopJson();
+  std::string TakeExitedJson();
+
+  // Implementation of DebugPresenterDisplay:
+  virtual void SetFileName(const string16& filename) OVERRIDE;
+  virtual void SetFileData(const std::string& utf8_text,
+                           uint64 contents_hash) OVERRIDE;
+  virtual void SetProgramCounterLine(int line_number) OVERRIDE;
+  virtual void SetProcessExited(const ProcessExitedData& data) OVERRIDE;
+  virtual void SetStackData(const std::vector<FrameData>& frame_data,
+                            int active) OVERRIDE;
+  virtual void PassiveDisplaysUpdated() OVERRIDE;
+  virtual void UpdateThreads(const RetrievedThreadsData& data) OVERRIDE;
+  virtual void SetThreadsRunning(const ThreadsRunningData& data) OVERRIDE;
+  virtual void SetCurrentThread(ThreadId thread_id) OVERRIDE;
+  virtual void SetBreakpoints(const BreakpointList* breakpoints) OVERRIDE;
+  virtual void BreakpointsChanged() OVERRIDE;
+  virtual void SetProfileData(const ProfileData& data) OVERRIDE;
+  virtual void AddTracepointOutput(const TracepointOutputData& data) OVERRIDE;
+  virtual void AddLocalsChild(
+      const std::string& parent_id, const std::string& child_id) OVERRIDE;
+  virtual void SetLocalsNodeData(
+      const std::string& id,
+      const string16* expression,
+      const string16* value,
+      const string16* type,
+      const bool* has_children) OVERRIDE;
+  virtual void RemoveLocalsNode(const std::string& id) OVERRIDE;
+  virtual int GetLocalsChildCount(const std::string& id) OVERRIDE;
+  virtual std::string GetLocalsIdOfChild(
+      const std::string& parent_id, int child_index) OVERRIDE;
+  virtual void AddOutput(const string16& text) OVERRIDE;
+  virtual void AddLog(const string16& text) OVERRIDE;
+  virtual void SetRenderTime(double ms_per_frame) OVERRIDE;
+
+ private:
+  struct LocalsNode {
+    LocalsNode() : has_children(false) {}
+    string16 expression;
+    string16 value;
+    string16 type;
+    bool has_children;
+    std::string parent;
+    std::vector<std::string> children;
+  };
+
+  void AppendLocalsJson(const std::string& id, std::string* json) const;
+
+  base::Closure changed_;
+  int stop_count_;
+  int updated_stop_count_;
+  bool exited_;
+  ProcessExitedData exited_data_;
+
+  int line_number_;
+  ThreadId thread_id_;
+  std::vector<FrameData> frames_;
+  // By id. The root, "", is always there.
+  std::map<std::string, LocalsNode> locals_;
+  string16 output_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeadlessDisplay);
+};
+
+// |text| as a quoted and escaped JSON string.
+std::string ToJsonString(const string16& text);
+
+#endif  // SG_HEADLESS_DISPLAY_H_
@@ -0,0 +1,114 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/headless_display.h"
+
+#include <gtest/gtest.h>
+
+#include "base/bind.h"
+#include "sg/headless_script.h"
+
+namespace {
+
+void Increment(int* count) {
+  ++*count;
+}
+
+}  // namespace
+
+TEST(HeadlessDisplay, StopJson) {
+  HeadlessDisplay display;
+  int changes = 0;
+  display.set_changed_callback(base::Bind(&Increment, &changes));
+  display.SetProgramCounterLine(12);
+  display.SetCurrentThread(1);
+  std::vector<FrameData> frames(1);
+  frames[0].address = 0x40139b;
+  frames[0].function = L"SubFunction";
+  frames[0].filename = L"test_binary.cc";
+  frames[0].line_number = 12;
+  display.SetStackData(frames, 0);
+  EXPECT_EQ(1, display.stop_count());
+  EXPECT_EQ(0, display.updated_stop_count());
+  EXPECT_EQ(0, changes);
+
+  string16 x = L"x", s = L"s", int_type = L"int", value = L"5";
+  string16 quoted = L"0x404000 \"a\\tb\"";
+  bool no = false, yes = true;
+  display.AddLocalsChild("", "V0");
+  display.SetLocalsNodeData("V0", &x, NULL, NULL, NULL);
+  display.SetLocalsNodeData("V0", NULL, &value, &int_type, &no);
+  display.AddLocalsChild("", "V1");
+  display.SetLocalsNodeData("V1", &s, &quoted, NULL, &yes);
+  display.AddOutput(L"hello\n");
+  display.PassiveDisplaysUpdated();
+  EXPECT_EQ(1, display.updated_stop_count());
+  EXPECT_EQ(1, changes);
+  EXPECT_EQ(
+      "{\"event\":\"stop\",\"stop\":1,\"thread\":1,\"line\":12,"
+      "\"frames\":[{\"address\":\"0x40139b\",\"function\":\"SubFunction\","
+      "\"file\":\"test_binary.cc\",\"line\":12}],"
+      "\"locals\":[{\"name\":\"x\",\"type\":\"int\",\"value\":\"5\","
+      "\"has_children\":false},"
+      "{\"name\":\"s\",\"type\":\"\",\"value\":\"0x404000 \\\"a\\\\tb\\\"\","
+      "\"has_children\":true}],"
+      "\"output\":\"hello\\n\"}\n",
+      display.TakeStopJson());
+
+  // Output's only written once, and removed locals are gone.
+  display.RemoveLocalsNode("V0");
+  EXPECT_EQ(1, display.GetLocalsChildCount(""));
+  EXPECT_EQ("V1", display.GetLocalsIdOfChild("", 0));
+  std::string json = display.TakeStopJson();
+  EXPECT_NE(std::string::npos, json.find("\"output\":\"\""));
+  EXPECT_EQ(std::string::npos, json.find("\"x\""));
+
+  ProcessExitedData exited;
+  exited.exit_code = 0;
+  exited.signal_name = L"SIGSEGV";
+  display.SetProcessExited(exited);
+  EXPECT_TRUE(display.exited());
+  EXPECT_EQ(2, changes);
+  EXPECT_EQ("{\"event\":\"exited\",\"exit_code\":0,\"signal\":\"SIGSEGV\","
+            "\"output\":\"\"}\n",
+            display.TakeExitedJson());
+}
+
+TEST(HeadlessDisplay, ParseScript) {
+  std::vector<HeadlessCommand> commands;
+  string16 error;
+  ASSERT_TRUE(ParseHeadlessScript(
+      "# Reproduce the crash.\n"
+      "break C:/src/foo.cc:12\n"
+      "\n"
+      "start\n"
+      "next\n"
+      "step 10\r\n"
+      "until i > 100\n"
+      "finish\n"
+      "continue\n",
+      &commands, &error));
+  ASSERT_EQ(7, commands.size());
+  EXPECT_EQ(HeadlessCommand::BREAK, commands[0].type);
+  EXPECT_EQ(L"C:/src/foo.cc", commands[0].filename);
+  EXPECT_EQ(12, commands[0].line_number);
+  EXPECT_EQ(HeadlessCommand::START, commands[1].type);
+  EXPECT_EQ(HeadlessCommand::NEXT, commands[2].type);
+  EXPECT_EQ(1, commands[2].count);
+  EXPECT_EQ(HeadlessCommand::STEP, commands[3].type);
+  EXPECT_EQ(10, commands[3].count);
+  EXPECT_EQ(HeadlessCommand::UNTIL, commands[4].type);
+  EXPECT_EQ(L"i > 100", commands[4].condition);
+  EXPECT_EQ(HeadlessCommand::FINISH, commands[5].type);
+  EXPECT_EQ(HeadlessCommand::CONTINUE, commands[6].type);
+
+  EXPECT_FALSE(ParseHeadlessScript("start\nbreak foo.cc\n", &commands,
+                                   &error));
+  EXPECT_EQ(L"line 2: can't parse \"break foo.cc\"", error);
+  EXPECT_FALSE(ParseHeadlessScript("next 0\n", &commands, &error));
+  EXPECT_FALSE(ParseHeadlessScript("finish now\n", &commands, &error));
+  EXPECT_FALSE(ParseHeadlessScript("until\n", &commands, &error));
+  EXPECT_FALSE(ParseHeadlessScript("quit\n", &commands, &error));
+  EXPECT_EQ(7, commands.size());
+}
@@ -0,0 +1,187 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Runs a debugging script against each of a list of binaries without a
+// window, several at a time, and writes what the target looked like at each
+// stop as JSON lines, one file per binary. For example, a script of
+//
+//   break test_binary.cc:12
+//   start
+//   continue
+//   next 10
+//
+// run as
+//
+//   sg_headless --script=FILE [--jobs=N] [--output-dir=DIR]
+//               [--stop-timeout-ms=MS] BINARY...
+//
+// writes DIR/0.json for the first binary, and so on. --breakpoints,
+// --tracepoints, and --non-stop apply to every session as they do in sg.
+
+#include <stdio.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/at_exit.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/file_util.h"
+#include "base/message_loop.h"
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "base/sys_info.h"
+#include "base/time.h"
+#include "base/utf_string_conversions.h"
+#include "sg/app_thread.h"
+#include "sg/headless_script.h"
+#include "sg/headless_session.h"
+#include "sg/main_loop.h"
+
+namespace {
+
+const int kDefaultStopTimeoutMs = 60000;
+
+int GetIntSwitch(const CommandLine& command_line,
+                 const char* name,
+                 int default_value) {
+  int value;
+  if (base::StringToInt(command_line.GetSwitchValueASCII(name), &value) &&
+      value > 0) {
+    return value;
+  }
+  return default_value;
+}
+
+// Keeps up to |jobs| sessions going until every binary's been run, then
+// quits the main loop.
+class HeadlessRunner {
+ public:
+  HeadlessRunner(const std::vector<HeadlessCommand>& commands,
+                 const std::vector<string16>& binaries,
+                 const base::FilePath& output_dir,
+                 int jobs,
+                 int stop_timeout_ms)
+      : commands_(commands),
+        binaries_(binaries),
+        output_dir_(output_dir),
+        jobs_(jobs),
+        stop_timeout_ms_(stop_timeout_ms),
+        next_binary_(0),
+        running_(0) {
+  }
+
+  void Start() {
+    start_time_ = base::TimeTicks::Now();
+    while (running_ < jobs_ && next_binary_ < binaries_.size())
+      StartNext();
+  }
+
+ private:
+  void StartNext() {
+    size_t index = next_binary_++;
+    std::string name = base::IntToString(static_cast<int>(index)) + ".json";
+    HeadlessSession* session = new HeadlessSession(
+        binaries_[index],
+        commands_,
+        output_dir_.AppendASCII(name),
+        stop_timeout_ms_);
+    ++running_;
+    session->Start(base::Bind(&HeadlessRunner::SessionDone,
+                              base::Unretained(this), session));
+  }
+
+  void SessionDone(HeadlessSession* session) {
+    AppThread::DeleteSoon(AppThread::UI, FROM_HERE, session);
+    --running_;
+    if (next_binary_ < binaries_.size()) {
+      StartNext();
+      return;
+    }
+    if (running_ > 0)
+      return;
+    double seconds = (base::TimeTicks::Now() - start_time_).InSecondsF();
+    printf("%d sessions in %.2fs (%.1f sessions/minute)\n",
+           static_cast<int>(binaries_.size()), seconds,
+           binaries_.size() * 60 / seconds);
+    MessageLoopForUI::current()->Quit();
+  }
+
+  std::vector<HeadlessCommand> commands_;
+  std::vector<string16> binaries_;
+  base::FilePath output_dir_;
+  int jobs_;
+  int stop_timeout_ms_;
+
+  size_t next_binary_;
+  int running_;
+  base::TimeTicks start_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeadlessRunner);
+};
+
+int RunHeadless() {
+  const CommandLine& command_line = *CommandLine::ForCurrentProcess();
+  base::FilePath script_path = command_line.GetSwitchValuePath("script");
+  if (script_path.empty() || command_line.GetArgs().empty()) {
+    fprintf(stderr,
+            "usage: sg_headless --script=FILE [--jobs=N] [--output-dir=DIR] "
+            "[--stop-timeout-ms=MS] BINARY...\n");
+    return 1;
+  }
+
+  std::string script;
+  if (!file_util::ReadFileToString(script_path, &script)) {
+    fprintf(stderr, "couldn't read %s\n",
+            script_path.AsUTF8Unsafe().c_str());
+    return 1;
+  }
+  std::vector<HeadlessCommand> commands;
+  string16 error;
+  if (!ParseHeadlessScript(script, &commands, &error)) {
+    fprintf(stderr, "%s: %s\n", script_path.AsUTF8Unsafe().c_str(),
+            UTF16ToUTF8(error).c_str());
+    return 1;
+  }
+
+  base::FilePath output_dir = command_line.GetSwitchValuePath("output-dir");
+  if (output_dir.empty())
+    output_dir = base::FilePath(FILE_PATH_LITERAL("headless"));
+  if (!file_util::CreateDirectory(output_dir)) {
+    fprintf(stderr, "couldn't create %s\n",
+            output_dir.AsUTF8Unsafe().c_str());
+    return 1;
+  }
+
+  std::vector<string16> binaries;
+  for (size_t i = 0; i < command_line.GetArgs().size(); ++i) {
+    string16 binary;
+    ReplaceChars(command_line.GetArgs()[i], L"\\", L"/", &binary);
+    binaries.push_back(binary);
+  }
+
+  std::unique_ptr<MainLoop> main_loop(new MainLoop);
+  main_loop->Init();
+  main_loop->MainMessageLoopStart();
+  main_loop->CreateThreads();
+  HeadlessRunner runner(
+      commands,
+      binaries,
+      output_dir,
+      GetIntSwitch(command_line, "jobs", base::SysInfo::NumberOfProcessors()),
+      GetIntSwitch(command_line, "stop-timeout-ms", kDefaultStopTimeoutMs));
+  runner.Start();
+  main_loop->MainMessageLoopRun();
+  main_loop->ShutdownThreadsAndCleanUp();
+  return main_loop->GetResultCode();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  CommandLine::Init(argc, argv);
+  base::AtExitManager exit_manager;
+  return RunHeadless();
+}
@@ -0,0 +1,92 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/headless_script.h"
+
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "base/strings/string_split.h"
+#include "base/utf_string_conversions.h"
+
+namespace {
+
+bool ParseCommand(const string16& line, HeadlessCommand* command) {
+  size_t space = line.find(L' ');
+  string16 verb = line.substr(0, space);
+  string16 argument;
+  if (space != string16::npos)
+    TrimWhitespace(line.substr(space + 1), TRIM_ALL, &argument);
+
+  if (verb == L"break") {
+    // The last colon, as Windows paths have one too.
+    size_t colon = argument.rfind(L':');
+    if (colon == string16::npos || colon == 0 ||
+        !base::StringToInt(argument.substr(colon + 1),
+                           &command->line_number) ||
+        command->line_number <= 0) {
+      return false;
+    }
+    command->type = HeadlessCommand::BREAK;
+    command->filename = argument.substr(0, colon);
+    return true;
+  } else if (verb == L"until") {
+    if (argument.empty())
+      return false;
+    command->type = HeadlessCommand::UNTIL;
+    command->condition = argument;
+    return true;
+  } else if (verb == L"next" || verb == L"step") {
+    command->type = verb == L"next" ? HeadlessCommand::NEXT
+                                    : HeadlessCommand::STEP;
+    if (!argument.empty() &&
+        (!base::StringToInt(argument, &command->count) ||
+         command->count <= 0)) {
+      return false;
+    }
+    return true;
+  }
+
+  if (!argument.empty())
+    return false;
+  if (verb == L"start")
+    command->type = HeadlessCommand::START;
+  else if (verb == L"run" || verb == L"continue")
+    command->type = HeadlessCommand::CONTINUE;
+  else if (verb == L"finish")
+    command->type = HeadlessCommand::FINISH;
+  else
+    return false;
+  return true;
+}
+
+}  // namespace
+
+HeadlessCommand::HeadlessCommand()
+    : type(START),
+      line_number(0),
+      count(1) {
+}
+
+bool ParseHeadlessScript(const std::string& utf8_text,
+                         std::vector<HeadlessCommand>* commands,
+                         string16* error) {
+  std::vector<string16> lines;
+  base::SplitString(UTF8ToUTF16(utf8_text), L'\n', &lines);
+  std::vector<HeadlessCommand> result;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    string16 line;
+    TrimWhitespace(lines[i], TRIM_ALL, &line);
+    if (line.empty() || line[0] == L'#')
+      continue;
+    HeadlessCommand command;
+    if (!ParseCommand(line, &command)) {
+      *error = L"line " + base::IntToString16(static_cast<int>(i + 1)) +
+               L": can't parse \"" + line + L"\"";
+      return false;
+    }
+    result.push_back(command);
+  }
+  commands->swap(result);
+  return true;
+}
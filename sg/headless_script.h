@@ -0,0 +1,48 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_HEADLESS_SCRIPT_H_
+#define SG_HEADLESS_SCRIPT_H_
+
+#include <string>
+#include <vector>
+
+#include "sg/basex/string16.h"
+
+// One line of a headless session's script. Everything but BREAK runs the
+// target, and the session waits for it to stop (or exit) before going on.
+class HeadlessCommand {
+ public:
+  enum Type {
+    // break FILE:LINE
+    BREAK,
+    // start: run to main().
+    START,
+    // run, or continue: to the next breakpoint.
+    CONTINUE,
+    // next [COUNT], step [COUNT]: only the last stop is written.
+    NEXT,
+    STEP,
+    // finish: out of the current function.
+    FINISH,
+    // until EXPR: step over until it's true.
+    UNTIL,
+  };
+
+  HeadlessCommand();
+
+  Type type;
+  string16 filename;
+  int line_number;
+  int count;
+  string16 condition;
+};
+
+// One command per line, ignoring blank lines and those starting with #.
+// On failure, |error| says which line is wrong.
+bool ParseHeadlessScript(const std::string& utf8_text,
+                         std::vector<HeadlessCommand>* commands,
+                         string16* error);
+
+#endif  // SG_HEADLESS_SCRIPT_H_
@@ -0,0 +1,177 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/headless_session.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/logging.h"
+#include "base/string_number_conversions.h"
+#include "base/utf_string_conversions.h"
+#include "sg/app_thread.h"
+#include "sg/backend/debug_core_gdb.h"
+#include "sg/debug_presenter.h"
+#include "sg/headless_display.h"
+#include "sg/source_files.h"
+
+namespace {
+
+// The most steps "until" takes looking for its condition to be true.
+const int kUntilMaxSteps = 10000;
+
+void WriteOutputOnFILE(const base::FilePath& path, const std::string& text) {
+  file_util::WriteFile(path, text.data(), text.size());
+}
+
+}  // namespace
+
+HeadlessSession::HeadlessSession(const string16& binary,
+                                 const std::vector<HeadlessCommand>& commands,
+                                 const base::FilePath& output_path,
+                                 int stop_timeout_ms)
+    : binary_(binary),
+      commands_(commands),
+      next_command_(0),
+      output_path_(output_path),
+      stop_timeout_(base::TimeDelta::FromMilliseconds(stop_timeout_ms)),
+      waiting_(false),
+      wait_stop_count_(0),
+      wait_id_(0) {
+}
+
+HeadlessSession::~HeadlessSession() {
+}
+
+void HeadlessSession::Start(const base::Closure& done) {
+  done_ = done;
+  source_files_.reset(new SourceFiles);
+  display_.reset(new HeadlessDisplay);
+  display_->set_changed_callback(
+      base::Bind(&HeadlessSession::DisplayChanged, base::Unretained(this)));
+  presenter_.reset(new DebugPresenter(source_files_.get()));
+  presenter_->SetBinary(binary_);
+  presenter_->SetDisplay(display_.get());
+  AppThread::PostTaskAndReplyWithResult(
+      AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::Create),
+      base::Bind(&HeadlessSession::ConnectDebugCore, base::Unretained(this)));
+}
+
+void HeadlessSession::ConnectDebugCore(
+    base::WeakPtr<DebugCoreGdb> debug_core) {
+  debug_core_ = debug_core;
+  presenter_->SetDebugCore(debug_core);
+  RunNextCommand();
+}
+
+void HeadlessSession::RunNextCommand() {
+  while (next_command_ < commands_.size()) {
+    const HeadlessCommand& command = commands_[next_command_++];
+    if (command.type == HeadlessCommand::BREAK) {
+      presenter_->NotifyBreakpointToggled(command.filename,
+                                          command.line_number);
+      continue;
+    }
+
+    bool started = display_->stop_count() > 0;
+    wait_stop_count_ = display_->stop_count();
+    switch (command.type) {
+      case HeadlessCommand::START:
+        presenter_->RunToMain();
+        break;
+      case HeadlessCommand::CONTINUE:
+        presenter_->Continue();
+        break;
+      case HeadlessCommand::NEXT:
+      case HeadlessCommand::STEP:
+        // Before the first stop, a single step runs to main() instead, and
+        // so does a loop.
+        if (command.count > 1 && started) {
+          presenter_->StepRepeatedly(command.type == HeadlessCommand::STEP,
+                                     command.count, string16());
+        } else if (command.type == HeadlessCommand::STEP) {
+          presenter_->StepIn();
+        } else {
+          presenter_->StepOver();
+        }
+        break;
+      case HeadlessCommand::FINISH:
+      case HeadlessCommand::UNTIL:
+        if (!started) {
+          WriteEvent("error", "not stopped in the target");
+          Finish();
+          return;
+        }
+        if (command.type == HeadlessCommand::FINISH) {
+          presenter_->StepOut();
+        } else {
+          presenter_->StepRepeatedly(false, kUntilMaxSteps,
+                                     command.condition);
+        }
+        break;
+      case HeadlessCommand::BREAK:
+        NOTREACHED();
+    }
+    waiting_ = true;
+    AppThread::PostDelayedTask(AppThread::UI, FROM_HERE,
+        base::Bind(&HeadlessSession::StopTimedOut, AsWeakPtr(), ++wait_id_),
+        stop_timeout_);
+    return;
+  }
+  Finish();
+}
+
+void HeadlessSession::DisplayChanged() {
+  if (!waiting_)
+    return;
+  if (display_->exited()) {
+    waiting_ = false;
+    output_ += display_->TakeExitedJson();
+    Finish();
+  } else if (display_->updated_stop_count() > wait_stop_count_) {
+    waiting_ = false;
+    output_ += display_->TakeStopJson();
+    RunNextCommand();
+  }
+}
+
+void HeadlessSession::StopTimedOut(int wait_id) {
+  if (!waiting_ || wait_id != wait_id_)
+    return;
+  waiting_ = false;
+  WriteEvent("timeout", "no stop after " +
+             base::Int64ToString(stop_timeout_.InMilliseconds()) + "ms");
+  Finish();
+}
+
+void HeadlessSession::WriteEvent(const std::string& event,
+                                 const std::string& message) {
+  // |next_command_| is one past the command's index, so it's numbered
+  // from 1.
+  output_ += "{\"event\":\"" + event + "\",\"command\":" +
+             base::IntToString(static_cast<int>(next_command_)) +
+             ",\"message\":" + ToJsonString(ASCIIToUTF16(message)) + "}\n";
+}
+
+void HeadlessSession::Finish() {
+  // Notifications the backend posted before it went away arrive before the
+  // reply, so nothing's left for the presenter by then.
+  AppThread::PostTask(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::StopDebugging, debug_core_));
+  AppThread::PostTaskAndReply(AppThread::BACKEND, FROM_HERE,
+      base::Bind(&DebugCoreGdb::DeleteSelf, debug_core_),
+      base::Bind(&HeadlessSession::DebugCoreDeleted, base::Unretained(this)));
+}
+
+void HeadlessSession::DebugCoreDeleted() {
+  // Also after any source file reads the presenter has started.
+  AppThread::PostTaskAndReply(AppThread::FILE, FROM_HERE,
+      base::Bind(&WriteOutputOnFILE, output_path_, output_),
+      base::Bind(&HeadlessSession::OutputWritten, base::Unretained(this)));
+}
+
+void HeadlessSession::OutputWritten() {
+  presenter_.reset();
+  done_.Run();
+}
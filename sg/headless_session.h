@@ -0,0 +1,79 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_HEADLESS_SESSION_H_
+#define SG_HEADLESS_SESSION_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time.h"
+#include "sg/headless_script.h"
+
+class DebugCoreGdb;
+class DebugPresenter;
+class HeadlessDisplay;
+class SourceFiles;
+
+// Runs a script against one binary with its own gdb, without a window, and
+// writes a line of JSON for each stop (and the exit) to |output_path|. Any
+// number can run at once; they only share the threads. Lives on UI.
+class HeadlessSession : public base::SupportsWeakPtr<HeadlessSession> {
+ public:
+  // A stop is written once the presenter has everything for it. A command
+  // that hasn't stopped within |stop_timeout_ms| ends the session.
+  HeadlessSession(const string16& binary,
+                  const std::vector<HeadlessCommand>& commands,
+                  const base::FilePath& output_path,
+                  int stop_timeout_ms);
+  ~HeadlessSession();
+
+  // |done| is called once the output's written and gdb is gone, after
+  // which this can be deleted.
+  void Start(const base::Closure& done);
+
+ private:
+  void ConnectDebugCore(base::WeakPtr<DebugCoreGdb> debug_core);
+
+  // Runs BREAKs until one that resumes the target, or the end.
+  void RunNextCommand();
+  // From the display, to see whether the stop (or exit) that the last
+  // command is waiting for has arrived.
+  void DisplayChanged();
+  void StopTimedOut(int wait_id);
+  void WriteEvent(const std::string& event, const std::string& message);
+
+  void Finish();
+  void DebugCoreDeleted();
+  void OutputWritten();
+
+  string16 binary_;
+  std::vector<HeadlessCommand> commands_;
+  size_t next_command_;
+  base::FilePath output_path_;
+  base::TimeDelta stop_timeout_;
+  base::Closure done_;
+
+  std::unique_ptr<SourceFiles> source_files_;
+  std::unique_ptr<HeadlessDisplay> display_;
+  std::unique_ptr<DebugPresenter> presenter_;
+  base::WeakPtr<DebugCoreGdb> debug_core_;
+
+  // While a command's waiting for a stop, and the display's stop count
+  // before it. |wait_id_| tells a timeout for an earlier command apart.
+  bool waiting_;
+  int wait_stop_count_;
+  int wait_id_;
+
+  std::string output_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeadlessSession);
+};
+
+#endif  // SG_HEADLESS_SESSION_H_
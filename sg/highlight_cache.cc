@@ -0,0 +1,150 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/highlight_cache.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/file_util.h"
+#include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
+#include "base/stringprintf.h"
+#include "sg/cache_util.h"
+#include "sg/cpp_lexer.h"
+#include "sg/syntax_highlight.h"
+
+namespace {
+
+// Bump when the layout changes.
+const uint32 kVersion = 1;
+const char kMagic[8] = { 'S', 'G', 'H', 'L', 'C', 'C', 'H', 'E' };
+
+// The runs are stored as they are in memory.
+COMPILE_ASSERT(sizeof(ColorRun) == 12, color_run_has_no_padding);
+
+// Trim() deletes the least recently written beyond this.
+const int64 kMaxBytes = 64 * 1024 * 1024;
+
+// As HighlightedText counts them: a newline at the end doesn't start
+// another line.
+size_t CountLines(const std::string& contents) {
+  if (contents.empty())
+    return 0;
+  return std::count(contents.begin(), contents.end() - 1, '\n') + 1;
+}
+
+}  // namespace
+
+// Followed by line_count + 1 uint32 indices of each line's first run, then
+// run_count ColorRuns.
+struct HighlightCache::FileHeader {
+  char magic[8];
+  uint32 version;
+  uint32 lexer_version;
+  uint64 contents_hash;
+  uint64 contents_size;
+  uint32 line_count;
+  uint32 run_count;
+};
+
+HighlightCache::HighlightCache(const base::FilePath& directory)
+    : directory_(directory) {
+}
+
+// static
+uint64 HighlightCache::HashContents(const std::string& contents) {
+  uint64 hash = HashBytes(contents.data(), contents.size());
+  return hash ? hash : 1;
+}
+
+bool HighlightCache::Load(uint64 contents_hash,
+                          const std::string& contents,
+                          HighlightedLines* lines) const {
+  base::MemoryMappedFile file;
+  if (directory_.empty() ||
+      !file.Initialize(GetPath(contents_hash)) ||
+      file.length() < sizeof(FileHeader)) {
+    return false;
+  }
+  const FileHeader* header = reinterpret_cast<const FileHeader*>(file.data());
+  size_t line_count = CountLines(contents);
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      header->version != kVersion ||
+      header->lexer_version != kCppLexerVersion ||
+      header->contents_hash != contents_hash ||
+      header->contents_size != contents.size() ||
+      header->line_count != line_count ||
+      file.length() != sizeof(FileHeader) +
+                           (line_count + 1) * sizeof(uint32) +
+                           header->run_count * sizeof(ColorRun)) {
+    return false;
+  }
+  const uint32* line_runs = reinterpret_cast<const uint32*>(header + 1);
+  const ColorRun* runs =
+      reinterpret_cast<const ColorRun*>(line_runs + line_count + 1);
+  // A damaged file mustn't send SetLines() out of bounds.
+  if (line_runs[0] != 0 || line_runs[line_count] != header->run_count)
+    return false;
+  for (size_t i = 0; i < line_count; ++i) {
+    if (line_runs[i] > line_runs[i + 1])
+      return false;
+  }
+  for (size_t i = 0; i < header->run_count; ++i) {
+    if (runs[i].type < 0 || runs[i].type >= Lexer::Invalid)
+      return false;
+  }
+  lines->first_line = 0;
+  lines->line_runs.assign(line_runs, line_runs + line_count + 1);
+  lines->runs.assign(runs, runs + header->run_count);
+  return true;
+}
+
+bool HighlightCache::Store(uint64 contents_hash,
+                           const std::string& contents,
+                           const HighlightedLines& lines) const {
+  DCHECK_EQ(0u, lines.first_line);
+  DCHECK_EQ(CountLines(contents) + 1, lines.line_runs.size());
+  if (directory_.empty())
+    return false;
+  FileHeader header = {};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.lexer_version = kCppLexerVersion;
+  header.contents_hash = contents_hash;
+  header.contents_size = contents.size();
+  header.line_count = static_cast<uint32>(lines.line_runs.size() - 1);
+  header.run_count = static_cast<uint32>(lines.runs.size());
+  std::string data;
+  data.reserve(sizeof(header) + lines.line_runs.size() * sizeof(uint32) +
+               lines.runs.size() * sizeof(ColorRun));
+  data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  data.append(reinterpret_cast<const char*>(&lines.line_runs[0]),
+              lines.line_runs.size() * sizeof(uint32));
+  if (!lines.runs.empty()) {
+    data.append(reinterpret_cast<const char*>(&lines.runs[0]),
+                lines.runs.size() * sizeof(ColorRun));
+  }
+  return file_util::CreateDirectory(directory_) &&
+         WriteFileAtomically(GetPath(contents_hash), data);
+}
+
+void HighlightCache::Trim() const {
+  if (!directory_.empty())
+    TrimCacheDirectory(directory_, FILE_PATH_LITERAL("*.highlight"), kMaxBytes);
+}
+
+// static
+base::FilePath HighlightCache::GetDefaultDirectory() {
+  base::FilePath directory = GetCacheDirectory();
+  if (directory.empty())
+    return base::FilePath();
+  return directory.AppendASCII("highlight");
+}
+
+base::FilePath HighlightCache::GetPath(uint64 contents_hash) const {
+  return directory_.AppendASCII(base::StringPrintf(
+      "%016llx.highlight", static_cast<unsigned long long>(contents_hash)));
+}
@@ -0,0 +1,61 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_HIGHLIGHT_CACHE_H_
+#define SG_HIGHLIGHT_CACHE_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/files/file_path.h"
+
+struct HighlightedLines;
+
+// Remembers the colors of source files across sessions, so that opening one
+// that's been highlighted before doesn't lex it again. Each file's colors
+// are kept in a file of their own in the cache directory, named by a hash
+// of its contents, and laid out as HighlightedLines' arrays are, so that
+// they can be read straight from a mapping. Colors saved by another version
+// of the C++ lexer aren't used. Trim() keeps the directory from growing
+// without bound.
+//
+// It only holds the directory, so can be copied to another thread.
+class HighlightCache {
+ public:
+  explicit HighlightCache(const base::FilePath& directory);
+
+  // The key for |contents|. Never 0, which is used for text that isn't
+  // cached.
+  static uint64 HashContents(const std::string& contents);
+
+  // Gets the colors of all the lines of |contents|, whose hash is
+  // |contents_hash|, into |lines|. Returns false if they weren't saved, or
+  // were saved for something else.
+  bool Load(uint64 contents_hash,
+            const std::string& contents,
+            HighlightedLines* lines) const;
+  // Saves |lines|, the colors of all the lines of |contents|, replacing any
+  // that were saved for it before.
+  bool Store(uint64 contents_hash,
+             const std::string& contents,
+             const HighlightedLines& lines) const;
+
+  // Deletes the least recently saved files until the rest fit in the size
+  // the cache is allowed.
+  void Trim() const;
+
+  const base::FilePath& directory() const { return directory_; }
+
+  // Where the cache lives by default, in the user's cache directory.
+  static base::FilePath GetDefaultDirectory();
+
+ private:
+  struct FileHeader;
+
+  base::FilePath GetPath(uint64 contents_hash) const;
+
+  base::FilePath directory_;
+};
+
+#endif  // SG_HIGHLIGHT_CACHE_H_
@@ -0,0 +1,87 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/highlight_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "base/file_util.h"
+#include "sg/syntax_highlight.h"
+
+namespace {
+
+const base::FilePath::CharType kCacheDirectory[] =
+    FILE_PATH_LITERAL("out/highlight_cache_test");
+
+// Two lines, with colors that aren't what lexing would give, to be sure
+// they came from the cache.
+void MakeLines(HighlightedLines* lines) {
+  lines->first_line = 0;
+  lines->runs.clear();
+  ColorRun run = { Lexer::Keyword, 0, 3 };
+  lines->runs.push_back(run);
+  run.type = Lexer::Name;
+  run.offset = 4;
+  run.length = 1;
+  lines->runs.push_back(run);
+  lines->line_runs.clear();
+  lines->line_runs.push_back(0);
+  lines->line_runs.push_back(2);
+  lines->line_runs.push_back(2);
+}
+
+}  // namespace
+
+TEST(HighlightCache, StoreAndLoad) {
+  base::FilePath directory(kCacheDirectory);
+  file_util::Delete(directory, true);
+  HighlightCache cache(directory);
+  std::string contents = "abc x\n\n";
+  uint64 hash = HighlightCache::HashContents(contents);
+  EXPECT_NE(0u, hash);
+
+  HighlightedLines lines;
+  EXPECT_FALSE(cache.Load(hash, contents, &lines));
+
+  HighlightedLines stored;
+  MakeLines(&stored);
+  ASSERT_TRUE(cache.Store(hash, contents, stored));
+  ASSERT_TRUE(cache.Load(hash, contents, &lines));
+  EXPECT_EQ(0u, lines.first_line);
+  ASSERT_EQ(stored.line_runs, lines.line_runs);
+  ASSERT_EQ(2u, lines.runs.size());
+  EXPECT_EQ(Lexer::Keyword, lines.runs[0].type);
+  EXPECT_EQ(Lexer::Name, lines.runs[1].type);
+  EXPECT_EQ(4u, lines.runs[1].offset);
+  EXPECT_EQ(1u, lines.runs[1].length);
+
+  // They're the colors of those contents only.
+  std::string other = "abc y\n\n";
+  EXPECT_FALSE(cache.Load(HighlightCache::HashContents(other), other, &lines));
+  EXPECT_FALSE(cache.Load(hash, "abc xy\n\n", &lines));
+  EXPECT_FALSE(cache.Load(hash, "abc x\n\n\n", &lines));
+
+  // Nowhere to keep them.
+  HighlightCache none((base::FilePath()));
+  EXPECT_FALSE(none.Store(hash, contents, stored));
+  EXPECT_FALSE(none.Load(hash, contents, &lines));
+  file_util::Delete(directory, true);
+}
+
+TEST(HighlightCache, Damaged) {
+  base::FilePath directory(kCacheDirectory);
+  file_util::Delete(directory, true);
+  HighlightCache cache(directory);
+  std::string contents = "abc x\n\n";
+  uint64 hash = HighlightCache::HashContents(contents);
+  HighlightedLines stored;
+  MakeLines(&stored);
+  stored.line_runs[1] = 3;
+  ASSERT_TRUE(cache.Store(hash, contents, stored));
+  HighlightedLines lines;
+  EXPECT_FALSE(cache.Load(hash, contents, &lines));
+  file_util::Delete(directory, true);
+}
@@ -4,44 +4,80 @@
 
 #include "sg/lexer.h"
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "sg/lexer_state.h"
 
 namespace {
 
-// Get the result of a parse from a initial and final StringPiece representing
-// the current parse locations.
-std::string GetResult(
-    const re2::StringPiece& initial,
-    const re2::StringPiece final) {
-  size_t length = final.data() - initial.data();
-  return std::string(initial.data(), length);
-}
-
 size_t GetOffset(const re2::StringPiece& before, const std::string& base) {
   return before.data() - base.data();
 }
 
-}  // namespace
+// From the first byte. Invalid bytes are taken on their own.
+size_t GetUtf8CharacterLength(char first_byte) {
+  uint8 c = static_cast<uint8>(first_byte);
+  if (c >= 0xf0 && c <= 0xf4)
+    return 4;
+  if (c >= 0xe0)
+    return c <= 0xef ? 3 : 1;
+  if (c >= 0xc2)
+    return 2;
+  return 1;
+}
 
-LexerState* Lexer::Push;
-LexerState* Lexer::Pop;
+// Whether [|begin|, |end|) of |text| is all characters that \s matches.
+bool IsBlank(const std::string& text, size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    char c = text[i];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\f' && c != '\r')
+      return false;
+  }
+  return true;
+}
 
-#ifdef _DEBUG
-// static
-void Lexer::TidyUpGlobals() {
-  delete Lexer::Push;
-  delete Lexer::Pop;
-  Lexer::Push = NULL;
-  Lexer::Pop = NULL;
-}
-#endif
-
-Lexer::Lexer(const std::string& name) : name_(name) {
-  if (!Push) {
-    Push = new LexerState("!<push>");
-    Pop = new LexerState("!<pop>");
+// Replaces [|begin|, |end|) of |v| with |replacement|, and adds |shift| to
+// the elements after. Those are only moved once, where erase() and insert()
+// would move them twice, which matters for the tokens of a large file.
+template <class T>
+void ReplaceRange(std::vector<T>* v,
+                  size_t begin,
+                  size_t end,
+                  const std::vector<T>& replacement,
+                  ptrdiff_t shift) {
+  size_t old_size = v->size();
+  size_t new_end = begin + replacement.size();
+  size_t new_size = old_size - (end - begin) + replacement.size();
+  if (new_end > end) {
+    v->resize(new_size);
+    for (size_t i = new_size; i-- > new_end;)
+      (*v)[i] = static_cast<T>((*v)[i - new_end + end] + shift);
+  } else if (new_end < end || shift != 0) {
+    for (size_t i = new_end; i < new_size; ++i)
+      (*v)[i] = static_cast<T>((*v)[i - new_end + end] + shift);
+    v->resize(new_size);
   }
+  std::copy(replacement.begin(), replacement.end(), v->begin() + begin);
+}
+
+}  // namespace
+
+namespace {
+
+// Push and Pop are only compared with, never used as states, so they just
+// need addresses of their own. These are set before any code runs, so
+// there's nothing to race on creating them.
+char g_push_pop_markers[2];
+
+}  // namespace
+
+LexerState* const Lexer::Push =
+    reinterpret_cast<LexerState*>(&g_push_pop_markers[0]);
+LexerState* const Lexer::Pop =
+    reinterpret_cast<LexerState*>(&g_push_pop_markers[1]);
+
+Lexer::Lexer(const std::string& name) : name_(name), root_(NULL) {
 }
 
 Lexer::~Lexer() {
@@ -54,55 +90,285 @@ Lexer::~Lexer() {
 LexerState* Lexer::AddState(const std::string& name) {
   LexerState* lexer_state = new LexerState(name);
   states_[name] = lexer_state;
+  if (name == "root")
+    root_ = lexer_state;
   return lexer_state;
 }
 
+void Lexer::SetTables(const LexerTable* tables, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    std::map<std::string, LexerState*>::iterator it =
+        states_.find(tables[i].state_name);
+    if (it != states_.end())
+      it->second->SetTable(&tables[i]);
+  }
+}
+
+void Lexer::GetTokens(const std::string& text, TokenSpans* output) const {
+  DCHECK(root_);
+  std::vector<LexerState*> state_stack(1, root_);
+
+  re2::StringPiece input(text);
+  std::vector<int> matches;
+  while (LexToken(text, &input, &state_stack, &matches, output)) {
+  }
+}
+
+void Lexer::GetStartPosition(size_t offset,
+                             LexerPosition* position) const {
+  DCHECK(root_);
+  position->offset = offset;
+  position->state_stack.assign(1, root_);
+}
+
+void Lexer::LexLines(const std::string& text,
+                     size_t end,
+                     LexerPosition* position,
+                     TokenSpans* output) const {
+  re2::StringPiece input(text);
+  input.remove_prefix(position->offset);
+  std::vector<int> matches;
+  for (;;) {
+    size_t offset = GetOffset(input, text);
+    if (offset >= end && (offset == 0 || text[offset - 1] == '\n'))
+      break;
+    if (!LexToken(text, &input, &position->state_stack, &matches, output))
+      break;
+  }
+  position->offset = GetOffset(input, text);
+}
+
 void Lexer::GetTokensUnprocessed(const std::string& text,
-                                 std::vector<Token>* output_tokens) {
-  std::vector<LexerState*> state_stack;
-  DCHECK(states_.find("root") != states_.end());
-  state_stack.push_back(states_["root"]);
+                                 std::vector<Token>* output_tokens) const {
+  TokenSpans spans;
+  GetTokens(text, &spans);
+  output_tokens->reserve(output_tokens->size() + spans.size());
+  for (size_t i = 0; i < spans.size(); ++i) {
+    output_tokens->push_back(Token(spans.offset(i),
+                                   spans.type(i),
+                                   text.substr(spans.offset(i),
+                                               spans.length(i))));
+  }
+}
+
+void Lexer::Lex(const std::string& text, LexedText* lexed) const {
+  DCHECK(root_);
+  lexed->text_.clear();
+  lexed->tokens_.Clear();
+  lexed->stacks_.assign(1, std::vector<LexerState*>(1, root_));
+  lexed->line_starts_.assign(1, 0);
+  lexed->line_stacks_.assign(1, 0);
+  lexed->line_tokens_.assign(1, 0);
+  RelexLines(0, 1, text, lexed, NULL, NULL);
+}
+
+void Lexer::RelexLines(size_t first_line,
+                       size_t line_count,
+                       const std::string& new_lines,
+                       LexedText* lexed,
+                       size_t* first_relexed,
+                       size_t* end_relexed) const {
+  DCHECK_LT(first_line, lexed->line_count());
+  DCHECK_LE(first_line + line_count, lexed->line_count());
+  const std::vector<uint32>& old_starts = lexed->line_starts_;
+  size_t begin = old_starts[first_line];
+  size_t end = first_line + line_count < lexed->line_count()
+                   ? old_starts[first_line + line_count]
+                   : lexed->text_.size();
+
+  // A rule starting with \s can match a token from a blank line on into the
+  // edit, e.g. ^\s*#endif in #if 0, so go back to a line with something on
+  // it. Lines that start inside a token don't have a state to start from.
+  size_t resume_line = first_line > 0 ? first_line - 1 : 0;
+  while (resume_line > 0 &&
+         IsBlank(lexed->text_,
+                 old_starts[resume_line],
+                 old_starts[resume_line + 1])) {
+    --resume_line;
+  }
+  while (lexed->line_stacks_[resume_line] == LexedText::kNoCheckpoint)
+    --resume_line;
+  size_t resume_token = lexed->line_tokens_[resume_line];
 
+  lexed->text_.replace(begin, end - begin, new_lines);
+  ptrdiff_t shift = new_lines.size() - (end - begin);
+
+  // Lines up to |first_line| start in the same place, then come those in
+  // |new_lines|, then the ones after the edit, moved along. The line after
+  // the edit is still there unless |new_lines| doesn't end with a newline.
+  // The starts are updated now, the states once they're known.
+  size_t first_old_moved_line = first_line + line_count;
+  bool keeps_next_line = first_old_moved_line < old_starts.size() &&
+                         !new_lines.empty() &&
+                         new_lines[new_lines.size() - 1] == '\n';
+  std::vector<uint32> new_starts;
+  for (size_t i = 0; i + 1 < new_lines.size(); ++i) {
+    if (new_lines[i] == '\n')
+      new_starts.push_back(static_cast<uint32>(begin + i + 1));
+  }
+  if (!keeps_next_line) {
+    if (!new_lines.empty() && new_lines[new_lines.size() - 1] == '\n')
+      new_starts.push_back(static_cast<uint32>(begin + new_lines.size()));
+    first_old_moved_line =
+        std::upper_bound(old_starts.begin(), old_starts.end(), end) -
+        old_starts.begin();
+  }
+  size_t resume_offset = old_starts[resume_line];
+  ReplaceRange(&lexed->line_starts_,
+               first_line + 1, first_old_moved_line,
+               new_starts,
+               shift);
+  const std::vector<uint32>& line_starts = lexed->line_starts_;
+  size_t first_moved_line = first_line + 1 + new_starts.size();
+  ptrdiff_t line_shift = first_moved_line - first_old_moved_line;
+
+  const std::string& text = lexed->text_;
+  std::vector<LexerState*> state_stack(
+      lexed->stacks_[lexed->line_stacks_[resume_line]]);
   re2::StringPiece input(text);
+  input.remove_prefix(resume_offset);
+  std::vector<int> matches;
+  TokenSpans relexed;
+  std::vector<int> relexed_stacks;
+  std::vector<uint32> relexed_tokens;
+  size_t line = resume_line;
+  size_t converged_line = line_starts.size();
   for (;;) {
-    LexerState* current_state = state_stack.back();
-    size_t token_defs_count;
-    const LexerState::TokenDef* token_defs =
-        current_state->GetTokenDefs(&token_defs_count);
-    size_t i;
-    for (i = 0; i < token_defs_count; ++i) {
-      re2::StringPiece from = input;
-      const LexerState::TokenDef* token_def = &token_defs[i];
-      if (RE2::Consume(&input, *token_def->regex)) {
-        output_tokens->push_back(Token(GetOffset(from, text),
-                                       token_def->action,
-                                       GetResult(from, input)));
-        if (token_def->new_state) {
-          if (token_def->new_state == Push) {
-            state_stack.push_back(current_state);
-          } else if (token_def->new_state == Pop) {
-            state_stack.pop_back();
-          } else {
-            // TODO(scottmg): state tuple, if needed.
-            state_stack.push_back(token_def->new_state);
-          }
+    size_t position = GetOffset(input, text);
+    for (; line < line_starts.size() && line_starts[line] < position; ++line) {
+      relexed_stacks.push_back(LexedText::kNoCheckpoint);
+      relexed_tokens.push_back(0);
+    }
+    if (line < line_starts.size() && line_starts[line] == position) {
+      if (line >= first_moved_line) {
+        int old_stack = lexed->line_stacks_[line - line_shift];
+        if (old_stack != LexedText::kNoCheckpoint &&
+            lexed->stacks_[old_stack] == state_stack) {
+          converged_line = line;
+          break;
         }
-        break;
       }
+      relexed_stacks.push_back(lexed->InternStack(state_stack));
+      relexed_tokens.push_back(
+          static_cast<uint32>(resume_token + relexed.size()));
+      ++line;
     }
-    if (i == token_defs_count) {
-      if (input.empty())
-        break;
-      // No match, if at EOL, reset to root state.
-      if (input[0] == '\n') {
-        NOTREACHED() << "todo; untested";
-        state_stack.clear();
-        state_stack.push_back(states_["root"]);
-        output_tokens->push_back(Token(GetOffset(input, text), Text, "\n"));
-        input = re2::StringPiece(input.data() + 1, input.size() - 1);
+    if (!LexToken(text, &input, &state_stack, &matches, &relexed))
+      break;
+  }
+
+  // The tokens and lines from where the states match are as they were.
+  size_t old_converged_line = lexed->line_stacks_.size();
+  size_t old_converged_token = lexed->tokens_.size();
+  if (converged_line < line_starts.size()) {
+    old_converged_line = converged_line - line_shift;
+    old_converged_token = lexed->line_tokens_[old_converged_line];
+  }
+  ReplaceRange(&lexed->line_stacks_,
+               resume_line, old_converged_line,
+               relexed_stacks,
+               0);
+  ReplaceRange(&lexed->line_tokens_,
+               resume_line, old_converged_line,
+               relexed_tokens,
+               static_cast<ptrdiff_t>(resume_token + relexed.size()) -
+                   static_cast<ptrdiff_t>(old_converged_token));
+  lexed->tokens_.Splice(resume_token, old_converged_token, relexed, shift);
+  if (first_relexed)
+    *first_relexed = resume_line;
+  if (end_relexed)
+    *end_relexed = converged_line;
+}
+
+bool Lexer::LexToken(const std::string& text,
+                     re2::StringPiece* input,
+                     std::vector<LexerState*>* state_stack,
+                     std::vector<int>* matches,
+                     TokenSpans* output) const {
+  LexerState* current_state = state_stack->back();
+  re2::StringPiece from = *input;
+  const LexerState::TokenDef* token_def =
+      current_state->Consume(input, matches);
+  if (token_def) {
+    output->Append(GetOffset(from, text),
+                   input->data() - from.data(),
+                   token_def->action);
+    if (token_def->new_state) {
+      if (token_def->new_state == Push) {
+        state_stack->push_back(current_state);
+      } else if (token_def->new_state == Pop) {
+        state_stack->pop_back();
       } else {
-        NOTREACHED() << "todo; untested, should add Error token";
+        // TODO(scottmg): state tuple, if needed.
+        state_stack->push_back(token_def->new_state);
       }
     }
+    return true;
+  }
+  if (input->empty())
+    return false;
+  // No match, if at EOL, reset to root state.
+  if ((*input)[0] == '\n') {
+    state_stack->clear();
+    state_stack->push_back(root_);
+    output->Append(GetOffset(*input, text), 1, Text);
+    input->remove_prefix(1);
+  } else {
+    // Skip a whole character so that the rest of it isn't taken as
+    // something else.
+    size_t length = std::min(GetUtf8CharacterLength((*input)[0]),
+                             static_cast<size_t>(input->size()));
+    output->Append(GetOffset(*input, text), length, Error);
+    input->remove_prefix(length);
+  }
+  return true;
+}
+
+void TokenSpans::Append(const TokenSpans& other, size_t begin, size_t end) {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, other.size());
+  offsets_.insert(offsets_.end(),
+                  other.offsets_.begin() + begin,
+                  other.offsets_.begin() + end);
+  lengths_.insert(lengths_.end(),
+                  other.lengths_.begin() + begin,
+                  other.lengths_.begin() + end);
+  types_.insert(types_.end(),
+                other.types_.begin() + begin,
+                other.types_.begin() + end);
+}
+
+void TokenSpans::Reserve(size_t count) {
+  offsets_.reserve(count);
+  lengths_.reserve(count);
+  types_.reserve(count);
+}
+
+void TokenSpans::Clear() {
+  offsets_.clear();
+  lengths_.clear();
+  types_.clear();
+}
+
+void TokenSpans::Splice(size_t begin,
+                        size_t end,
+                        const TokenSpans& replacement,
+                        ptrdiff_t shift) {
+  DCHECK_LE(begin, end);
+  DCHECK_LE(end, size());
+  ReplaceRange(&offsets_, begin, end, replacement.offsets_, shift);
+  ReplaceRange(&lengths_, begin, end, replacement.lengths_, 0);
+  ReplaceRange(&types_, begin, end, replacement.types_, 0);
+}
+
+// static
+const int LexedText::kNoCheckpoint;
+
+int LexedText::InternStack(const std::vector<LexerState*>& stack) {
+  for (size_t i = 0; i < stacks_.size(); ++i) {
+    if (stacks_[i] == stack)
+      return static_cast<int>(i);
   }
+  stacks_.push_back(stack);
+  return static_cast<int>(stacks_.size() - 1);
 }
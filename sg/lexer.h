@@ -11,23 +11,75 @@
 
 #include "base/basictypes.h"
 
+namespace re2 {
+class StringPiece;
+}
+
+class LexedText;
 class LexerState;
+struct LexerPosition;
+struct LexerTable;
 class Token;
+class TokenSpans;
 
 // This module (regex, input, parsed tokens) works entirely in utf8, even on
 // Windows, because that's what RE2 processes.
 //
-// Probably this whole thing should be something more like re2c, but this is
-// OK for now. re2c doesn't have syntax for the more complex syntax, so it'd
-// be a fair amount of reworking.
+// States can also be given a DFA generated from their regexes at build time
+// (see lexer_table.h), which is much faster than RE2 and finds the same
+// tokens. Those that can't be compiled to one keep using RE2.
 
 class Lexer {
  public:
   explicit Lexer(const std::string& name);
   ~Lexer();
   LexerState* AddState(const std::string& name);
+  // Gives states the generated tables for their token definitions, by
+  // name. States without one carry on using RE2.
+  void SetTables(const LexerTable* tables, size_t count);
+  // Appends the tokens in |text| to |output|. Text that no token
+  // definition matches is an Error token, a character at a time.
+  //
+  // Lexing doesn't change the lexer, so once its states are set up, one
+  // can be used from several threads at once.
+  void GetTokens(const std::string& text, TokenSpans* output) const;
+  // The same, with a copy of each token's text.
   void GetTokensUnprocessed(const std::string& text,
-                            std::vector<Token>* output_tokens);
+                            std::vector<Token>* output_tokens) const;
+
+  // Sets |position| to the start of the line at |offset| in the state that
+  // a text starts in. From the middle of a text, that's a guess: it's
+  // usually so, but not in a comment or #if 0.
+  void GetStartPosition(size_t offset, LexerPosition* position) const;
+  // Appends the tokens from |position| in |text| to the first line at or
+  // after |end| that doesn't start inside a token, or the end of the text,
+  // and moves |position| there. For lexing a large text a piece at a time.
+  void LexLines(const std::string& text,
+                size_t end,
+                LexerPosition* position,
+                TokenSpans* output) const;
+
+  // Lexes |text| into |lexed|, keeping the state at the start of each line
+  // so that it can be updated with RelexLines().
+  void Lex(const std::string& text, LexedText* lexed) const;
+  // Replaces |line_count| lines of |lexed| from |first_line|, each with its
+  // newline, by |new_lines|. Tokens are lexed again from the last line
+  // before with more than whitespace on it (as its tokens can depend on the
+  // start of the next, and one starting on a blank line can too) until a
+  // line after |new_lines| starts in the same state as it did before, and
+  // the rest are kept. The lines that were lexed again are returned in
+  // [|*first_relexed|, |*end_relexed|), either of which can be NULL.
+  //
+  // Like the highlighters in most editors, this assumes a rule doesn't fail
+  // because of text more than a line after the token that was matched
+  // instead; in the C++ lexer, that's only so for a /* that isn't closed
+  // until the edit.
+  void RelexLines(size_t first_line,
+                  size_t line_count,
+                  const std::string& new_lines,
+                  LexedText* lexed,
+                  size_t* first_relexed,
+                  size_t* end_relexed) const;
 
   enum TokenType {
     Comment,
@@ -58,15 +110,23 @@ class Lexer {
     Invalid,
   };
 
-  static LexerState* Push;
-  static LexerState* Pop;
-#ifdef _DEBUG
-  static void TidyUpGlobals();
-#endif
+  // Transitions that push the current state again, or pop it.
+  static LexerState* const Push;
+  static LexerState* const Pop;
 
  private:
+  // Appends the token at |input| in |text| to |output| and moves past it,
+  // following its transition. Returns false at the end of the text.
+  bool LexToken(const std::string& text,
+                re2::StringPiece* input,
+                std::vector<LexerState*>* state_stack,
+                std::vector<int>* matches,
+                TokenSpans* output) const;
+
   std::string name_;
   std::map<std::string, LexerState*> states_;
+  // The state a text starts in.
+  LexerState* root_;
 
   DISALLOW_COPY_AND_ASSIGN(Lexer);
 };
@@ -87,5 +147,86 @@ class Token {
   std::string value;
 };
 
+// Where Lexer::LexLines() got to in a text.
+struct LexerPosition {
+  LexerPosition() : offset(0) {}
+
+  size_t offset;
+  std::vector<LexerState*> state_stack;
+};
+
+// Tokens as (offset, length, type) spans of the text that was lexed, kept in
+// separate arrays, so that lexing a large file is a few allocations rather
+// than a string per token.
+class TokenSpans {
+ public:
+  TokenSpans() {}
+
+  size_t size() const { return types_.size(); }
+  bool empty() const { return types_.empty(); }
+  size_t offset(size_t i) const { return offsets_[i]; }
+  size_t length(size_t i) const { return lengths_[i]; }
+  Lexer::TokenType type(size_t i) const {
+    return static_cast<Lexer::TokenType>(types_[i]);
+  }
+
+  void Append(size_t offset, size_t length, Lexer::TokenType type) {
+    offsets_.push_back(static_cast<uint32>(offset));
+    lengths_.push_back(static_cast<uint32>(length));
+    types_.push_back(static_cast<uint8>(type));
+  }
+  // Appends tokens [|begin|, |end|) of |other|.
+  void Append(const TokenSpans& other, size_t begin, size_t end);
+  void Reserve(size_t count);
+  void Clear();
+  // Replaces tokens [|begin|, |end|) with |replacement|'s, and moves those
+  // after them by |shift| bytes.
+  void Splice(size_t begin,
+              size_t end,
+              const TokenSpans& replacement,
+              ptrdiff_t shift);
+
+ private:
+  std::vector<uint32> offsets_;
+  std::vector<uint32> lengths_;
+  std::vector<uint8> types_;
+
+  DISALLOW_COPY_AND_ASSIGN(TokenSpans);
+};
+
+// Text with its tokens and the lexer's state at the start of each line, for
+// Lexer::Lex() and RelexLines().
+class LexedText {
+ public:
+  LexedText() {}
+
+  const std::string& text() const { return text_; }
+  const TokenSpans& tokens() const { return tokens_; }
+  // Lines are separated by '\n', so there's one more than there are
+  // newlines.
+  size_t line_count() const { return line_starts_.size(); }
+  size_t line_start(size_t line) const { return line_starts_[line]; }
+
+ private:
+  friend class Lexer;
+
+  // For lines that start inside a token.
+  static const int kNoCheckpoint = -1;
+
+  // The index of |stack| in |stacks_|, adding it if it's new.
+  int InternStack(const std::vector<LexerState*>& stack);
+
+  std::string text_;
+  TokenSpans tokens_;
+  std::vector<uint32> line_starts_;
+  // For each line, the state stack at its start as an index in |stacks_|,
+  // and the index of the first token on it.
+  std::vector<int> line_stacks_;
+  std::vector<uint32> line_tokens_;
+  // There are only a few different stacks, so lines share them.
+  std::vector<std::vector<LexerState*> > stacks_;
+
+  DISALLOW_COPY_AND_ASSIGN(LexedText);
+};
 
 #endif  // SG_LEXER_H_
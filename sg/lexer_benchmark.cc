@@ -0,0 +1,139 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Lexing throughput on the synthetic C++ in test_data/lexer_corpus, each
+// file repeated to a few megabytes: long comments, a table of strings,
+// deeply nested macros, #if 0 blocks, and one long minified line. Each is
+// lexed with the generated tables, with RE2 alone, and in parallel on the
+// worker pool, reporting the best of a few runs, and how many allocations
+// lexing made.
+//
+//   out/lexer_benchmark [megabytes]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <memory>
+#include <new>
+#include <string>
+
+#include "base/atomic_ref_count.h"
+#include "base/file_util.h"
+#include "base/string_number_conversions.h"
+#include "base/sys_info.h"
+#include "base/time.h"
+#include "sg/cpp_lexer.h"
+#include "sg/lexer.h"
+#include "sg/parallel_lexer.h"
+
+namespace {
+
+const char kCorpusDir[] = "test_data/lexer_corpus/";
+const char* const kCorpus[] = {
+  "long_comments.cc",
+  "string_table.cc",
+  "macros.h",
+  "if0.cc",
+  "minified.cc",
+};
+const int kDefaultMegabytes = 4;
+const int kRuns = 5;
+
+// Every allocation in the process, counted by the operator new below.
+base::AtomicRefCount g_allocations = 0;
+
+// Repeats |source| until it's at least |size| bytes.
+std::string Repeat(const std::string& source, size_t size) {
+  std::string result;
+  result.reserve(size + source.size());
+  while (result.size() < size)
+    result += source;
+  return result;
+}
+
+enum Engine {
+  TABLES,
+  RE2,
+  PARALLEL,
+};
+
+const char* const kEngineNames[] = {
+  "tables",
+  "re2",
+  "parallel",
+};
+
+// Lexes |text| |kRuns| times, and reports the quickest.
+void Measure(const std::string& name,
+             const std::string& text,
+             const Lexer* lexer,
+             Engine engine) {
+  double best_ms = 0;
+  size_t token_count = 0;
+  int allocations = 0;
+  for (int i = 0; i < kRuns; ++i) {
+    TokenSpans tokens;
+    int allocations_before = g_allocations;
+    base::TimeTicks start = base::TimeTicks::Now();
+    if (engine == PARALLEL) {
+      GetTokensInParallel(lexer, text, base::SysInfo::NumberOfProcessors(),
+                          &tokens);
+    } else {
+      lexer->GetTokens(text, &tokens);
+    }
+    double ms = (base::TimeTicks::Now() - start).InMillisecondsF();
+    allocations = g_allocations - allocations_before;
+    token_count = tokens.size();
+    if (i == 0 || ms < best_ms)
+      best_ms = ms;
+  }
+  double seconds = best_ms / 1000;
+  printf("%-18s %-8s %8.1f MB/s %8.2f Mtokens/s %8d allocations\n",
+         name.c_str(),
+         kEngineNames[engine],
+         text.size() / seconds / (1024 * 1024),
+         token_count / seconds / 1000000,
+         allocations);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  base::AtomicRefCountInc(&g_allocations);
+  void* result = malloc(size ? size : 1);
+  if (!result)
+    throw std::bad_alloc();
+  return result;
+}
+
+void operator delete(void* pointer) throw() {
+  free(pointer);
+}
+
+int main(int argc, char** argv) {
+  int megabytes = kDefaultMegabytes;
+  if (argc > 1 && (!base::StringToInt(argv[1], &megabytes) ||
+                   megabytes <= 0)) {
+    fprintf(stderr, "usage: lexer_benchmark [megabytes]\n");
+    return 1;
+  }
+
+  std::unique_ptr<Lexer> tables_lexer(MakeCppLexer());
+  std::unique_ptr<Lexer> re2_lexer(MakeCppLexerWithoutTables());
+  for (size_t i = 0; i < arraysize(kCorpus); ++i) {
+    std::string path = std::string(kCorpusDir) + kCorpus[i];
+    std::string source;
+    if (!file_util::ReadFileToString(base::FilePath::FromUTF8Unsafe(path),
+                                     &source) ||
+        source.empty()) {
+      fprintf(stderr, "couldn't read %s\n", path.c_str());
+      return 1;
+    }
+    std::string text = Repeat(source, megabytes * 1024 * 1024);
+    Measure(kCorpus[i], text, tables_lexer.get(), TABLES);
+    Measure(kCorpus[i], text, re2_lexer.get(), RE2);
+    Measure(kCorpus[i], text, tables_lexer.get(), PARALLEL);
+  }
+  return 0;
+}
@@ -4,6 +4,20 @@
 
 #include "sg/lexer_state.h"
 
+#include <algorithm>
+
+#include "base/logging.h"
+#include "sg/regex_first_bytes.h"
+
+namespace {
+
+bool IsWordCharacter(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+}  // namespace
+
 void TokenDefinitions::Add(
     const std::string& regex, Lexer::TokenType token_type) {
   token_data_.push_back(TokenData(regex, token_type, NULL));
@@ -16,7 +30,14 @@ void TokenDefinitions::AddWithTransition(const std::string& regex,
 }
 
 LexerState::LexerState(const std::string& name)
-  : name_(name), token_defs_(NULL), token_defs_count_(0) {
+  : name_(name),
+    token_defs_(NULL),
+    token_defs_count_(0),
+    combined_regex_(NULL),
+    token_set_(NULL),
+    has_word_boundary_(false),
+    has_end_of_text_(false),
+    table_(NULL) {
 }
 
 LexerState::~LexerState() {
@@ -24,6 +45,8 @@ LexerState::~LexerState() {
     delete token_defs_[i].regex;
   }
   delete [] token_defs_;
+  delete combined_regex_;
+  delete token_set_;
 }
 
 void LexerState::SetTokenDefinitions(
@@ -35,10 +58,104 @@ void LexerState::SetTokenDefinitions(
     token_defs_[i].regex = new re2::RE2(tokens.token_data_[i].regex, options);
     token_defs_[i].action = tokens.token_data_[i].action;
     token_defs_[i].new_state = tokens.token_data_[i].new_state;
+    bool first_bytes[256];
+    GetRegexFirstBytes(*token_defs_[i].regex, first_bytes);
+    for (int b = 0; b < 256; ++b) {
+      if (first_bytes[b])
+        candidates_[b].push_back(i);
+    }
+  }
+
+  std::string combined;
+  token_set_ = new re2::RE2::Set(options, re2::RE2::ANCHOR_BOTH);
+  for (size_t i = 0; i < token_defs_count_; ++i) {
+    const std::string& regex = tokens.token_data_[i].regex;
+    if (i > 0)
+      combined += "|";
+    combined += "(?:" + regex + ")";
+    token_set_->Add(regex, NULL);
+    // Conservatively, as these could also be escaped literals.
+    if (regex.find("\\b") != std::string::npos ||
+        regex.find("\\B") != std::string::npos) {
+      has_word_boundary_ = true;
+    }
+    if (regex.find('$') != std::string::npos)
+      has_end_of_text_ = true;
+  }
+  combined_regex_ = new re2::RE2(combined, options);
+  if (!combined_regex_->ok() || !token_set_->Compile()) {
+    // Still works, just slower.
+    delete combined_regex_;
+    combined_regex_ = NULL;
   }
 }
 
+void LexerState::SetTable(const LexerTable* table) {
+  if (table->rule_count != token_defs_count_) {
+    NOTREACHED() << "table for " << name_ << " is out of date";
+    return;
+  }
+  for (size_t i = 0; i < token_defs_count_; ++i) {
+    if (token_defs_[i].regex->pattern() != table->regexes[i]) {
+      NOTREACHED() << "table for " << name_ << " is out of date";
+      return;
+    }
+  }
+  table_ = table;
+}
+
 const LexerState::TokenDef* LexerState::GetTokenDefs(size_t* count) const {
   *count = token_defs_count_;
   return token_defs_;
 }
+
+const LexerState::TokenDef* LexerState::Consume(
+    re2::StringPiece* input,
+    std::vector<int>* matches) const {
+  if (table_) {
+    size_t length;
+    int rule = MatchLexerTable(*table_, input->data(), input->size(), &length);
+    if (rule < 0)
+      return NULL;
+    input->remove_prefix(length);
+    return &token_defs_[rule];
+  }
+  if (input->empty()) {
+    // Only definitions that match the empty string could, so it's not
+    // worth having candidates for.
+    for (size_t i = 0; i < token_defs_count_; ++i) {
+      if (RE2::Consume(input, *token_defs_[i].regex))
+        return &token_defs_[i];
+    }
+    return NULL;
+  }
+  const std::vector<size_t>& candidates =
+      candidates_[static_cast<uint8>((*input)[0])];
+  if (candidates.size() > 1 && combined_regex_) {
+    re2::StringPiece token;
+    if (!combined_regex_->Match(*input, 0, input->size(), RE2::ANCHOR_START,
+                                &token, 1)) {
+      return NULL;
+    }
+    // The set sees the token on its own, so if the regexes look at what
+    // follows it and something does, its answer might not hold in context.
+    re2::StringPiece rest(token.data() + token.size(),
+                          input->size() - token.size());
+    bool depends_on_rest =
+        !rest.empty() &&
+        (has_end_of_text_ ||
+         (has_word_boundary_ && IsWordCharacter(rest[0])));
+    if (!depends_on_rest && token_set_->Match(token, matches)) {
+      *input = rest;
+      return &token_defs_[*std::min_element(matches->begin(),
+                                            matches->end())];
+    }
+  }
+  // Otherwise, the candidates in order, which when there's only one is
+  // quicker than the above.
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (RE2::Consume(input, *token_defs_[candidates[i]].regex))
+      return &token_defs_[candidates[i]];
+  }
+  return NULL;
+}
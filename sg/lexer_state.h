@@ -10,7 +10,9 @@
 
 #include "base/basictypes.h"
 #include "sg/lexer.h"
+#include "sg/lexer_table.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
 class TokenDefinitions {
  public:
@@ -47,6 +49,11 @@ class LexerState {
   ~LexerState();
   void SetTokenDefinitions(const TokenDefinitions& token_definitions);
 
+  // Uses a generated DFA instead of RE2 to match the token definitions, if
+  // it was generated from the same regexes. Must be called after
+  // SetTokenDefinitions.
+  void SetTable(const LexerTable* table);
+
  private:
   friend class Lexer;
   struct TokenDef {
@@ -56,9 +63,32 @@ class LexerState {
   };
   TokenDef* token_defs_;
   size_t token_defs_count_;
+  // For each first byte of the input, the token definitions that could
+  // match it, in order. Usually only one or two.
+  std::vector<size_t> candidates_[256];
+  // All the token regexes as one alternation, which finds the extent of the
+  // next token in one scan, rather than trying each regex in turn.
+  // Alternatives are preferred in order, as the token definitions were.
+  re2::RE2* combined_regex_;
+  // The same regexes, to find which of them match all of that token. The
+  // first of those is the one that applied, as any before it would have
+  // been preferred if they'd matched at all.
+  re2::RE2::Set* token_set_;
+  // Whether any of the regexes look past the end of a token, in which case
+  // the set, which only sees the token, may be wrong about it.
+  bool has_word_boundary_;
+  bool has_end_of_text_;
+  // Used instead of all the above, if set.
+  const LexerTable* table_;
 
   const TokenDef* GetTokenDefs(size_t* count) const;
 
+  // Finds the first token definition (in the order they were added) that
+  // matches at the start of |input|, and advances |input| past it. Returns
+  // NULL without advancing if none do. |matches| is scratch space.
+  const TokenDef* Consume(re2::StringPiece* input,
+                          std::vector<int>* matches) const;
+
   std::string name_;
 
   DISALLOW_COPY_AND_ASSIGN(LexerState);
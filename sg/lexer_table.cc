@@ -0,0 +1,54 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/lexer_table.h"
+
+namespace {
+
+bool IsWordCharacter(uint8 c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+// As RE2 sees it when matching at the start of |text|: before it and after
+// it are both non-word.
+bool IsWordBoundary(const uint8* text, size_t size, size_t position) {
+  bool before = position > 0 && IsWordCharacter(text[position - 1]);
+  bool after = position < size && IsWordCharacter(text[position]);
+  return before != after;
+}
+
+}  // namespace
+
+int MatchLexerTable(const LexerTable& table,
+                    const char* text,
+                    size_t size,
+                    size_t* length) {
+  const uint8* bytes = reinterpret_cast<const uint8*>(text);
+  int best = kLexerTableNoRule;
+  size_t best_length = 0;
+  size_t state = 1;
+  for (size_t position = 0;; ++position) {
+    int rule = table.accept[state];
+    if (table.accept_at_word_boundary[state] < rule &&
+        IsWordBoundary(bytes, size, position)) {
+      rule = table.accept_at_word_boundary[state];
+    }
+    // An earlier rule wins wherever it matches, and the same rule matching
+    // again is a longer match.
+    if (rule != kLexerTableNoRule && rule <= best) {
+      best = rule;
+      best_length = position;
+    }
+    int min_live = table.min_live[state];
+    if (min_live == kLexerTableNoRule || min_live > best || position == size)
+      break;
+    state = table.transitions[state * table.class_count +
+                              table.byte_classes[bytes[position]]];
+  }
+  if (best == kLexerTableNoRule)
+    return -1;
+  *length = best_length;
+  return best;
+}
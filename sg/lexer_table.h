@@ -0,0 +1,51 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_LEXER_TABLE_H_
+#define SG_LEXER_TABLE_H_
+
+#include "base/basictypes.h"
+
+// A DFA for all of a LexerState's token definitions at once, generated at
+// build time by generate_lexer_tables.py. It finds the same token as trying
+// each of the state's regexes in turn with RE2, in one pass over the token
+// and without RE2's per-match overhead.
+//
+// DFA state 0 is dead and 1 is the start. Rules are identified by the index
+// of their token definition.
+struct LexerTable {
+  const char* state_name;
+  // The regexes the table was generated from, to make sure it's used with
+  // the same ones.
+  size_t rule_count;
+  const char* const* regexes;
+
+  size_t state_count;
+  size_t class_count;
+  // Bytes that all the states treat the same are in the same class.
+  const uint8* byte_classes;
+  // state_count * class_count next states.
+  const uint16* transitions;
+  // Per state, the first rule that matches when it's reached, or
+  // kLexerTableNoRule. Rules ending in \b are only in
+  // |accept_at_word_boundary|, which is used when the next character makes
+  // a word boundary.
+  const int16* accept;
+  const int16* accept_at_word_boundary;
+  // Per state, the first rule that could still match if the DFA went on,
+  // or kLexerTableNoRule. Once that's after the best match so far, nothing
+  // can change the result.
+  const int16* min_live;
+};
+
+const int16 kLexerTableNoRule = 0x7fff;
+
+// Finds the first rule in |table| that matches a prefix of |text| (of
+// |size| bytes), and the length of its match. Returns -1 if none do.
+int MatchLexerTable(const LexerTable& table,
+                    const char* text,
+                    size_t size,
+                    size_t* length);
+
+#endif  // SG_LEXER_TABLE_H_
@@ -7,10 +7,54 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "base/file_util.h"
+#include "base/string_number_conversions.h"
 #include "sg/cpp_lexer.h"
 #include "sg/lexer_state.h"
 
+namespace {
+
+void ExpectSameTokens(Lexer* expected_lexer,
+                      Lexer* lexer,
+                      const std::string& text,
+                      const std::string& name) {
+  std::vector<Token> expected;
+  expected_lexer->GetTokensUnprocessed(text, &expected);
+  std::vector<Token> tokens;
+  lexer->GetTokensUnprocessed(text, &tokens);
+  ASSERT_EQ(expected.size(), tokens.size()) << name;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    EXPECT_EQ(expected[i].index, tokens[i].index) << name;
+    EXPECT_EQ(expected[i].token, tokens[i].token) << name;
+    if (expected[i].token != tokens[i].token)
+      return;
+  }
+}
+
+// Checks that |lexed| is what lexing its text from scratch gives.
+void ExpectSameAsLex(Lexer* lexer,
+                     const LexedText& lexed,
+                     const std::string& name) {
+  LexedText expected;
+  lexer->Lex(lexed.text(), &expected);
+  ASSERT_EQ(expected.line_count(), lexed.line_count()) << name;
+  for (size_t i = 0; i < lexed.line_count(); ++i)
+    ASSERT_EQ(expected.line_start(i), lexed.line_start(i)) << name;
+  const TokenSpans& expected_tokens = expected.tokens();
+  const TokenSpans& tokens = lexed.tokens();
+  ASSERT_EQ(expected_tokens.size(), tokens.size()) << name;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    ASSERT_EQ(expected_tokens.offset(i), tokens.offset(i)) << name;
+    ASSERT_EQ(expected_tokens.length(i), tokens.length(i)) << name;
+    ASSERT_EQ(expected_tokens.type(i), tokens.type(i)) << name;
+  }
+}
+
+}  // namespace
+
 TEST(Lexer, Basic) {
   Lexer* lexer = new Lexer("test");
   LexerState* root = lexer->AddState("root");
@@ -65,6 +109,33 @@ TEST(Lexer, IniFile) {
   // TODO(scottmg): More detailed expectations.
 }
 
+TEST(Lexer, FirstDefinitionWins) {
+  std::unique_ptr<Lexer> lexer(new Lexer("test"));
+  LexerState* root = lexer->AddState("root");
+
+  // Earlier definitions are preferred even if later ones match more, and
+  // ones that only match in context (e.g. with a \b) still apply.
+  TokenDefinitions defs;
+  defs.Add("ab", Lexer::Keyword);
+  defs.Add("(cd)\\b", Lexer::KeywordType);
+  defs.Add("[a-z]+", Lexer::Name);
+  defs.Add(" ", Lexer::Text);
+  root->SetTokenDefinitions(defs);
+
+  std::vector<Token> tokens;
+  lexer->GetTokensUnprocessed("abc cd cde", &tokens);
+
+  ASSERT_EQ(6, tokens.size());
+  EXPECT_EQ(Lexer::Keyword, tokens[0].token);
+  EXPECT_EQ("ab", tokens[0].value);
+  EXPECT_EQ(Lexer::Name, tokens[1].token);
+  EXPECT_EQ("c", tokens[1].value);
+  EXPECT_EQ(Lexer::KeywordType, tokens[3].token);
+  EXPECT_EQ("cd", tokens[3].value);
+  EXPECT_EQ(Lexer::Name, tokens[5].token);
+  EXPECT_EQ("cde", tokens[5].value);
+}
+
 TEST(Lexer, BasicCpp) {
   std::unique_ptr<Lexer> lexer(MakeCppLexer());
 
@@ -115,3 +186,158 @@ TEST(Lexer, CppNumbers) {
   EXPECT_EQ(Lexer::LiteralNumberFloat, tokens[12].token);
   EXPECT_EQ(Lexer::LiteralNumberFloat, tokens[14].token);
 }
+
+TEST(Lexer, CppTablesMatchRegexes) {
+  std::unique_ptr<Lexer> regexes(MakeCppLexerWithoutTables());
+  std::unique_ptr<Lexer> tables(MakeCppLexer());
+
+  const char* snippets[] = {
+    "int x = 0x1fUL + 017 + 1.5e-3f + .5 + 2.f;",
+    "const_cast<int>(x); constant; truex; true_; NULL; NULLs",
+    "__int64 __forceinline inline _inline __inline thread threads",
+    "'a' '\\n' '\\x41' '\\101' L'x' '\xc3\xa9' \"\\x1234\\\"\\\n\"",
+    "\"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\" x",
+    "// comment \\\n continued\nx /* multi\nline */ y */",
+    "#include <foo.h> // trailing\n#define X /* a */ 1 \\\n  2\n",
+    "#if 0\n#if 1\nno\n#endif\nstill\n#endif\nint yes;\n",
+    "a->b; a<<=b; a?b:c; ~a; !a; a%b; a^b; a|b; a&&b; a[0];",
+    "/",
+    "x //",
+  };
+  for (size_t i = 0; i < arraysize(snippets); ++i)
+    ExpectSameTokens(regexes.get(), tables.get(), snippets[i], snippets[i]);
+
+  const base::FilePath::CharType* files[] = {
+    FILE_PATH_LITERAL("sg/cpp_lexer.cc"),
+    FILE_PATH_LITERAL("sg/debug_presenter.cc"),
+    FILE_PATH_LITERAL("sg/lexer.cc"),
+    FILE_PATH_LITERAL("sg/source_view.cc"),
+    FILE_PATH_LITERAL("third_party/re2/re2/dfa.cc"),
+    FILE_PATH_LITERAL("third_party/re2/re2/re2.cc"),
+  };
+  for (size_t i = 0; i < arraysize(files); ++i) {
+    base::FilePath path(files[i]);
+    std::string contents;
+    ASSERT_TRUE(file_util::ReadFileToString(path, &contents));
+    ExpectSameTokens(regexes.get(), tables.get(), contents,
+                     path.AsUTF8Unsafe());
+  }
+}
+
+TEST(Lexer, RelexLines) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  LexedText lexed;
+  lexer->Lex("int x;\nint y;\nint z;\n/* a\nb */\nint w;\n", &lexed);
+  EXPECT_EQ(7, lexed.line_count());
+
+  size_t first, end;
+  lexer->RelexLines(1, 1, "char y;\n", &lexed, &first, &end);
+  EXPECT_EQ(0, first);
+  EXPECT_EQ(2, end);
+  ExpectSameAsLex(lexer.get(), lexed, "replace");
+
+  // Opening a comment changes the lines up to where it's closed.
+  lexer->RelexLines(1, 1, "/* y;\n", &lexed, &first, &end);
+  EXPECT_EQ(0, first);
+  EXPECT_EQ(5, end);
+  ExpectSameAsLex(lexer.get(), lexed, "open comment");
+
+  // Inside a comment, there's nowhere to start from until it does.
+  lexer->RelexLines(2, 1, "z\n", &lexed, &first, &end);
+  EXPECT_EQ(1, first);
+  ExpectSameAsLex(lexer.get(), lexed, "in comment");
+
+  lexer->RelexLines(1, 2, "", &lexed, &first, &end);
+  ExpectSameAsLex(lexer.get(), lexed, "delete");
+  lexer->RelexLines(0, 0, "#if 0\n", &lexed, &first, &end);
+  EXPECT_EQ(lexed.line_count(), end);
+  ExpectSameAsLex(lexer.get(), lexed, "insert");
+  lexer->RelexLines(lexed.line_count() - 1, 1, "#endif\nint v;", &lexed,
+                    &first, &end);
+  ExpectSameAsLex(lexer.get(), lexed, "end");
+
+  // Inside #if 0, a token that starts on a blank line can run on into the
+  // edit, so it's lexed from the last line with something on it.
+  lexer->Lex("#if 0\nfoo\n\n\nbar\n#endif\nint x;\n", &lexed);
+  lexer->RelexLines(4, 0, "#endif\n", &lexed, &first, &end);
+  EXPECT_EQ(1, first);
+  ExpectSameAsLex(lexer.get(), lexed, "blank lines before");
+}
+
+TEST(Lexer, RelexLinesSingleCharacterEdits) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  std::string contents;
+  ASSERT_TRUE(file_util::ReadFileToString(
+      base::FilePath(FILE_PATH_LITERAL("sg/lexer.cc")), &contents));
+  LexedText lexed;
+  lexer->Lex(contents, &lexed);
+
+  // No '*' or '/', which could close a comment that's been left open.
+  const char kCharacters[] = "\"'#\\\n x0;{";
+  uint32 random = 1;
+  for (int i = 0; i < 300; ++i) {
+    random = random * 1103515245 + 12345;
+    size_t line = (random >> 8) % lexed.line_count();
+    size_t begin = lexed.line_start(line);
+    size_t end = line + 1 < lexed.line_count() ? lexed.line_start(line + 1)
+                                               : lexed.text().size();
+    std::string new_line = lexed.text().substr(begin, end - begin);
+    size_t column = (random >> 16) % (new_line.size() + 1);
+    char c = kCharacters[(random >> 24) % (arraysize(kCharacters) - 1)];
+    if (i % 3 == 0 && column < new_line.size())
+      new_line.erase(column, 1);
+    else if (i % 3 == 1 && column < new_line.size())
+      new_line[column] = c;
+    else
+      new_line.insert(column, 1, c);
+    lexer->RelexLines(line, 1, new_line, &lexed, NULL, NULL);
+    ExpectSameAsLex(lexer.get(), lexed, "edit " + base::IntToString(i));
+  }
+}
+
+TEST(Lexer, LexLinesAPieceAtATime) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  std::string text = "int a;\n/* b\nc */ d\n#if 0\ne\n#endif\nf";
+
+  TokenSpans expected;
+  lexer->GetTokens(text, &expected);
+
+  // Ending each piece part way through a line, or a comment, goes on to the
+  // start of a line after it.
+  LexerPosition position;
+  lexer->GetStartPosition(0, &position);
+  TokenSpans tokens;
+  while (position.offset < text.size()) {
+    size_t start = position.offset;
+    lexer->LexLines(text, start + 1, &position, &tokens);
+    ASSERT_LT(start, position.offset);
+    EXPECT_TRUE(position.offset == text.size() ||
+                text[position.offset - 1] == '\n');
+  }
+  ASSERT_EQ(expected.size(), tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    EXPECT_EQ(expected.offset(i), tokens.offset(i));
+    EXPECT_EQ(expected.length(i), tokens.length(i));
+    EXPECT_EQ(expected.type(i), tokens.type(i));
+  }
+}
+
+TEST(Lexer, SharedCppLexer) {
+  const Lexer* shared = GetCppLexer();
+  ASSERT_TRUE(shared);
+  EXPECT_EQ(shared, GetCppLexer());
+
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  std::string contents;
+  ASSERT_TRUE(file_util::ReadFileToString(
+      base::FilePath(FILE_PATH_LITERAL("sg/lexer.cc")), &contents));
+  TokenSpans expected;
+  lexer->GetTokens(contents, &expected);
+  TokenSpans tokens;
+  shared->GetTokens(contents, &tokens);
+  ASSERT_EQ(expected.size(), tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    EXPECT_EQ(expected.offset(i), tokens.offset(i));
+    EXPECT_EQ(expected.type(i), tokens.type(i));
+  }
+}
@@ -0,0 +1,126 @@
+// Copyright 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/module_list.h"
+
+#include "base/string_number_conversions.h"
+
+namespace {
+
+// Batches up to this size are listed individually, larger ones are
+// summarized.
+const size_t kMaxIndividuallyListed = 3;
+
+string16 DescribeLoaded(const LibraryEvent& event) {
+  string16 output = L"Loaded '" + event.host_path + L"'";
+  if (event.host_path != event.target_path)
+    output += L" (" + event.target_path + L")";
+  if (event.symbols_loaded)
+    output += L", Symbols loaded.";
+  return output;
+}
+
+}  // namespace
+
+ModuleList::ModuleList() {
+}
+
+ModuleList::~ModuleList() {
+}
+
+void ModuleList::Apply(const LibrariesChangedData& data) {
+  for (size_t i = 0; i < data.events.size(); ++i) {
+    const LibraryEvent& event = data.events[i];
+    if (event.kind == LibraryEvent::LOADED)
+      Add(event);
+    else
+      Remove(event);
+  }
+}
+
+void ModuleList::Clear() {
+  modules_.clear();
+  by_target_path_.clear();
+}
+
+const ModuleList::Module* ModuleList::Find(
+    const string16& target_path) const {
+  std::map<string16, size_t>::const_iterator i =
+      by_target_path_.find(target_path);
+  if (i == by_target_path_.end())
+    return NULL;
+  return &modules_[i->second];
+}
+
+int ModuleList::GetSymbolsLoadedCount() const {
+  int count = 0;
+  for (size_t i = 0; i < modules_.size(); ++i) {
+    if (modules_[i].symbols_loaded)
+      ++count;
+  }
+  return count;
+}
+
+void ModuleList::Add(const LibraryEvent& event) {
+  Module module;
+  module.host_path = event.host_path;
+  module.target_path = event.target_path;
+  module.symbols_loaded = event.symbols_loaded;
+  std::map<string16, size_t>::iterator i =
+      by_target_path_.find(event.target_path);
+  if (i != by_target_path_.end()) {
+    // Reloaded (e.g. symbols became available), update in place.
+    modules_[i->second] = module;
+    return;
+  }
+  by_target_path_[event.target_path] = modules_.size();
+  modules_.push_back(module);
+}
+
+void ModuleList::Remove(const LibraryEvent& event) {
+  std::map<string16, size_t>::iterator i =
+      by_target_path_.find(event.target_path);
+  if (i == by_target_path_.end())
+    return;
+  size_t index = i->second;
+  modules_.erase(modules_.begin() + index);
+  by_target_path_.erase(i);
+  // Unloads are rare compared to loads, so just fix up the index.
+  for (std::map<string16, size_t>::iterator j = by_target_path_.begin();
+       j != by_target_path_.end(); ++j) {
+    if (j->second > index)
+      --j->second;
+  }
+}
+
+string16 SummarizeLibrariesChanged(const LibrariesChangedData& data) {
+  std::vector<const LibraryEvent*> loaded;
+  int with_symbols = 0;
+  size_t unloaded = 0;
+  for (size_t i = 0; i < data.events.size(); ++i) {
+    const LibraryEvent& event = data.events[i];
+    if (event.kind == LibraryEvent::LOADED) {
+      loaded.push_back(&event);
+      if (event.symbols_loaded)
+        ++with_symbols;
+    } else {
+      ++unloaded;
+    }
+  }
+  string16 output;
+  if (loaded.size() <= kMaxIndividuallyListed) {
+    for (size_t i = 0; i < loaded.size(); ++i)
+      output += DescribeLoaded(*loaded[i]) + L"\n";
+  } else {
+    output += L"Loaded " + base::SizeTToString16(loaded.size()) +
+              L" modules (" + base::IntToString16(with_symbols) +
+              L" with symbols), last '" + loaded.back()->host_path +
+              L"'\n";
+  }
+  if (unloaded) {
+    output += L"Unloaded " + base::SizeTToString16(unloaded) +
+              L" module" + (unloaded == 1 ? L"" : L"s") + L"\n";
+  }
+  return output;
+}
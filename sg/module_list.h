@@ -0,0 +1,59 @@
+// Copyright 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_MODULE_LIST_H_
+#define SG_MODULE_LIST_H_
+
+#include <map>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
+#include "sg/basex/string16.h"
+
+// Model for the modules (executable and shared libraries) loaded into the
+// target, in load order. Fed by batched library notifications from the
+// backend.
+class ModuleList {
+ public:
+  struct Module {
+    string16 host_path;
+    string16 target_path;
+    bool symbols_loaded;
+  };
+
+  ModuleList();
+  ~ModuleList();
+
+  // Applies a batch of loads and unloads, in the order they happened.
+  void Apply(const LibrariesChangedData& data);
+
+  void Clear();
+
+  size_t size() const { return modules_.size(); }
+  const Module& at(size_t i) const { return modules_.at(i); }
+
+  // Returns NULL if |target_path| isn't currently loaded.
+  const Module* Find(const string16& target_path) const;
+
+  // Number of loaded modules that have symbols.
+  int GetSymbolsLoadedCount() const;
+
+ private:
+  void Add(const LibraryEvent& event);
+  void Remove(const LibraryEvent& event);
+
+  std::vector<Module> modules_;
+
+  // Index into |modules_| by target path.
+  std::map<string16, size_t> by_target_path_;
+
+  DISALLOW_COPY_AND_ASSIGN(ModuleList);
+};
+
+// Summarizes a batch of library events into a few lines for the Output view,
+// rather than one line per library.
+string16 SummarizeLibrariesChanged(const LibrariesChangedData& data);
+
+#endif  // SG_MODULE_LIST_H_
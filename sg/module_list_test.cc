@@ -0,0 +1,96 @@
+// Copyright 2012 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/module_list.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+LibraryEvent Loaded(const string16& path, bool symbols) {
+  LibraryEvent event;
+  event.kind = LibraryEvent::LOADED;
+  event.host_path = path;
+  event.target_path = path;
+  event.symbols_loaded = symbols;
+  return event;
+}
+
+LibraryEvent Unloaded(const string16& path) {
+  LibraryEvent event;
+  event.kind = LibraryEvent::UNLOADED;
+  event.host_path = path;
+  event.target_path = path;
+  event.symbols_loaded = false;
+  return event;
+}
+
+}  // namespace
+
+TEST(ModuleList, LoadAndUnload) {
+  ModuleList modules;
+  LibrariesChangedData batch;
+  batch.events.push_back(Loaded(L"a.dll", true));
+  batch.events.push_back(Loaded(L"b.dll", false));
+  batch.events.push_back(Loaded(L"c.dll", true));
+  modules.Apply(batch);
+  EXPECT_EQ(3, modules.size());
+  EXPECT_EQ(2, modules.GetSymbolsLoadedCount());
+  EXPECT_EQ(L"b.dll", modules.at(1).host_path);
+
+  LibrariesChangedData unload;
+  unload.events.push_back(Unloaded(L"b.dll"));
+  modules.Apply(unload);
+  EXPECT_EQ(2, modules.size());
+  EXPECT_TRUE(modules.Find(L"b.dll") == NULL);
+  ASSERT_TRUE(modules.Find(L"c.dll") != NULL);
+  EXPECT_EQ(L"c.dll", modules.Find(L"c.dll")->host_path);
+  EXPECT_EQ(L"c.dll", modules.at(1).host_path);
+}
+
+TEST(ModuleList, ReloadUpdatesInPlace) {
+  ModuleList modules;
+  LibrariesChangedData batch;
+  batch.events.push_back(Loaded(L"a.dll", false));
+  batch.events.push_back(Loaded(L"a.dll", true));
+  modules.Apply(batch);
+  EXPECT_EQ(1, modules.size());
+  EXPECT_TRUE(modules.at(0).symbols_loaded);
+}
+
+TEST(ModuleList, UnloadAndReloadInOneBatch) {
+  ModuleList modules;
+  LibrariesChangedData load;
+  load.events.push_back(Loaded(L"a.dll", true));
+  modules.Apply(load);
+
+  LibrariesChangedData batch;
+  batch.events.push_back(Unloaded(L"a.dll"));
+  batch.events.push_back(Loaded(L"a.dll", false));
+  modules.Apply(batch);
+  ASSERT_EQ(1, modules.size());
+  EXPECT_FALSE(modules.at(0).symbols_loaded);
+
+  LibrariesChangedData reload_then_unload;
+  reload_then_unload.events.push_back(Loaded(L"b.dll", true));
+  reload_then_unload.events.push_back(Unloaded(L"b.dll"));
+  modules.Apply(reload_then_unload);
+  EXPECT_EQ(1, modules.size());
+  EXPECT_TRUE(modules.Find(L"b.dll") == NULL);
+}
+
+TEST(ModuleList, Summary) {
+  LibrariesChangedData small;
+  small.events.push_back(Loaded(L"a.dll", true));
+  EXPECT_EQ(L"Loaded 'a.dll', Symbols loaded.\n",
+            SummarizeLibrariesChanged(small));
+
+  LibrariesChangedData big;
+  for (int i = 0; i < 100; ++i)
+    big.events.push_back(Loaded(L"x.dll", i % 2 == 0));
+  big.events.push_back(Unloaded(L"y.dll"));
+  EXPECT_EQ(L"Loaded 100 modules (50 with symbols), last 'x.dll'\n"
+            L"Unloaded 1 module\n",
+            SummarizeLibrariesChanged(big));
+}
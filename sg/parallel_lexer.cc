@@ -0,0 +1,142 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/parallel_lexer.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/atomic_ref_count.h"
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/worker_pool.h"
+#include "sg/lexer.h"
+
+namespace {
+
+// Smaller chunks aren't worth a task.
+const size_t kMinChunkBytes = 256 * 1024;
+
+typedef std::pair<size_t, size_t> RootLine;
+
+struct Chunk {
+  Chunk() : begin(0), end(0) {}
+
+  // Where the chunk starts in the text, which is a line start, and where the
+  // next starts.
+  size_t begin;
+  size_t end;
+  TokenSpans tokens;
+  // Where lexing stopped, at |end| or the start of a line soon after.
+  LexerPosition stop;
+  // The line starts at which the lexer was in the root state, with the
+  // number of tokens before each, in order.
+  std::vector<RootLine> root_lines;
+};
+
+bool RootLineLess(const RootLine& root_line, size_t offset) {
+  return root_line.first < offset;
+}
+
+void LexChunk(const Lexer* lexer, const std::string* text, Chunk* chunk) {
+  lexer->GetStartPosition(chunk->begin, &chunk->stop);
+  std::vector<LexerState*> root_stack = chunk->stop.state_stack;
+  chunk->root_lines.push_back(RootLine(chunk->begin, 0));
+  // A line at a time, to see the state each starts in.
+  while (chunk->stop.offset < chunk->end) {
+    lexer->LexLines(
+        *text, chunk->stop.offset + 1, &chunk->stop, &chunk->tokens);
+    if (chunk->stop.state_stack == root_stack) {
+      chunk->root_lines.push_back(
+          RootLine(chunk->stop.offset, chunk->tokens.size()));
+    }
+  }
+}
+
+void LexChunkOnWorker(const Lexer* lexer,
+                      const std::string* text,
+                      Chunk* chunk,
+                      base::AtomicRefCount* remaining_tasks,
+                      base::WaitableEvent* done) {
+  LexChunk(lexer, text, chunk);
+  // The last to finish. The decrement is a barrier, so the other tasks'
+  // chunks are visible.
+  if (!base::AtomicRefCountDec(remaining_tasks))
+    done->Signal();
+}
+
+}  // namespace
+
+void GetTokensInParallel(const Lexer* lexer,
+                         const std::string& text,
+                         int max_tasks,
+                         TokenSpans* output) {
+  DCHECK_GE(max_tasks, 1);
+  size_t num_chunks = std::min(static_cast<size_t>(max_tasks),
+                               text.size() / kMinChunkBytes);
+  // Each chunk after the first starts after a newline near where an even
+  // split would put it.
+  std::vector<size_t> begins(1, 0);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    size_t newline = text.find('\n', text.size() / num_chunks * i);
+    if (newline == std::string::npos || newline + 1 >= text.size())
+      break;
+    if (newline + 1 > begins.back())
+      begins.push_back(newline + 1);
+  }
+  if (begins.size() == 1) {
+    lexer->GetTokens(text, output);
+    return;
+  }
+
+  num_chunks = begins.size();
+  std::unique_ptr<Chunk[]> chunks(new Chunk[num_chunks]);
+  for (size_t i = 0; i < num_chunks; ++i) {
+    chunks[i].begin = begins[i];
+    chunks[i].end = i + 1 < num_chunks ? begins[i + 1] : text.size();
+  }
+
+  // This thread does the first chunk, which is the only one that's sure to
+  // be right, while the pool does the rest.
+  base::AtomicRefCount remaining_tasks = 0;
+  base::AtomicRefCountIncN(&remaining_tasks,
+                           static_cast<int>(num_chunks - 1));
+  base::WaitableEvent done(false, false);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    base::WorkerPool::PostTask(FROM_HERE,
+        base::Bind(&LexChunkOnWorker,
+                   lexer, &text, &chunks[i], &remaining_tasks, &done),
+        true);
+  }
+  LexChunk(lexer, &text, &chunks[0]);
+  done.Wait();
+
+  output->Append(chunks[0].tokens, 0, chunks[0].tokens.size());
+  LexerPosition position = chunks[0].stop;
+  LexerPosition root;
+  lexer->GetStartPosition(0, &root);
+  for (size_t i = 1; i < num_chunks; ++i) {
+    const Chunk& chunk = chunks[i];
+    // Lexing is the same from the same state at the same place, so once
+    // this is at a line where the guess was in the root state too, the rest
+    // of the chunk is right.
+    while (position.offset < chunk.stop.offset) {
+      if (position.state_stack == root.state_stack) {
+        std::vector<RootLine>::const_iterator it =
+            std::lower_bound(chunk.root_lines.begin(), chunk.root_lines.end(),
+                             position.offset, RootLineLess);
+        if (it != chunk.root_lines.end() && it->first == position.offset) {
+          output->Append(chunk.tokens, it->second, chunk.tokens.size());
+          position.offset = chunk.stop.offset;
+          position.state_stack = chunk.stop.state_stack;
+          break;
+        }
+      }
+      lexer->LexLines(text, position.offset + 1, &position, output);
+    }
+  }
+}
@@ -0,0 +1,28 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_PARALLEL_LEXER_H_
+#define SG_PARALLEL_LEXER_H_
+
+#include <string>
+
+class Lexer;
+class TokenSpans;
+
+// Appends the tokens in |text| to |output|, the same as lexer->GetTokens(),
+// but split into chunks at line starts that are lexed on up to |max_tasks|
+// worker pool tasks, and blocks until they're done. Small texts are lexed
+// on the calling thread.
+//
+// Each chunk is lexed as though it started in the root state, which is
+// usually so. Where it isn't (in a long comment or #if 0, say), the chunk is
+// lexed again from where the one before really ended until it gets to a
+// line that both lexings started in the root state, and the guess is kept
+// from there, so the lines redone are only those the guess got wrong.
+void GetTokensInParallel(const Lexer* lexer,
+                         const std::string& text,
+                         int max_tasks,
+                         TokenSpans* output);
+
+#endif  // SG_PARALLEL_LEXER_H_
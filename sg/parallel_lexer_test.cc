@@ -0,0 +1,82 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/parallel_lexer.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "sg/cpp_lexer.h"
+#include "sg/lexer.h"
+
+namespace {
+
+// Enough for several chunks.
+const size_t kLines = 200000;
+
+void ExpectSameAsGetTokens(Lexer* lexer,
+                           const std::string& text,
+                           int max_tasks) {
+  TokenSpans expected;
+  lexer->GetTokens(text, &expected);
+  TokenSpans tokens;
+  GetTokensInParallel(lexer, text, max_tasks, &tokens);
+  ASSERT_EQ(expected.size(), tokens.size()) << max_tasks;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    ASSERT_EQ(expected.offset(i), tokens.offset(i)) << max_tasks;
+    ASSERT_EQ(expected.length(i), tokens.length(i)) << max_tasks;
+    ASSERT_EQ(expected.type(i), tokens.type(i)) << max_tasks;
+  }
+}
+
+// |kLines| lines of code, except that those in [|first_line|, |end_line|)
+// are |first| and |last| and what's between them.
+std::string MakeText(size_t first_line,
+                     size_t end_line,
+                     const char* first,
+                     const char* last) {
+  std::string text;
+  for (size_t i = 0; i < kLines; ++i) {
+    if (i == first_line)
+      text += first;
+    else if (i + 1 == end_line)
+      text += last;
+    else
+      text += "int x = 0x10;  // \"text\"\n";
+  }
+  return text;
+}
+
+}  // namespace
+
+TEST(ParallelLexer, SameAsGetTokens) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  std::string text = MakeText(0, 0, "", "");
+  for (int max_tasks = 1; max_tasks <= 8; ++max_tasks)
+    ExpectSameAsGetTokens(lexer.get(), text, max_tasks);
+}
+
+TEST(ParallelLexer, ChunksThatDontStartInRootState) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  // Across where a chunk would start, for each number of chunks.
+  ExpectSameAsGetTokens(
+      lexer.get(), MakeText(kLines / 5, kLines * 2 / 5, "/*\n", "*/\n"), 8);
+  ExpectSameAsGetTokens(
+      lexer.get(), MakeText(kLines / 5, kLines * 4 / 5, "#if 0\n", "#endif\n"),
+      8);
+  ExpectSameAsGetTokens(
+      lexer.get(), MakeText(kLines / 3, kLines * 2 / 3, "/*\n", "*/\n"), 4);
+  // All of it, so none of the guesses are any good.
+  ExpectSameAsGetTokens(
+      lexer.get(), MakeText(0, kLines + 1, "/*\n", "*/\n"), 8);
+}
+
+TEST(ParallelLexer, SmallOrOneLine) {
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  ExpectSameAsGetTokens(lexer.get(), "", 8);
+  ExpectSameAsGetTokens(lexer.get(), "int x;\n", 8);
+  ExpectSameAsGetTokens(lexer.get(), std::string(1 << 20, 'x'), 8);
+}
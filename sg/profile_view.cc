@@ -0,0 +1,158 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/profile_view.h"
+
+#include <algorithm>
+
+#include "base/string_util.h"
+#include "sg/render/renderer.h"
+#include "sg/ui/skin.h"
+
+namespace {
+
+const int kHeaderPadding = 3;
+const int kFromSidePadding = 3;
+
+// Labels aren't even measured for boxes narrower than this.
+const int kMinLabelWidth = 20;
+
+// Warm colours, varied by function so that neighbours stand apart, but
+// always the same for a given function.
+Color GetFunctionColor(const string16& function) {
+  unsigned int hash = 0;
+  for (size_t i = 0; i < function.size(); ++i)
+    hash = hash * 31 + function[i];
+  return Color(205 + hash % 50,
+               90 + (hash / 50) % 120,
+               40 + (hash / 6000) % 40);
+}
+
+}  // namespace
+
+ProfileView::ProfileView()
+    : depth_(0),
+      scroll_helper_(this, Skin::current().text_line_height()) {
+  data_.sample_count = 0;
+}
+
+ProfileView::~ProfileView() {
+}
+
+void ProfileView::SetProfileData(const ProfileData& data) {
+  data_ = data;
+  depth_ = data_.nodes.empty() ? 0 : GetDepth(0);
+  wchar_t buf[256];
+  base::swprintf(buf, arraysize(buf),
+                 L"%d samples of %d stacks in %.0fms, target stopped "
+                 L"%.0fus per sample (max %.0fus)",
+                 data_.sample_count, data_.stack_count, data_.duration_ms,
+                 data_.mean_pause_us, data_.max_pause_us);
+  summary_ = buf;
+  Invalidate();
+}
+
+void ProfileView::Render(Renderer* renderer) {
+  const Skin& skin = Skin::current();
+
+  if (scroll_helper_.Update())
+    Invalidate();
+
+  renderer->SetDrawColor(skin.GetColorScheme().background());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), Height()));
+
+  if (!data_.nodes.empty() && data_.nodes[0].total > 0) {
+    RenderNode(renderer, 0, 0, kFromSidePadding,
+               Width() - kFromSidePadding * 2, scroll_helper_.GetOffset());
+  }
+
+  // Drawn last, so that it covers any partially scrolled out row.
+  int header_height = GetHeaderHeight();
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), header_height));
+  renderer->SetDrawColor(skin.GetColorScheme().border());
+  renderer->DrawHorizontalLine(0, 0, Width());
+  renderer->DrawFilledRect(Rect(0, header_height - 1, Width(), 1));
+  renderer->SetDrawColor(skin.GetColorScheme().margin_text());
+  renderer->RenderText(skin.ui_font(),
+                       Point(kFromSidePadding, kHeaderPadding),
+                       data_.sample_count > 0 ? summary_ : L"No profile");
+
+  scroll_helper_.RenderScrollIndicators(renderer, skin);
+}
+
+bool ProfileView::NotifyMouseWheel(
+    int delta, const InputModifiers& modifiers) {
+  bool invalidate, handled;
+  scroll_helper_.CommonMouseWheel(delta, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+bool ProfileView::NotifyKey(
+    InputKey key, bool down, const InputModifiers& modifiers) {
+  bool invalidate, handled;
+  scroll_helper_.CommonNotifyKey(key, down, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+int ProfileView::GetContentSize() {
+  return GetHeaderHeight() + Skin::current().text_line_height() * depth_;
+}
+
+int ProfileView::GetHeaderHeight() const {
+  return Skin::current().text_line_height() + kHeaderPadding * 2;
+}
+
+int ProfileView::GetDepth(int index) const {
+  int deepest_child = 0;
+  const ProfileNode& node = data_.nodes[index];
+  for (size_t i = 0; i < node.children.size(); ++i)
+    deepest_child = std::max(deepest_child, GetDepth(node.children[i]));
+  return deepest_child + 1;
+}
+
+void ProfileView::RenderNode(Renderer* renderer,
+                             int index,
+                             int depth,
+                             double x,
+                             double width,
+                             int y_pixel_scroll) {
+  const Skin& skin = Skin::current();
+  int line_height = skin.text_line_height();
+  int y = GetHeaderHeight() + depth * line_height - y_pixel_scroll;
+  if (width < 1 || y >= Height())
+    return;
+
+  const ProfileNode& node = data_.nodes[index];
+  if (y + line_height > 0) {
+    Rect box(static_cast<int>(x), y,
+             std::max(static_cast<int>(width) - 1, 1), line_height - 1);
+    string16 label = index == 0 ? L"all" : node.function;
+    renderer->SetDrawColor(index == 0 ? skin.GetColorScheme().margin()
+                                      : GetFunctionColor(node.function));
+    renderer->DrawFilledRect(box);
+    if (box.w >= kMinLabelWidth &&
+        renderer->MeasureText(skin.ui_font(), label).x <=
+            box.w - kFromSidePadding * 2) {
+      renderer->SetDrawColor(index == 0 ? skin.GetColorScheme().margin_text()
+                                        : Color(0, 0, 0));
+      renderer->RenderText(
+          skin.ui_font(), Point(box.x + kFromSidePadding, y), label);
+    }
+  }
+
+  // Whatever's left over is where this node was innermost.
+  double child_x = x;
+  for (size_t i = 0; i < node.children.size(); ++i) {
+    const ProfileNode& child = data_.nodes[node.children[i]];
+    double child_width = width * child.total / node.total;
+    RenderNode(renderer, node.children[i], depth + 1, child_x, child_width,
+               y_pixel_scroll);
+    child_x += child_width;
+  }
+}
@@ -0,0 +1,59 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_PROFILE_VIEW_H_
+#define SG_PROFILE_VIEW_H_
+
+#include "sg/backend/backend.h"
+#include "sg/basex/compiler_specific.h"
+#include "sg/basex/string16.h"
+#include "sg/ui/dockable.h"
+#include "sg/ui/scroll_helper.h"
+
+// Shows the last profile as an icicle graph: the root across the top, and
+// each function below its caller, as wide as the share of samples it was
+// on the stack for. Boxes too narrow to see aren't drawn, nor their callees.
+class ProfileView : public Dockable, public ScrollHelperDataProvider {
+ public:
+  ProfileView();
+  virtual ~ProfileView();
+
+  virtual void Render(Renderer* renderer) OVERRIDE;
+
+  virtual void SetProfileData(const ProfileData& data);
+
+  // Implementation of InputHandler:
+  virtual bool NotifyMouseWheel(
+      int delta, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyKey(
+      InputKey key, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool WantMouseEvents() OVERRIDE { return true; }
+  virtual bool WantKeyEvents() OVERRIDE { return true; }
+
+  // Implementation of ScrollHelperDataProvider:
+  virtual int GetContentSize() OVERRIDE;
+  virtual const Rect& GetScreenRect() const OVERRIDE {
+    return Dockable::GetScreenRect();
+  }
+
+ private:
+  int GetHeaderHeight() const;
+  int GetDepth(int index) const;
+  void RenderNode(Renderer* renderer,
+                  int index,
+                  int depth,
+                  double x,
+                  double width,
+                  int y_pixel_scroll);
+
+  ProfileData data_;
+  // Rows needed for the deepest stack.
+  int depth_;
+  string16 summary_;
+  ScrollHelper scroll_helper_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProfileView);
+};
+
+#endif  // SG_PROFILE_VIEW_H_
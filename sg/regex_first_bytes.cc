@@ -0,0 +1,125 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/regex_first_bytes.h"
+
+#include <algorithm>
+
+// Not with base/logging.h, as RE2's internal headers have their own.
+#include "re2/re2.h"
+#include "re2/regexp.h"
+
+namespace {
+
+const re2::Rune kMaxRune = 0x10ffff;
+
+unsigned char FirstByteOfRune(re2::Rune rune) {
+  if (rune < 0x80)
+    return static_cast<unsigned char>(rune);
+  if (rune < 0x800)
+    return static_cast<unsigned char>(0xc0 | (rune >> 6));
+  if (rune < 0x10000)
+    return static_cast<unsigned char>(0xe0 | (rune >> 12));
+  return static_cast<unsigned char>(0xf0 | (rune >> 18));
+}
+
+void AddRunes(re2::Rune lo, re2::Rune hi, bool* first_bytes) {
+  // The first byte only increases with the rune within each length of
+  // encoding.
+  const re2::Rune kLengthStarts[] = { 0, 0x80, 0x800, 0x10000, kMaxRune + 1 };
+  for (int i = 0; i < 4; ++i) {
+    re2::Rune start = std::max(lo, kLengthStarts[i]);
+    re2::Rune end = std::min(hi, kLengthStarts[i + 1] - 1);
+    if (start > end)
+      continue;
+    for (int b = FirstByteOfRune(start); b <= FirstByteOfRune(end); ++b)
+      first_bytes[b] = true;
+  }
+}
+
+void AddLiteral(re2::Regexp* regexp, re2::Rune rune, bool* first_bytes) {
+  AddRunes(rune, rune, first_bytes);
+  if (regexp->parse_flags() & re2::Regexp::FoldCase) {
+    // The other case, or for a few letters, non-ASCII ones (e.g. the Kelvin
+    // sign for k).
+    if (rune >= 'a' && rune <= 'z')
+      AddRunes(rune - 'a' + 'A', rune - 'a' + 'A', first_bytes);
+    else if (rune >= 'A' && rune <= 'Z')
+      AddRunes(rune - 'A' + 'a', rune - 'A' + 'a', first_bytes);
+    AddRunes(0x80, kMaxRune, first_bytes);
+  }
+}
+
+// Adds the first bytes of |regexp|'s matches, and returns whether it can
+// match the empty string, i.e. whether what follows it could start the
+// match too.
+bool AddFirstBytes(re2::Regexp* regexp, bool* first_bytes) {
+  switch (regexp->op()) {
+    case re2::kRegexpNoMatch:
+      return false;
+    case re2::kRegexpEmptyMatch:
+    case re2::kRegexpBeginLine:
+    case re2::kRegexpEndLine:
+    case re2::kRegexpWordBoundary:
+    case re2::kRegexpNoWordBoundary:
+    case re2::kRegexpBeginText:
+    case re2::kRegexpEndText:
+    case re2::kRegexpHaveMatch:
+      return true;
+    case re2::kRegexpLiteral:
+      AddLiteral(regexp, regexp->rune(), first_bytes);
+      return false;
+    case re2::kRegexpLiteralString:
+      if (regexp->nrunes() == 0)
+        return true;
+      AddLiteral(regexp, regexp->runes()[0], first_bytes);
+      return false;
+    case re2::kRegexpCharClass: {
+      re2::CharClass* cc = regexp->cc();
+      for (re2::CharClass::iterator it = cc->begin(); it != cc->end(); ++it)
+        AddRunes(it->lo, it->hi, first_bytes);
+      return false;
+    }
+    case re2::kRegexpConcat:
+      for (int i = 0; i < regexp->nsub(); ++i) {
+        if (!AddFirstBytes(regexp->sub()[i], first_bytes))
+          return false;
+      }
+      return true;
+    case re2::kRegexpAlternate: {
+      bool empty = false;
+      for (int i = 0; i < regexp->nsub(); ++i) {
+        if (AddFirstBytes(regexp->sub()[i], first_bytes))
+          empty = true;
+      }
+      return empty;
+    }
+    case re2::kRegexpStar:
+    case re2::kRegexpQuest:
+      AddFirstBytes(regexp->sub()[0], first_bytes);
+      return true;
+    case re2::kRegexpPlus:
+    case re2::kRegexpCapture:
+      return AddFirstBytes(regexp->sub()[0], first_bytes);
+    case re2::kRegexpRepeat:
+      return AddFirstBytes(regexp->sub()[0], first_bytes) ||
+             regexp->min() == 0;
+    default:
+      // e.g. \C, which matches any byte.
+      for (int b = 0; b < 256; ++b)
+        first_bytes[b] = true;
+      return false;
+  }
+}
+
+}  // namespace
+
+void GetRegexFirstBytes(const re2::RE2& regex, bool first_bytes[256]) {
+  for (int b = 0; b < 256; ++b)
+    first_bytes[b] = false;
+  if (!regex.Regexp() || AddFirstBytes(regex.Regexp(), first_bytes)) {
+    for (int b = 0; b < 256; ++b)
+      first_bytes[b] = true;
+  }
+}
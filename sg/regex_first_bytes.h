@@ -0,0 +1,17 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_REGEX_FIRST_BYTES_H_
+#define SG_REGEX_FIRST_BYTES_H_
+
+namespace re2 {
+class RE2;
+}
+
+// Sets |first_bytes[b]| for each byte b that an anchored match of |regex|
+// could start with (in UTF-8). If it can match the empty string, they're
+// all set. Conservative: bytes that can't start a match may be set too.
+void GetRegexFirstBytes(const re2::RE2& regex, bool first_bytes[256]);
+
+#endif  // SG_REGEX_FIRST_BYTES_H_
@@ -0,0 +1,65 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/regex_first_bytes.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "re2/re2.h"
+
+namespace {
+
+// The first bytes as a string, e.g. "0123456789".
+std::string FirstBytes(const std::string& regex) {
+  RE2 re2(regex);
+  bool first_bytes[256];
+  GetRegexFirstBytes(re2, first_bytes);
+  std::string result;
+  for (int b = 0; b < 256; ++b) {
+    if (first_bytes[b])
+      result += static_cast<char>(b);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(RegexFirstBytes, Basic) {
+  EXPECT_EQ("0123456789", FirstBytes("\\d+[LlUu]*"));
+  EXPECT_EQ("/", FirstBytes("/(\\\\\\n)?[*](.|\\n)*?[*](\\\\\\n)?/"));
+  EXPECT_EQ("\"L", FirstBytes("L?\""));
+  EXPECT_EQ("ft", FirstBytes("(true|false)\\b"));
+  EXPECT_EQ("\t\n\f\r ", FirstBytes("\\s+"));
+  // Anchors don't match anything themselves.
+  EXPECT_EQ("#", FirstBytes("^#"));
+  EXPECT_EQ("\t\n\f\r #", FirstBytes("^\\s*#endif.*?\\n"));
+  EXPECT_EQ("ab", FirstBytes("a{0,2}b"));
+}
+
+TEST(RegexFirstBytes, Utf8) {
+  // U+00E9 and U+20AC.
+  EXPECT_EQ("\xc3\xe2", FirstBytes("\xc3\xa9|\xe2\x82\xac"));
+  // Any valid lead byte, but not continuation bytes.
+  std::string any = FirstBytes("[^\\n]");
+  EXPECT_EQ(std::string::npos, any.find('\n'));
+  EXPECT_NE(std::string::npos, any.find('\xc2'));
+  EXPECT_NE(std::string::npos, any.find('\xf4'));
+  EXPECT_EQ(std::string::npos, any.find('\x80'));
+  EXPECT_EQ(std::string::npos, any.find('\xbf'));
+}
+
+TEST(RegexFirstBytes, MatchesEmpty) {
+  EXPECT_EQ(256, FirstBytes("a*").size());
+  EXPECT_EQ(256, FirstBytes("(a|)").size());
+}
+
+TEST(RegexFirstBytes, CaseInsensitive) {
+  std::string bytes = FirstBytes("(?i)k");
+  EXPECT_NE(std::string::npos, bytes.find('k'));
+  EXPECT_NE(std::string::npos, bytes.find('K'));
+  // The Kelvin sign.
+  EXPECT_NE(std::string::npos, bytes.find('\xe2'));
+}
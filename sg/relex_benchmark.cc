@@ -0,0 +1,109 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares lexing a whole file with relexing the line changed by a single
+// character edit, on a file made by repeating a source file to 100k lines.
+// Each edit is to a random line, and alternates between inserting a
+// character and deleting it again, so the file stays much the same.
+//
+//   out/relex_benchmark [source [edits]]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <memory>
+#include <string>
+
+#include "base/file_util.h"
+#include "base/string_number_conversions.h"
+#include "base/time.h"
+#include "sg/cpp_lexer.h"
+#include "sg/lexer.h"
+
+namespace {
+
+const char kDefaultSource[] = "sg/lexer.cc";
+const size_t kLines = 100000;
+const int kDefaultEdits = 1000;
+
+// Repeats |source| until it's |lines| lines long.
+std::string MakeLargeFile(const std::string& source, size_t lines) {
+  std::string result;
+  size_t line_count = 0;
+  while (line_count < lines) {
+    for (size_t i = 0; i < source.size() && line_count < lines; ++i) {
+      result += source[i];
+      if (source[i] == '\n')
+        ++line_count;
+    }
+    if (!source.empty() && source[source.size() - 1] != '\n') {
+      result += '\n';
+      ++line_count;
+    }
+  }
+  return result;
+}
+
+std::string GetLine(const LexedText& lexed, size_t line) {
+  size_t begin = lexed.line_start(line);
+  size_t end = line + 1 < lexed.line_count() ? lexed.line_start(line + 1)
+                                             : lexed.text().size();
+  return lexed.text().substr(begin, end - begin);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::string source_path = argc > 1 ? argv[1] : kDefaultSource;
+  int edits = kDefaultEdits;
+  if (argc > 2 && (!base::StringToInt(argv[2], &edits) || edits <= 0)) {
+    fprintf(stderr, "usage: relex_benchmark [source [edits]]\n");
+    return 1;
+  }
+  std::string source;
+  if (!file_util::ReadFileToString(base::FilePath::FromUTF8Unsafe(source_path),
+                                   &source) ||
+      source.empty()) {
+    fprintf(stderr, "couldn't read %s\n", source_path.c_str());
+    return 1;
+  }
+  std::string text = MakeLargeFile(source, kLines);
+
+  std::unique_ptr<Lexer> lexer(MakeCppLexer());
+  LexedText lexed;
+  base::TimeTicks start = base::TimeTicks::Now();
+  lexer->Lex(text, &lexed);
+  double lex_ms = (base::TimeTicks::Now() - start).InMillisecondsF();
+  printf("lex: %d lines, %d tokens in %.1fms\n",
+         static_cast<int>(lexed.line_count()),
+         static_cast<int>(lexed.tokens().size()),
+         lex_ms);
+
+  srand(1);
+  size_t relexed_lines = 0;
+  size_t line = 0;
+  std::string original;
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < edits; ++i) {
+    std::string new_line;
+    if (i % 2 == 0) {
+      line = rand() % (lexed.line_count() - 1);
+      original = GetLine(lexed, line);
+      new_line = original;
+      new_line.insert(rand() % new_line.size(), 1, 'x');
+    } else {
+      new_line = original;
+    }
+    size_t first, end;
+    lexer->RelexLines(line, 1, new_line, &lexed, &first, &end);
+    relexed_lines += end - first;
+  }
+  double edit_ms = (base::TimeTicks::Now() - start).InMillisecondsF();
+  printf("single character edits: %d in %.1fms, %.1fus each "
+         "(%.1f lines relexed on average, %.0fx faster than lexing)\n",
+         edits, edit_ms, edit_ms * 1000 / edits,
+         static_cast<double>(relexed_lines) / edits,
+         lex_ms * edits / edit_ms);
+  return 0;
+}
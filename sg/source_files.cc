@@ -4,17 +4,26 @@
 
 #include "sg/source_files.h"
 
+#include "sg/highlight_cache.h"
+
 SourceFiles::SourceFiles() {
 }
 
 SourceFiles::~SourceFiles() {
 }
 
-void SourceFiles::SetFileData(
-    const string16& filename, int mtime, const std::string& contents) {
-  SourceFileData data;
+uint64 SourceFiles::SetFileData(const string16& filename,
+                                base::Time mtime,
+                                int64 size,
+                                const std::string& contents) {
+  SourceFileData& data = files_[filename];
+  if (mtime.is_null() || data.mtime != mtime || data.size != size ||
+      !data.contents_hash) {
+    data.contents_hash = HighlightCache::HashContents(contents);
+  }
   data.filename = filename;
   data.mtime = mtime;
+  data.size = size;
   data.contents = contents;
-  files_[filename] = data;
+  return data.contents_hash;
 }
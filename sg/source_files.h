@@ -9,6 +9,7 @@
 #include <string>
 
 #include "base/basictypes.h"
+#include "base/time.h"
 #include "sg/basex/string16.h"
 
 // Model for source code.
@@ -17,14 +18,23 @@ class SourceFiles {
   SourceFiles();
   ~SourceFiles();
 
-  void SetFileData(
-      const string16& filename, int mtime, const std::string& contents);
+  // Returns the hash of |contents| (see HighlightCache), which is only
+  // worked out again if the file's mtime or size have changed since it was
+  // last set. A null mtime is unknown, and always hashed.
+  uint64 SetFileData(const string16& filename,
+                     base::Time mtime,
+                     int64 size,
+                     const std::string& contents);
 
  private:
   struct SourceFileData {
+    SourceFileData() : size(0), contents_hash(0) {}
+
     string16 filename;
-    int mtime;
+    base::Time mtime;
+    int64 size;
     std::string contents;
+    uint64 contents_hash;
   };
   std::map<string16, SourceFileData> files_;
 
@@ -12,7 +12,8 @@
 #include "base/string_piece.h"
 #include "base/utf_string_conversions.h"
 #include "sg/app_thread.h"
-#include "sg/cpp_lexer.h"
+#include "sg/breakpoint_list.h"
+#include "sg/debug_presenter_notify.h"
 #include "sg/lexer.h"
 #include "sg/render/texture.h"
 #include "sg/render/renderer.h"
@@ -20,78 +21,102 @@
 
 namespace {
 
+// Disabled breakpoints are drawn faded.
+const double kDisabledBreakpointAlpha = .3;
 
-// TODO(scottmg): Losing last line if doesn't end in \n.
-void SyntaxHighlight(const std::string& input, std::vector<Line>* lines) {
-  std::unique_ptr<Lexer> lexer(MakeCppLexer());
-  std::vector<Token> tokens;
-  lexer->GetTokensUnprocessed(input, &tokens);
-  Line current_line;
-  for (size_t i = 0; i < tokens.size(); ++i) {
-    const Token& token = tokens[i];
-    if (token.value == "\n") {
-      lines->push_back(current_line);
-      current_line.clear();
-    } else {
-      ColoredText fragment;
-      fragment.type = token.token;
-      fragment.text = UTF8ToUTF16(token.value);
-      current_line.push_back(fragment);
-      if (token.token == Lexer::CommentSingle) {
-        // Includes \n in its value so we don't otherwise see it.
-        lines->push_back(current_line);
-        current_line.clear();
-      }
-    }
-  }
-}
-
-std::vector<Line> HighlightOnFILE(std::string utf8_text) {
-  std::vector<Line> into;
-  // Sleep(10000);
-  SyntaxHighlight(utf8_text, &into);
-  return into;
+void TrimHighlightCacheOnFILE(const HighlightCache& cache) {
+  cache.Trim();
 }
 
 }  // namespace
 
 SourceView::SourceView()
-    : scroll_helper_(this, Skin::current().text_line_height()),
-      program_counter_line_(-1) {
+    : highlight_cache_(HighlightCache::GetDefaultDirectory()),
+      scroll_helper_(this, Skin::current().text_line_height()),
+      program_counter_line_(-1),
+      breakpoints_(NULL),
+      debug_presenter_notify_(NULL),
+      margin_width_(0) {
+  // Once a session is enough to keep it from growing without bound.
+  AppThread::PostTask(AppThread::FILE, FROM_HERE,
+      base::Bind(&TrimHighlightCacheOnFILE, highlight_cache_));
+}
+
+SourceView::~SourceView() {
+  StopHighlighting();
 }
 
-void SourceView::SetData(const std::string& utf8_text) {
-  lines_.clear();
+void SourceView::SetData(const std::string& utf8_text,
+                         uint64 contents_hash) {
+  StopHighlighting();
 
   // Add placeholder while we're processing.
   // TODO(jank): The file access happens on FILE too, but we could push the
   // placeholder from when we first queue the request to load the file.
-  ColoredText segment;
-  segment.type = Lexer::Text;
-  segment.text = L"Loading...";
-  Line line;
-  line.push_back(segment);
-  lines_.push_back(line);
-
-  // TODO(scottmg): There's a crazy amount of by-value copying going on here.
-  // Better than on-thread, but probably should RefPtr some structures instead.
-  AppThread::PostTaskAndReplyWithResult(AppThread::FILE, FROM_HERE,
-      base::Bind(&HighlightOnFILE,
-                 utf8_text),
-      base::Bind(&SourceView::CommitAfterHighlight, base::Unretained(this)));
+  lines_.SetPlainText("Loading...");
+
+  // The plain text comes back first, then the colors a piece at a time,
+  // those in view first.
+  highlighter_ = new ProgressiveHighlighter(utf8_text, this);
+  int line_height = Skin::current().text_line_height();
+  highlighter_->SetVisibleLines(GetFirstLineInView(),
+                                Height() / line_height + 1);
+  highlighter_->SetProgramCounterLine(program_counter_line_);
+  if (contents_hash)
+    highlighter_->SetCache(highlight_cache_, contents_hash);
+  highlighter_->Start();
   Invalidate();
 }
 
 void SourceView::SetProgramCounterLine(int line_number) {
   program_counter_line_ = line_number - 1;
+  if (highlighter_)
+    highlighter_->SetProgramCounterLine(program_counter_line_);
+  Invalidate();
+}
+
+void SourceView::SetFileName(const string16& filename) {
+  filename_ = filename;
+  Invalidate();
+}
+
+void SourceView::SetBreakpoints(const BreakpointList* breakpoints) {
+  breakpoints_ = breakpoints;
+  Invalidate();
+}
+
+void SourceView::BreakpointsChanged() {
   Invalidate();
 }
 
-void SourceView::CommitAfterHighlight(std::vector<Line> lines) {
-  lines_ = lines;
+void SourceView::SetDebugPresenterNotify(
+    DebugPresenterNotify* debug_presenter) {
+  debug_presenter_notify_ = debug_presenter;
+}
+
+void SourceView::OnPlainText(HighlightedText* plain) {
+  lines_.Swap(plain);
+  delete plain;
   Invalidate();
 }
 
+void SourceView::OnHighlightedLines(HighlightedLines* lines) {
+  lines_.SetLines(*lines);
+  delete lines;
+  Invalidate();
+}
+
+void SourceView::OnHighlightDone() {
+  highlighter_ = NULL;
+}
+
+void SourceView::StopHighlighting() {
+  if (highlighter_) {
+    highlighter_->Cancel();
+    highlighter_ = NULL;
+  }
+}
+
 int SourceView::GetFirstLineInView() {
   return scroll_helper_.GetOffset() / Skin::current().text_line_height();
 }
@@ -123,21 +148,26 @@ void SourceView::Render(Renderer* renderer) {
   // Not quite right, but probably close enough.
   int largest_numbers_width = renderer->MeasureText(
       skin.mono_font(),
-      base::IntToString16(lines_.size()).c_str()).x;
+      base::IntToString16(lines_.line_count()).c_str()).x;
   static const int left_margin = 5;
   static const int right_margin = 10;
   static const int indicator_width = line_height;
   static const int indicator_height = line_height;
   static const int indicator_and_margin = indicator_width + 5;
+  margin_width_ =
+      left_margin + largest_numbers_width + right_margin + indicator_and_margin;
   renderer->SetDrawColor(skin.GetColorScheme().margin());
-  renderer->DrawFilledRect(Rect(
-      0, 0,
-      left_margin + largest_numbers_width + right_margin + indicator_and_margin,
-      Height()));
+  renderer->DrawFilledRect(Rect(0, 0, margin_width_, Height()));
 
   int y_pixel_scroll = scroll_helper_.GetOffset();
 
-  for (size_t i = start_line; i < lines_.size(); ++i) {
+  // Those in view are colored first.
+  if (highlighter_)
+    highlighter_->SetVisibleLines(start_line, Height() / line_height + 1);
+
+  const string16& text = lines_.text();
+  string16 run_text;
+  for (size_t i = start_line; i < lines_.line_count(); ++i) {
     // Extra |line_height| added to height so that a full line is drawn at
     // the bottom when partial-line pixel scrolled.
     if (!LineInView(i))
@@ -153,15 +183,43 @@ void SourceView::Render(Renderer* renderer) {
                indicator_and_margin;
 
     // Source.
-    for (size_t j = 0; j < lines_[i].size(); ++j) {
-      renderer->SetDrawColor(ColorForTokenType(skin, lines_[i][j].type));
+    if (lines_.run_count(i) == 0) {
+      // Not colored yet.
+      run_text.assign(text, lines_.line_offset(i), lines_.line_length(i));
+      renderer->SetDrawColor(ColorForTokenType(skin, Lexer::Text));
       renderer->RenderText(
           skin.mono_font(),
           Point(x, i * line_height - y_pixel_scroll),
-          lines_[i][j].text.c_str());
-      x += renderer->MeasureText(
+          run_text);
+    }
+    size_t end_run = lines_.first_run(i) + lines_.run_count(i);
+    for (size_t j = lines_.first_run(i); j < end_run; ++j) {
+      const ColorRun& run = lines_.run(j);
+      run_text.assign(text, run.offset, run.length);
+      renderer->SetDrawColor(ColorForTokenType(skin, run.type));
+      renderer->RenderText(
           skin.mono_font(),
-          lines_[i][j].text.c_str()).x;
+          Point(x, i * line_height - y_pixel_scroll),
+          run_text);
+      x += renderer->MeasureText(skin.mono_font(), run_text).x;
+    }
+  }
+
+  if (breakpoints_ && !filename_.empty()) {
+    // Breakpoints are 1-based, lines_ isn't.
+    int last_line = start_line + Height() / line_height + 1;
+    size_t begin, end;
+    breakpoints_->FindInRange(
+        filename_, start_line + 1, last_line + 1, &begin, &end);
+    for (size_t i = begin; i < end; ++i) {
+      const BreakpointData& breakpoint = breakpoints_->at(i);
+      int y = (breakpoint.line_number - 1) * line_height - y_pixel_scroll;
+      renderer->DrawTexturedRectAlpha(
+          skin.breakpoint_texture(),
+          Rect(left_margin + largest_numbers_width + right_margin, y,
+               indicator_width, indicator_height),
+          breakpoint.enabled ? 1. : kDisabledBreakpointAlpha,
+          0, 0, 1, 1);
     }
   }
 
@@ -180,6 +238,7 @@ void SourceView::Render(Renderer* renderer) {
 
 bool SourceView::NotifyMouseMoved(
     int x, int y, int dx, int dy, const InputModifiers& modifiers) {
+  mouse_position_ = Point(x, y);
   return false;
 }
 
@@ -194,7 +253,16 @@ bool SourceView::NotifyMouseWheel(int delta, const InputModifiers& modifiers) {
 bool SourceView::NotifyMouseButton(
     int index, bool down, const InputModifiers& modifiers) {
   // TODO(scottmg): Selection, data view, etc.
-  return false;
+  if (index != 0 || !down || !debug_presenter_notify_ || filename_.empty())
+    return false;
+  if (mouse_position_.x - X() >= margin_width_)
+    return false;
+  int line = (mouse_position_.y - Y() + scroll_helper_.GetOffset()) /
+             Skin::current().text_line_height();
+  if (line < 0 || line >= static_cast<int>(lines_.line_count()))
+    return false;
+  debug_presenter_notify_->NotifyBreakpointToggled(filename_, line + 1);
+  return true;
 }
 
 bool SourceView::NotifyKey(
@@ -207,7 +275,7 @@ bool SourceView::NotifyKey(
 }
 
 int SourceView::GetContentSize() {
-  return Skin::current().text_line_height() * lines_.size();
+  return Skin::current().text_line_height() * lines_.line_count();
 }
 
 const Color& SourceView::ColorForTokenType(
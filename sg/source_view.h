@@ -9,27 +9,39 @@
 #include <vector>
 
 #include "sg/basex/string16.h"
+#include "sg/highlight_cache.h"
 #include "sg/lexer.h"
+#include "sg/syntax_highlight.h"
 #include "sg/ui/dockable.h"
 #include "sg/ui/scroll_helper.h"
 
+class BreakpointList;
+class DebugPresenterNotify;
 class Skin;
 
-struct ColoredText {
-  Lexer::TokenType type;
-  string16 text;
-};
-typedef std::vector<ColoredText> Line;
-
-class SourceView : public Dockable, public ScrollHelperDataProvider {
+class SourceView : public Dockable,
+                   public ScrollHelperDataProvider,
+                   public HighlightReceiver {
  public:
   SourceView();
+  virtual ~SourceView();
 
   virtual void Render(Renderer* renderer) OVERRIDE;
 
-  virtual void SetData(const std::string& utf8_text);
+  // |contents_hash| is the text's key in the HighlightCache, or 0 to not
+  // cache its colors.
+  virtual void SetData(const std::string& utf8_text, uint64 contents_hash);
   // TODO(scottmg): Probably some sort of "margin indicator" abstraction.
   virtual void SetProgramCounterLine(int line_number);
+  virtual void SetFileName(const string16& filename);
+
+  // |breakpoints| is owned by the presenter, which calls
+  // BreakpointsChanged() whenever it's modified. Only those on the lines in
+  // view are looked up when drawing.
+  virtual void SetBreakpoints(const BreakpointList* breakpoints);
+  virtual void BreakpointsChanged();
+  // Clicking in the margin toggles a breakpoint on that line.
+  virtual void SetDebugPresenterNotify(DebugPresenterNotify* debug_presenter);
 
   // Implementation of InputHandler:
   virtual bool NotifyMouseMoved(
@@ -49,21 +61,36 @@ class SourceView : public Dockable, public ScrollHelperDataProvider {
     return Dockable::GetScreenRect();
   }
 
+  // Implementation of HighlightReceiver:
+  virtual void OnPlainText(HighlightedText* plain) OVERRIDE;
+  virtual void OnHighlightedLines(HighlightedLines* lines) OVERRIDE;
+  virtual void OnHighlightDone() OVERRIDE;
+
 
  private:
   const Color& ColorForTokenType(const Skin& skin, Lexer::TokenType type);
-  void CommitAfterHighlight(std::vector<Line> lines);
+  void StopHighlighting();
   bool LineInView(int line_number);
   int GetFirstLineInView();
 
   float y_pixel_scroll_;
   float y_pixel_scroll_target_;
 
-  std::vector<Line> lines_;
+  HighlightedText lines_;
+  // While the lines are still being colored.
+  scoped_refptr<ProgressiveHighlighter> highlighter_;
+  HighlightCache highlight_cache_;
 
   ScrollHelper scroll_helper_;
 
   int program_counter_line_;
+
+  string16 filename_;
+  const BreakpointList* breakpoints_;
+  DebugPresenterNotify* debug_presenter_notify_;
+  Point mouse_position_;
+  // Width of the line number and indicator margin when last drawn.
+  int margin_width_;
 };
 
 #endif  // SG_SOURCE_VIEW_H_
@@ -0,0 +1,368 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/syntax_highlight.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/logging.h"
+#include "base/sys_info.h"
+#include "base/utf_string_conversions.h"
+#include "sg/app_thread.h"
+#include "sg/cpp_lexer.h"
+#include "sg/highlight_cache.h"
+#include "sg/parallel_lexer.h"
+
+namespace {
+
+// How many lines are lexed in each piece of work on the FILE thread, so
+// that it can get on with other things (and with the lines in view, if
+// they've changed) in between.
+const size_t kLinesPerPiece = 2000;
+
+// Lines above and below those in view, or the program counter, that are
+// colored along with them.
+const size_t kContextLines = 100;
+
+// Files at least this big are lexed in chunks on the worker pool, all at
+// once, rather than a piece at a time on the FILE thread.
+const size_t kMinParallelBytes = 1024 * 1024;
+
+// Where each line starts. A newline at the end doesn't start another.
+void GetLineStarts(const std::string& text, std::vector<size_t>* starts) {
+  starts->clear();
+  if (text.empty())
+    return;
+  starts->push_back(0);
+  for (size_t i = 0; i + 1 < text.size(); ++i) {
+    if (text[i] == '\n')
+      starts->push_back(i + 1);
+  }
+}
+
+// Splits |tokens| into runs for |line_count| lines from |first_line|, which
+// the tokens start at. Tokens that go over several lines, like comments,
+// are split at each newline.
+void GetHighlightedLines(const std::string& text,
+                         const TokenSpans& tokens,
+                         size_t first_line,
+                         size_t line_count,
+                         HighlightedLines* lines) {
+  lines->first_line = first_line;
+  lines->runs.clear();
+  lines->line_runs.assign(1, 0);
+  string16 converted;
+  uint32 column = 0;
+  for (size_t i = 0; i < tokens.size(); ++i) {
+    const char* piece = text.data() + tokens.offset(i);
+    const char* end = piece + tokens.length(i);
+    while (piece < end) {
+      const char* newline =
+          static_cast<const char*>(memchr(piece, '\n', end - piece));
+      const char* piece_end = newline ? newline : end;
+      if (piece_end > piece) {
+        UTF8ToUTF16(piece, piece_end - piece, &converted);
+        ColorRun run;
+        run.type = tokens.type(i);
+        run.offset = column;
+        run.length = static_cast<uint32>(converted.size());
+        lines->runs.push_back(run);
+        column += run.length;
+      }
+      if (!newline)
+        break;
+      lines->line_runs.push_back(static_cast<uint32>(lines->runs.size()));
+      column = 0;
+      piece = newline + 1;
+    }
+  }
+  // The last line of the text, if it doesn't end with a newline.
+  if (lines->line_runs.size() <= line_count)
+    lines->line_runs.push_back(static_cast<uint32>(lines->runs.size()));
+  DCHECK_EQ(line_count + 1, lines->line_runs.size());
+}
+
+// Adds |lines| to the end of |all|, which has the lines before them.
+void AppendLines(const HighlightedLines& lines, HighlightedLines* all) {
+  DCHECK_EQ(all->first_line + all->line_runs.size() - 1, lines.first_line);
+  uint32 first_run = static_cast<uint32>(all->runs.size());
+  all->runs.insert(all->runs.end(), lines.runs.begin(), lines.runs.end());
+  for (size_t i = 1; i < lines.line_runs.size(); ++i)
+    all->line_runs.push_back(first_run + lines.line_runs[i]);
+}
+
+}  // namespace
+
+HighlightedText::HighlightedText() : line_offsets_(1, 0) {
+}
+
+void HighlightedText::SetPlainText(const std::string& utf8_text) {
+  Clear();
+  std::vector<size_t> starts;
+  GetLineStarts(utf8_text, &starts);
+  for (size_t i = 0; i < starts.size(); ++i) {
+    size_t end = i + 1 < starts.size() ? starts[i + 1] : utf8_text.size();
+    if (end > starts[i] && utf8_text[end - 1] == '\n')
+      --end;
+    UTF8ToUTF16(utf8_text.data() + starts[i], end - starts[i], &converted_);
+    text_.append(converted_);
+    line_offsets_.push_back(static_cast<uint32>(text_.size()));
+  }
+  line_first_runs_.assign(starts.size(), 0);
+  line_run_counts_.assign(starts.size(), 0);
+}
+
+void HighlightedText::SetLines(const HighlightedLines& lines) {
+  size_t count = std::min(lines.line_runs.size() - 1,
+                          line_count() - std::min(lines.first_line,
+                                                  line_count()));
+  for (size_t i = 0; i < count; ++i) {
+    size_t line = lines.first_line + i;
+    size_t length = line_length(line);
+    line_first_runs_[line] = static_cast<uint32>(runs_.size());
+    for (size_t j = lines.line_runs[i]; j < lines.line_runs[i + 1]; ++j) {
+      // The text was converted a line at a time, and the runs a token at a
+      // time, so if it isn't valid UTF-8 they might not quite agree.
+      ColorRun run = lines.runs[j];
+      if (run.offset >= length)
+        break;
+      run.length = std::min<uint32>(run.length, length - run.offset);
+      run.offset += line_offsets_[line];
+      runs_.push_back(run);
+    }
+    line_run_counts_[line] =
+        static_cast<uint32>(runs_.size() - line_first_runs_[line]);
+  }
+}
+
+void HighlightedText::Clear() {
+  text_.clear();
+  line_offsets_.assign(1, 0);
+  runs_.clear();
+  line_first_runs_.clear();
+  line_run_counts_.clear();
+}
+
+void HighlightedText::Swap(HighlightedText* other) {
+  text_.swap(other->text_);
+  line_offsets_.swap(other->line_offsets_);
+  runs_.swap(other->runs_);
+  line_first_runs_.swap(other->line_first_runs_);
+  line_run_counts_.swap(other->line_run_counts_);
+}
+
+void SyntaxHighlight(const std::string& utf8_text,
+                     HighlightedText* highlighted) {
+  TokenSpans tokens;
+  GetTokensInParallel(GetCppLexer(), utf8_text,
+                      base::SysInfo::NumberOfProcessors(), &tokens);
+  highlighted->SetPlainText(utf8_text);
+  HighlightedLines lines;
+  GetHighlightedLines(utf8_text, tokens, 0, highlighted->line_count(),
+                      &lines);
+  highlighted->SetLines(lines);
+}
+
+ProgressiveHighlighter::ProgressiveHighlighter(const std::string& utf8_text,
+                                               HighlightReceiver* receiver)
+    : text_(utf8_text),
+      lexer_(NULL),
+      next_line_(0),
+      contents_hash_(0),
+      receiver_(receiver),
+      cancelled_(false),
+      visible_first_line_(0),
+      visible_line_count_(0),
+      program_counter_line_(-1) {
+}
+
+ProgressiveHighlighter::~ProgressiveHighlighter() {
+}
+
+void ProgressiveHighlighter::SetVisibleLines(size_t first_line,
+                                             size_t line_count) {
+  base::AutoLock lock(lock_);
+  visible_first_line_ = first_line;
+  visible_line_count_ = line_count;
+}
+
+void ProgressiveHighlighter::SetProgramCounterLine(int line) {
+  base::AutoLock lock(lock_);
+  program_counter_line_ = line;
+}
+
+void ProgressiveHighlighter::SetCache(const HighlightCache& cache,
+                                      uint64 contents_hash) {
+  cache_.reset(new HighlightCache(cache));
+  contents_hash_ = contents_hash;
+  all_lines_.first_line = 0;
+  all_lines_.runs.clear();
+  all_lines_.line_runs.assign(1, 0);
+}
+
+void ProgressiveHighlighter::Start() {
+  AppThread::PostTask(AppThread::FILE, FROM_HERE,
+      base::Bind(&ProgressiveHighlighter::HighlightNextPiece, this));
+}
+
+void ProgressiveHighlighter::Cancel() {
+  base::AutoLock lock(lock_);
+  cancelled_ = true;
+}
+
+void ProgressiveHighlighter::HighlightNextPiece() {
+  size_t visible_first_line, visible_line_count;
+  int program_counter_line;
+  {
+    base::AutoLock lock(lock_);
+    if (cancelled_)
+      return;
+    visible_first_line = visible_first_line_;
+    visible_line_count = visible_line_count_;
+    program_counter_line = program_counter_line_;
+  }
+
+  if (!lexer_) {
+    // Plain text first, which is quick.
+    lexer_ = GetCppLexer();
+    GetLineStarts(text_, &line_starts_);
+    colored_.resize(line_starts_.size());
+    lexer_->GetStartPosition(0, &next_position_);
+    HighlightedText* plain = new HighlightedText;
+    plain->SetPlainText(text_);
+    AppThread::PostTask(AppThread::UI, FROM_HERE,
+        base::Bind(&ProgressiveHighlighter::DeliverPlainText, this, plain));
+    // A file that's been highlighted before doesn't need lexing at all.
+    if (cache_) {
+      HighlightedLines* lines = new HighlightedLines;
+      if (cache_->Load(contents_hash_, text_, lines)) {
+        PostLines(lines);
+        Finish();
+        return;
+      }
+      delete lines;
+    }
+  } else if (!HighlightAhead(
+                 visible_first_line - std::min(visible_first_line,
+                                               kContextLines),
+                 visible_first_line + visible_line_count + kContextLines) &&
+             !(program_counter_line >= 0 &&
+               HighlightAhead(
+                   program_counter_line -
+                       std::min<size_t>(program_counter_line, kContextLines),
+                   program_counter_line + kContextLines))) {
+    HighlightedLines* lines = new HighlightedLines;
+    if (next_line_ == 0 && text_.size() >= kMinParallelBytes) {
+      // What's in view is done, so the rest can wait for all of it.
+      TokenSpans tokens;
+      GetTokensInParallel(lexer_, text_,
+                          base::SysInfo::NumberOfProcessors(), &tokens);
+      GetHighlightedLines(text_, tokens, 0, line_starts_.size(), lines);
+      next_line_ = line_starts_.size();
+    } else {
+      next_line_ = HighlightLines(
+          next_line_, next_line_ + kLinesPerPiece, &next_position_, lines);
+    }
+    if (cache_)
+      AppendLines(*lines, &all_lines_);
+    PostLines(lines);
+    if (next_line_ >= line_starts_.size()) {
+      // It's only a cache, so if it can't be written the file is just
+      // lexed again next time.
+      if (cache_)
+        cache_->Store(contents_hash_, text_, all_lines_);
+      Finish();
+      return;
+    }
+  }
+  AppThread::PostTask(AppThread::FILE, FROM_HERE,
+      base::Bind(&ProgressiveHighlighter::HighlightNextPiece, this));
+}
+
+bool ProgressiveHighlighter::HighlightAhead(size_t first_line,
+                                            size_t end_line) {
+  // Those before |next_line_| are colored correctly already.
+  first_line = std::max(first_line, next_line_);
+  end_line = std::min(end_line, line_starts_.size());
+  while (first_line < end_line && colored_[first_line])
+    ++first_line;
+  if (first_line >= end_line)
+    return false;
+  LexerPosition position;
+  lexer_->GetStartPosition(line_starts_[first_line], &position);
+  HighlightedLines* lines = new HighlightedLines;
+  HighlightLines(first_line, end_line, &position, lines);
+  PostLines(lines);
+  return true;
+}
+
+size_t ProgressiveHighlighter::HighlightLines(size_t first_line,
+                                              size_t end_line,
+                                              LexerPosition* position,
+                                              HighlightedLines* lines) {
+  size_t end = end_line < line_starts_.size() ? line_starts_[end_line]
+                                              : text_.size();
+  TokenSpans tokens;
+  lexer_->LexLines(text_, end, position, &tokens);
+  // It only stops at the end or the start of a line.
+  size_t stop_line = position->offset >= text_.size()
+                         ? line_starts_.size()
+                         : std::lower_bound(line_starts_.begin(),
+                                            line_starts_.end(),
+                                            position->offset) -
+                               line_starts_.begin();
+  GetHighlightedLines(text_, tokens, first_line, stop_line - first_line,
+                      lines);
+  std::fill(colored_.begin() + first_line, colored_.begin() + stop_line,
+            true);
+  return stop_line;
+}
+
+void ProgressiveHighlighter::PostLines(HighlightedLines* lines) {
+  AppThread::PostTask(AppThread::UI, FROM_HERE,
+      base::Bind(&ProgressiveHighlighter::DeliverLines, this, lines));
+}
+
+void ProgressiveHighlighter::Finish() {
+  // Everything's in the view now.
+  text_.clear();
+  all_lines_.runs.clear();
+  all_lines_.line_runs.clear();
+  AppThread::PostTask(AppThread::UI, FROM_HERE,
+      base::Bind(&ProgressiveHighlighter::DeliverDone, this));
+}
+
+void ProgressiveHighlighter::DeliverPlainText(HighlightedText* plain) {
+  {
+    base::AutoLock lock(lock_);
+    if (cancelled_) {
+      delete plain;
+      return;
+    }
+  }
+  receiver_->OnPlainText(plain);
+}
+
+void ProgressiveHighlighter::DeliverLines(HighlightedLines* lines) {
+  {
+    base::AutoLock lock(lock_);
+    if (cancelled_) {
+      delete lines;
+      return;
+    }
+  }
+  receiver_->OnHighlightedLines(lines);
+}
+
+void ProgressiveHighlighter::DeliverDone() {
+  {
+    base::AutoLock lock(lock_);
+    if (cancelled_)
+      return;
+  }
+  receiver_->OnHighlightDone();
+}
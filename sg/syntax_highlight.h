@@ -0,0 +1,177 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_SYNTAX_HIGHLIGHT_H_
+#define SG_SYNTAX_HIGHLIGHT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "sg/basex/string16.h"
+#include "sg/lexer.h"
+
+class HighlightCache;
+
+// A span of text drawn in one color.
+struct ColorRun {
+  Lexer::TokenType type;
+  uint32 offset;
+  uint32 length;
+};
+
+// The colors of a range of lines, with run offsets from the start of their
+// line.
+struct HighlightedLines {
+  size_t first_line;
+  std::vector<ColorRun> runs;
+  // Index in |runs| of the first run of each line, then of the end.
+  std::vector<uint32> line_runs;
+};
+
+// Text split into lines of color runs. All the lines share one buffer, which
+// doesn't include the line breaks, so that a large file is a few allocations
+// rather than a string per token. Lines start out plain, and are colored by
+// SetLines() in any order, e.g. those in view first.
+class HighlightedText {
+ public:
+  HighlightedText();
+
+  // Replaces the text with |utf8_text|, all plain.
+  void SetPlainText(const std::string& utf8_text);
+  // Colors the lines in |lines|, replacing the colors they had.
+  void SetLines(const HighlightedLines& lines);
+  void Clear();
+  void Swap(HighlightedText* other);
+
+  size_t line_count() const { return line_offsets_.size() - 1; }
+  const string16& text() const { return text_; }
+  // Where |line| is in text().
+  size_t line_offset(size_t line) const { return line_offsets_[line]; }
+  size_t line_length(size_t line) const {
+    return line_offsets_[line + 1] - line_offsets_[line];
+  }
+  // The runs on |line| are [first_run(line), first_run(line) +
+  // run_count(line)). A plain line has none.
+  size_t first_run(size_t line) const { return line_first_runs_[line]; }
+  size_t run_count(size_t line) const { return line_run_counts_[line]; }
+  // With its offset in text().
+  const ColorRun& run(size_t i) const { return runs_[i]; }
+
+ private:
+  string16 text_;
+  // Where each line starts in |text_|, then the end.
+  std::vector<uint32> line_offsets_;
+  // A line's runs are added after the others when it's colored, and those
+  // it had before are left. Lines are only colored more than once if they
+  // were in view before the rest were done, so little is wasted.
+  std::vector<ColorRun> runs_;
+  std::vector<uint32> line_first_runs_;
+  std::vector<uint32> line_run_counts_;
+  // Reused for converting each line.
+  string16 converted_;
+
+  DISALLOW_COPY_AND_ASSIGN(HighlightedText);
+};
+
+// Lexes |utf8_text| as C++ into |highlighted|.
+void SyntaxHighlight(const std::string& utf8_text,
+                     HighlightedText* highlighted);
+
+// Gets the results of a ProgressiveHighlighter, on the UI thread.
+class HighlightReceiver {
+ public:
+  virtual ~HighlightReceiver() {}
+
+  // The text, all plain. Ownership of |plain| is passed.
+  virtual void OnPlainText(HighlightedText* plain) = 0;
+  // Colors for some of the lines. Ownership of |lines| is passed.
+  virtual void OnHighlightedLines(HighlightedLines* lines) = 0;
+  // All the lines have been colored by lexing from the start.
+  virtual void OnHighlightDone() = 0;
+};
+
+// Highlights C++ a piece at a time on the FILE thread, so that a large file
+// can be shown straight away and colored as it goes: first as plain text,
+// then the lines in view and around the program counter, then all of it
+// from the start (for a very large file, all at once on the worker pool).
+// Lines done early are lexed as though nothing before them was left open,
+// so they can be colored wrongly (in a long comment, say) until the pass
+// from the start gets to them.
+class ProgressiveHighlighter
+    : public base::RefCountedThreadSafe<ProgressiveHighlighter> {
+ public:
+  ProgressiveHighlighter(const std::string& utf8_text,
+                         HighlightReceiver* receiver);
+
+  // Lines to color before the rest. Callable on any thread, at any time.
+  void SetVisibleLines(size_t first_line, size_t line_count);
+  // Zero-based, or -1 if there isn't one.
+  void SetProgramCounterLine(int line);
+  // Gets the colors from |cache| if they're there, and saves them there
+  // when done if not. |contents_hash| is the text's hash. Before Start().
+  void SetCache(const HighlightCache& cache, uint64 contents_hash);
+
+  // Posts the first piece of work to the FILE thread.
+  void Start();
+  // The receiver won't be called again. UI thread.
+  void Cancel();
+
+ private:
+  friend class base::RefCountedThreadSafe<ProgressiveHighlighter>;
+  ~ProgressiveHighlighter();
+
+  // Does a piece of the work and posts the next. FILE thread.
+  void HighlightNextPiece();
+  // Colors the lines in [|first_line|, |end_line|) if any of them haven't
+  // been, guessing the lexer's state. Returns false if there weren't any.
+  bool HighlightAhead(size_t first_line, size_t end_line);
+  // Lexes from |position|, which is at the start of |first_line|, to the
+  // start of |end_line| or a little past, and gets the colors of those
+  // lines into |lines|. Returns the line it stopped at.
+  size_t HighlightLines(size_t first_line,
+                        size_t end_line,
+                        LexerPosition* position,
+                        HighlightedLines* lines);
+  // Sends |lines| to the receiver, which takes ownership.
+  void PostLines(HighlightedLines* lines);
+  // Lets the receiver know all the lines are done.
+  void Finish();
+
+  // Pass results on to the receiver on the UI thread, unless cancelled.
+  void DeliverPlainText(HighlightedText* plain);
+  void DeliverLines(HighlightedLines* lines);
+  void DeliverDone();
+
+  // Only used on the FILE thread once started.
+  std::string text_;
+  // Set when the first piece is done.
+  const Lexer* lexer_;
+  std::vector<size_t> line_starts_;
+  // Lines before this have been colored by the pass from the start.
+  size_t next_line_;
+  LexerPosition next_position_;
+  // Lines that have been colored, either way.
+  std::vector<bool> colored_;
+  // If set, where the colors are looked for first, and saved when done.
+  std::unique_ptr<HighlightCache> cache_;
+  uint64 contents_hash_;
+  // The colors from the pass from the start so far, to be saved.
+  HighlightedLines all_lines_;
+
+  HighlightReceiver* receiver_;
+
+  base::Lock lock_;
+  bool cancelled_;
+  size_t visible_first_line_;
+  size_t visible_line_count_;
+  int program_counter_line_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProgressiveHighlighter);
+};
+
+#endif  // SG_SYNTAX_HIGHLIGHT_H_
@@ -0,0 +1,248 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/syntax_highlight.h"
+
+#include <gtest/gtest.h>
+
+#include "base/file_util.h"
+#include "base/message_loop.h"
+#include "base/stringprintf.h"
+#include "sg/highlight_cache.h"
+#include "sg/main_loop.h"
+
+namespace {
+
+string16 RunText(const HighlightedText& highlighted, size_t i) {
+  const ColorRun& run = highlighted.run(i);
+  return highlighted.text().substr(run.offset, run.length);
+}
+
+// The last run on |line|.
+size_t LastRun(const HighlightedText& highlighted, size_t line) {
+  return highlighted.first_run(line) + highlighted.run_count(line) - 1;
+}
+
+}  // namespace
+
+TEST(SyntaxHighlight, Lines) {
+  HighlightedText highlighted;
+  SyntaxHighlight("int x;  // x\n\nreturn 0;", &highlighted);
+  ASSERT_EQ(3, highlighted.line_count());
+  EXPECT_EQ(L"int x;  // xreturn 0;", highlighted.text());
+  EXPECT_EQ(0, highlighted.line_offset(0));
+  EXPECT_EQ(12, highlighted.line_length(0));
+  EXPECT_EQ(12, highlighted.line_offset(2));
+  EXPECT_EQ(9, highlighted.line_length(2));
+
+  EXPECT_EQ(0, highlighted.first_run(0));
+  size_t comment = LastRun(highlighted, 0);
+  EXPECT_EQ(Lexer::CommentSingle, highlighted.run(comment).type);
+  EXPECT_EQ(L"// x", RunText(highlighted, comment));
+
+  // Blank.
+  EXPECT_EQ(0, highlighted.run_count(1));
+
+  // The last line doesn't need a newline.
+  EXPECT_EQ(Lexer::Keyword,
+            highlighted.run(highlighted.first_run(2)).type);
+  EXPECT_EQ(L"return", RunText(highlighted, highlighted.first_run(2)));
+
+  SyntaxHighlight("int x;\n", &highlighted);
+  EXPECT_EQ(1, highlighted.line_count());
+  SyntaxHighlight("", &highlighted);
+  EXPECT_EQ(0, highlighted.line_count());
+}
+
+TEST(SyntaxHighlight, MultilineToken) {
+  HighlightedText highlighted;
+  SyntaxHighlight("a /* b\nc */ d\n", &highlighted);
+  ASSERT_EQ(2, highlighted.line_count());
+  size_t end_of_first = LastRun(highlighted, 0);
+  EXPECT_EQ(Lexer::CommentMultiline, highlighted.run(end_of_first).type);
+  EXPECT_EQ(L"/* b", RunText(highlighted, end_of_first));
+  size_t start_of_second = highlighted.first_run(1);
+  EXPECT_EQ(Lexer::CommentMultiline, highlighted.run(start_of_second).type);
+  EXPECT_EQ(L"c */", RunText(highlighted, start_of_second));
+}
+
+TEST(SyntaxHighlight, UnmatchedCharacter) {
+  // Nothing in the C++ lexer matches a backtick, but the rest of the line
+  // is still highlighted.
+  HighlightedText highlighted;
+  SyntaxHighlight("`int", &highlighted);
+  ASSERT_EQ(1, highlighted.line_count());
+  EXPECT_EQ(Lexer::Error, highlighted.run(0).type);
+  EXPECT_EQ(L"`", RunText(highlighted, 0));
+  EXPECT_EQ(Lexer::KeywordType, highlighted.run(1).type);
+}
+
+TEST(SyntaxHighlight, SetLinesRecolors) {
+  HighlightedText highlighted;
+  highlighted.SetPlainText("ab\ncd\n");
+  ASSERT_EQ(2, highlighted.line_count());
+  EXPECT_EQ(L"abcd", highlighted.text());
+  EXPECT_EQ(0, highlighted.run_count(0));
+  EXPECT_EQ(0, highlighted.run_count(1));
+
+  HighlightedLines lines;
+  lines.first_line = 1;
+  ColorRun run = { Lexer::Keyword, 0, 2 };
+  lines.runs.push_back(run);
+  lines.line_runs.push_back(0);
+  lines.line_runs.push_back(1);
+  highlighted.SetLines(lines);
+  EXPECT_EQ(0, highlighted.run_count(0));
+  ASSERT_EQ(1, highlighted.run_count(1));
+  EXPECT_EQ(L"cd", RunText(highlighted, highlighted.first_run(1)));
+
+  // Coloring it again replaces what it had, and runs past the end of the
+  // line are cut off.
+  lines.runs[0].type = Lexer::Name;
+  lines.runs[0].length = 5;
+  highlighted.SetLines(lines);
+  ASSERT_EQ(1, highlighted.run_count(1));
+  EXPECT_EQ(Lexer::Name, highlighted.run(highlighted.first_run(1)).type);
+  EXPECT_EQ(L"cd", RunText(highlighted, highlighted.first_run(1)));
+}
+
+namespace {
+
+class ProgressiveHighlighterWithAppThreads : public testing::Test {
+ public:
+  void SetUp() {
+    main_loop.Init();
+    main_loop.MainMessageLoopStart();
+    main_loop.CreateThreads();
+  }
+  void TearDown() {
+    main_loop.ShutdownThreadsAndCleanUp();
+  }
+  void Run() {
+    main_loop.MainMessageLoopRun();
+  }
+
+  MainLoop main_loop;
+};
+
+void ExpectSameColors(const HighlightedText& expected,
+                      const HighlightedText& highlighted) {
+  EXPECT_EQ(expected.text(), highlighted.text());
+  ASSERT_EQ(expected.line_count(), highlighted.line_count());
+  for (size_t line = 0; line < expected.line_count(); ++line) {
+    ASSERT_EQ(expected.run_count(line), highlighted.run_count(line)) << line;
+    for (size_t i = 0; i < expected.run_count(line); ++i) {
+      const ColorRun& expected_run = expected.run(expected.first_run(line) + i);
+      const ColorRun& run = highlighted.run(highlighted.first_run(line) + i);
+      EXPECT_EQ(expected_run.type, run.type) << line;
+      EXPECT_EQ(expected_run.offset, run.offset) << line;
+      EXPECT_EQ(expected_run.length, run.length) << line;
+    }
+  }
+}
+
+// Keeps what a ProgressiveHighlighter sends, as SourceView does.
+class TestReceiver : public HighlightReceiver {
+ public:
+  TestReceiver() : first_colored_line_(-1), done_(false) {}
+  virtual ~TestReceiver() {}
+
+  virtual void OnPlainText(HighlightedText* plain) OVERRIDE {
+    EXPECT_EQ(0, highlighted_.line_count());
+    highlighted_.Swap(plain);
+    delete plain;
+  }
+  virtual void OnHighlightedLines(HighlightedLines* lines) OVERRIDE {
+    EXPECT_FALSE(done_);
+    if (first_colored_line_ == -1)
+      first_colored_line_ = static_cast<int>(lines->first_line);
+    highlighted_.SetLines(*lines);
+    delete lines;
+  }
+  virtual void OnHighlightDone() OVERRIDE {
+    done_ = true;
+    MessageLoopForUI::current()->Quit();
+  }
+
+  const HighlightedText& highlighted() const { return highlighted_; }
+  int first_colored_line() const { return first_colored_line_; }
+  bool done() const { return done_; }
+
+ private:
+  HighlightedText highlighted_;
+  int first_colored_line_;
+  bool done_;
+};
+
+}  // namespace
+
+TEST_F(ProgressiveHighlighterWithAppThreads, SameAsSyntaxHighlight) {
+  // A comment that's open across the lines in view, so they're colored
+  // wrongly at first and put right by the pass from the start.
+  std::string text;
+  for (int i = 0; i < 10000; ++i) {
+    if (i == 4800)
+      text += "/*\n";
+    else if (i == 5050)
+      text += "*/\n";
+    else
+      text += base::StringPrintf("int x%d = %d;  // %d\n", i, i, i);
+  }
+
+  TestReceiver receiver;
+  scoped_refptr<ProgressiveHighlighter> highlighter(
+      new ProgressiveHighlighter(text, &receiver));
+  highlighter->SetVisibleLines(5000, 40);
+  highlighter->Start();
+  Run();
+  ASSERT_TRUE(receiver.done());
+  // The lines in view were colored first.
+  EXPECT_LT(0, receiver.first_colored_line());
+  EXPECT_GE(5000, receiver.first_colored_line());
+
+  HighlightedText expected;
+  SyntaxHighlight(text, &expected);
+  ExpectSameColors(expected, receiver.highlighted());
+}
+
+TEST_F(ProgressiveHighlighterWithAppThreads, Cache) {
+  base::FilePath directory(FILE_PATH_LITERAL("out/syntax_highlight_test"));
+  file_util::Delete(directory, true);
+  HighlightCache cache(directory);
+  std::string text = "int x;  // x\n/* a\nb */\n";
+  uint64 hash = HighlightCache::HashContents(text);
+  HighlightedText expected;
+  SyntaxHighlight(text, &expected);
+
+  // Lexed, and saved when done.
+  {
+    TestReceiver receiver;
+    scoped_refptr<ProgressiveHighlighter> highlighter(
+        new ProgressiveHighlighter(text, &receiver));
+    highlighter->SetCache(cache, hash);
+    highlighter->Start();
+    Run();
+    ASSERT_TRUE(receiver.done());
+    ExpectSameColors(expected, receiver.highlighted());
+  }
+  HighlightedLines lines;
+  ASSERT_TRUE(cache.Load(hash, text, &lines));
+
+  // Replaced by something lexing wouldn't give, to see that it's used.
+  lines.runs[0].type = Lexer::Error;
+  ASSERT_TRUE(cache.Store(hash, text, lines));
+  expected.SetLines(lines);
+  {
+    TestReceiver receiver;
+    scoped_refptr<ProgressiveHighlighter> highlighter(
+        new ProgressiveHighlighter(text, &receiver));
+    highlighter->SetCache(cache, hash);
+    highlighter->Start();
+    Run();
+    ASSERT_TRUE(receiver.done());
+    ExpectSameColors(expected, receiver.highlighted());
+    EXPECT_EQ(Lexer::Error, receiver.highlighted().run(0).type);
+  }
+  file_util::Delete(directory, true);
+}
@@ -0,0 +1,79 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/thread_list.h"
+
+#include <algorithm>
+
+namespace {
+
+bool IdLessThan(const ThreadData& thread, ThreadId thread_id) {
+  return thread.id < thread_id;
+}
+
+bool ThreadLessThan(const ThreadData& a, const ThreadData& b) {
+  return a.id < b.id;
+}
+
+}  // namespace
+
+ThreadList::ThreadList() {
+}
+
+ThreadList::~ThreadList() {
+}
+
+void ThreadList::Apply(const RetrievedThreadsData& data) {
+  if (data.complete) {
+    threads_ = data.threads;
+    std::sort(threads_.begin(), threads_.end(), ThreadLessThan);
+    return;
+  }
+  for (size_t i = 0; i < data.threads.size(); ++i)
+    Update(data.threads[i]);
+  for (size_t i = 0; i < data.exited.size(); ++i)
+    Remove(data.exited[i]);
+}
+
+void ThreadList::SetRunning(const ThreadsRunningData& data) {
+  for (size_t i = 0; i < data.thread_ids.size(); ++i) {
+    int index = IndexOf(data.thread_ids[i]);
+    if (index != -1)
+      threads_[index].state = THREAD_RUNNING;
+  }
+}
+
+void ThreadList::Clear() {
+  threads_.clear();
+}
+
+int ThreadList::IndexOf(ThreadId thread_id) const {
+  std::vector<ThreadData>::const_iterator it = std::lower_bound(
+      threads_.begin(), threads_.end(), thread_id, IdLessThan);
+  if (it == threads_.end() || it->id != thread_id)
+    return -1;
+  return static_cast<int>(it - threads_.begin());
+}
+
+void ThreadList::Update(const ThreadData& data) {
+  std::vector<ThreadData>::iterator it = std::lower_bound(
+      threads_.begin(), threads_.end(), data.id, IdLessThan);
+  if (it == threads_.end() || it->id != data.id) {
+    threads_.insert(it, data);
+    return;
+  }
+  // gdb doesn't report a frame for running threads, so keep the last one.
+  if (data.state == THREAD_RUNNING) {
+    it->target_id = data.target_id;
+    it->state = THREAD_RUNNING;
+    return;
+  }
+  *it = data;
+}
+
+void ThreadList::Remove(ThreadId thread_id) {
+  int index = IndexOf(thread_id);
+  if (index != -1)
+    threads_.erase(threads_.begin() + index);
+}
@@ -0,0 +1,47 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_THREAD_LIST_H_
+#define SG_THREAD_LIST_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
+
+// Model for the target's threads, in id order, with the top frame of each
+// as of when it last stopped. After the first retrieval the backend only
+// sends the threads that have changed, so the rest are kept from before.
+class ThreadList {
+ public:
+  ThreadList();
+  ~ThreadList();
+
+  // Applies a retrieval, which replaces everything if it's complete.
+  void Apply(const RetrievedThreadsData& data);
+
+  // Marks threads as running. Their last frame is kept until they're
+  // retrieved again.
+  void SetRunning(const ThreadsRunningData& data);
+
+  void Clear();
+
+  size_t size() const { return threads_.size(); }
+  const ThreadData& at(size_t i) const { return threads_.at(i); }
+
+  // Returns -1 if there's no thread |thread_id|.
+  int IndexOf(ThreadId thread_id) const;
+
+ private:
+  void Update(const ThreadData& data);
+  void Remove(ThreadId thread_id);
+
+  // Sorted by id. gdb numbers threads in creation order, so new ones are
+  // almost always appended.
+  std::vector<ThreadData> threads_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadList);
+};
+
+#endif  // SG_THREAD_LIST_H_
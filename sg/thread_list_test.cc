@@ -0,0 +1,101 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/thread_list.h"
+
+#include <gtest/gtest.h>
+
+#include "base/string_number_conversions.h"
+
+namespace {
+
+ThreadData Stopped(ThreadId id, const string16& function) {
+  ThreadData data;
+  data.id = id;
+  data.target_id = L"Thread " + base::IntToString16(id);
+  data.state = THREAD_STOPPED;
+  data.frame.address = 0x1000;
+  data.frame.function = function;
+  data.frame.line_number = 10;
+  return data;
+}
+
+ThreadData Running(ThreadId id) {
+  ThreadData data;
+  data.id = id;
+  data.target_id = L"Thread " + base::IntToString16(id);
+  data.state = THREAD_RUNNING;
+  data.frame.address = 0;
+  data.frame.line_number = 0;
+  return data;
+}
+
+}  // namespace
+
+TEST(ThreadList, Complete) {
+  ThreadList threads;
+  RetrievedThreadsData data;
+  data.complete = true;
+  data.threads.push_back(Stopped(3, L"c"));
+  data.threads.push_back(Stopped(1, L"a"));
+  data.threads.push_back(Stopped(2, L"b"));
+  threads.Apply(data);
+  ASSERT_EQ(3, threads.size());
+  EXPECT_EQ(1, threads.at(0).id);
+  EXPECT_EQ(L"c", threads.at(2).frame.function);
+
+  // Threads missing from a complete retrieval have gone away.
+  data.threads.erase(data.threads.begin());
+  threads.Apply(data);
+  ASSERT_EQ(2, threads.size());
+  EXPECT_EQ(-1, threads.IndexOf(3));
+  EXPECT_EQ(1, threads.IndexOf(2));
+}
+
+TEST(ThreadList, Incremental) {
+  ThreadList threads;
+  RetrievedThreadsData all;
+  all.complete = true;
+  for (int i = 1; i <= 2000; ++i)
+    all.threads.push_back(Stopped(i, L"Wait"));
+  threads.Apply(all);
+
+  RetrievedThreadsData changed;
+  changed.complete = false;
+  changed.threads.push_back(Stopped(1000, L"Work"));
+  changed.threads.push_back(Running(2001));
+  changed.exited.push_back(5);
+  threads.Apply(changed);
+  ASSERT_EQ(2000, threads.size());
+  EXPECT_EQ(-1, threads.IndexOf(5));
+  ASSERT_EQ(998, threads.IndexOf(1000));
+  EXPECT_EQ(L"Work", threads.at(998).frame.function);
+  EXPECT_EQ(L"Wait", threads.at(999).frame.function);
+  ASSERT_EQ(1999, threads.IndexOf(2001));
+  EXPECT_EQ(THREAD_RUNNING, threads.at(1999).state);
+}
+
+TEST(ThreadList, RunningKeepsFrame) {
+  ThreadList threads;
+  RetrievedThreadsData data;
+  data.complete = true;
+  data.threads.push_back(Stopped(1, L"a"));
+  data.threads.push_back(Stopped(2, L"b"));
+  threads.Apply(data);
+
+  ThreadsRunningData running;
+  running.thread_ids.push_back(2);
+  running.thread_ids.push_back(7);
+  threads.SetRunning(running);
+  EXPECT_EQ(THREAD_STOPPED, threads.at(0).state);
+  EXPECT_EQ(THREAD_RUNNING, threads.at(1).state);
+  EXPECT_EQ(L"b", threads.at(1).frame.function);
+
+  RetrievedThreadsData refreshed;
+  refreshed.complete = false;
+  refreshed.threads.push_back(Running(1));
+  threads.Apply(refreshed);
+  EXPECT_EQ(THREAD_RUNNING, threads.at(0).state);
+  EXPECT_EQ(L"a", threads.at(0).frame.function);
+}
@@ -0,0 +1,220 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/threads_view.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "sg/debug_presenter_notify.h"
+#include "sg/display_util.h"
+#include "sg/render/renderer.h"
+#include "sg/render/texture.h"
+#include "sg/ui/skin.h"
+
+namespace {
+
+const int kHeaderPadding = 3;
+const int kFromSidePadding = 3;
+const int kLeftMargin = 5;
+const int kRightMargin = 5;
+
+const wchar_t* const kColumnTitles[] = { L"Id", L"Name", L"Location" };
+// Where each column starts, as a fraction of the width.
+const double kColumnStarts[] = { 0., .1, .4 };
+
+}  // namespace
+
+ThreadsView::ThreadsView()
+    : current_thread_(0),
+      debug_presenter_notify_(NULL),
+      selected_thread_(0),
+      scroll_helper_(this, Skin::current().text_line_height()) {
+}
+
+ThreadsView::~ThreadsView() {
+}
+
+void ThreadsView::UpdateThreads(const RetrievedThreadsData& data) {
+  threads_.Apply(data);
+  Invalidate();
+}
+
+void ThreadsView::SetThreadsRunning(const ThreadsRunningData& data) {
+  threads_.SetRunning(data);
+  Invalidate();
+}
+
+void ThreadsView::SetCurrentThread(ThreadId thread_id) {
+  current_thread_ = thread_id;
+  Invalidate();
+}
+
+void ThreadsView::SetDebugPresenterNotify(
+    DebugPresenterNotify* debug_presenter) {
+  debug_presenter_notify_ = debug_presenter;
+}
+
+void ThreadsView::Render(Renderer* renderer) {
+  const Skin& skin = Skin::current();
+
+  if (scroll_helper_.Update())
+    Invalidate();
+
+  renderer->SetDrawColor(skin.GetColorScheme().background());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), Height()));
+
+  int line_height = skin.text_line_height();
+  int indicator_size = line_height;
+  int full_margin_width = kLeftMargin + indicator_size + kRightMargin;
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, full_margin_width, Height()));
+
+  int header_height = GetHeaderHeight();
+  int columns_width = Width() - full_margin_width;
+  int y_pixel_scroll = scroll_helper_.GetOffset();
+
+  // Only the rows in view, however many threads there are.
+  int first_row = y_pixel_scroll / line_height;
+  int last_row = std::min(
+      static_cast<int>(threads_.size()),
+      first_row + (Height() - header_height) / line_height + 2);
+  renderer->SetDrawColor(skin.GetColorScheme().text());
+  for (int i = first_row; i < last_row; ++i) {
+    const ThreadData& thread = threads_.at(i);
+    int y = header_height + i * line_height - y_pixel_scroll;
+    if (thread.id == selected_thread_) {
+      renderer->SetDrawColor(skin.GetColorScheme().border());
+      renderer->DrawFilledRect(
+          Rect(full_margin_width, y, Width() - full_margin_width,
+               line_height));
+      renderer->SetDrawColor(skin.GetColorScheme().text());
+    }
+    if (thread.id == current_thread_) {
+      renderer->DrawTexturedRect(
+          skin.pc_indicator_texture(),
+          Rect(kLeftMargin, y, indicator_size, indicator_size),
+          0, 0, 1, 1);
+    }
+    for (size_t j = 0; j < arraysize(kColumnTitles); ++j) {
+      int x = full_margin_width + kFromSidePadding +
+              static_cast<int>(kColumnStarts[j] * columns_width);
+      renderer->RenderText(
+          skin.ui_font(), Point(x, y), GetColumnText(thread, j));
+    }
+  }
+
+  // Drawn last, so that it covers any partially scrolled out row.
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), header_height));
+  renderer->SetDrawColor(skin.GetColorScheme().border());
+  renderer->DrawHorizontalLine(0, 0, Width());
+  renderer->DrawFilledRect(Rect(0, header_height - 1, Width(), 1));
+  renderer->SetDrawColor(skin.GetColorScheme().margin_text());
+  for (size_t j = 0; j < arraysize(kColumnTitles); ++j) {
+    int x = full_margin_width + kFromSidePadding +
+            static_cast<int>(kColumnStarts[j] * columns_width);
+    renderer->RenderText(
+        skin.ui_font(), Point(x, kHeaderPadding), kColumnTitles[j]);
+  }
+
+  scroll_helper_.RenderScrollIndicators(renderer, skin);
+}
+
+bool ThreadsView::NotifyMouseMoved(
+    int x, int y, int dx, int dy, const InputModifiers& modifiers) {
+  mouse_position_ = Point(x, y);
+  return false;
+}
+
+bool ThreadsView::NotifyMouseWheel(
+    int delta, const InputModifiers& modifiers) {
+  bool invalidate, handled;
+  scroll_helper_.CommonMouseWheel(delta, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+bool ThreadsView::NotifyMouseButton(
+    int index, bool down, const InputModifiers& modifiers) {
+  if (index != 0 || !down)
+    return false;
+  int y = mouse_position_.y - Y() - GetHeaderHeight();
+  if (y < 0)
+    return false;
+  int row = (y + scroll_helper_.GetOffset()) /
+            Skin::current().text_line_height();
+  if (row >= static_cast<int>(threads_.size()))
+    return false;
+  selected_thread_ = threads_.at(row).id;
+  Invalidate();
+  return true;
+}
+
+bool ThreadsView::NotifyKey(
+    InputKey key, bool down, const InputModifiers& modifiers) {
+  int row_count = static_cast<int>(threads_.size());
+  // The thread may have exited since it was selected.
+  int selected = threads_.IndexOf(selected_thread_);
+  if (down && (key == kUp || key == kDown) && row_count > 0) {
+    selected = key == kUp ? std::max(selected - 1, 0)
+                          : std::min(selected + 1, row_count - 1);
+    selected_thread_ = threads_.at(selected).id;
+    Invalidate();
+    return true;
+  }
+  if (down && selected >= 0 && key == kReturn) {
+    debug_presenter_notify_->NotifyThreadSelected(selected_thread_);
+    return true;
+  }
+  if (down && selected >= 0 && key == kSpace) {
+    if (threads_.at(selected).state == THREAD_RUNNING)
+      debug_presenter_notify_->NotifyThreadInterrupt(selected_thread_);
+    else
+      debug_presenter_notify_->NotifyThreadContinue(selected_thread_);
+    return true;
+  }
+  bool invalidate, handled;
+  scroll_helper_.CommonNotifyKey(key, down, modifiers, &invalidate, &handled);
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+int ThreadsView::GetContentSize() {
+  return GetHeaderHeight() +
+         Skin::current().text_line_height() * threads_.size();
+}
+
+int ThreadsView::GetHeaderHeight() const {
+  return Skin::current().text_line_height() + kHeaderPadding * 2;
+}
+
+string16 ThreadsView::GetColumnText(const ThreadData& thread,
+                                    int column) const {
+  switch (column) {
+    case 0:
+      return base::IntToString16(thread.id);
+    case 1:
+      return thread.target_id;
+    case 2: {
+      if (thread.state == THREAD_RUNNING)
+        return L"Running";
+      const FrameData& frame = thread.frame;
+      if (!frame.filename.empty()) {
+        return frame.function + L" " +
+               ToPlatformFileAndLine(frame.filename, frame.line_number);
+      }
+      wchar_t buf[64];
+      base::swprintf(buf, arraysize(buf), L"0x%lx", frame.address);
+      return frame.function + L" " + buf;
+    }
+    default:
+      NOTREACHED();
+      return L"";
+  }
+}
@@ -0,0 +1,67 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_THREADS_VIEW_H_
+#define SG_THREADS_VIEW_H_
+
+#include "sg/backend/backend.h"
+#include "sg/basex/compiler_specific.h"
+#include "sg/basex/string16.h"
+#include "sg/thread_list.h"
+#include "sg/ui/dockable.h"
+#include "sg/ui/scroll_helper.h"
+
+class DebugPresenterNotify;
+
+// Lists the target's threads. Rows are only formatted and drawn when they're
+// scrolled into view, so that it stays responsive with thousands of threads.
+// Up and Down select, Enter makes the selected thread the current one, and
+// Space continues or interrupts it.
+class ThreadsView : public Dockable, public ScrollHelperDataProvider {
+ public:
+  ThreadsView();
+  virtual ~ThreadsView();
+
+  virtual void Render(Renderer* renderer) OVERRIDE;
+
+  virtual void UpdateThreads(const RetrievedThreadsData& data);
+  virtual void SetThreadsRunning(const ThreadsRunningData& data);
+  virtual void SetCurrentThread(ThreadId thread_id);
+  virtual void SetDebugPresenterNotify(DebugPresenterNotify* debug_presenter);
+
+  // Implementation of InputHandler:
+  virtual bool NotifyMouseMoved(
+      int x, int y, int dx, int dy, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyMouseWheel(
+      int delta, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyMouseButton(
+      int index, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyKey(
+      InputKey key, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool WantMouseEvents() OVERRIDE { return true; }
+  virtual bool WantKeyEvents() OVERRIDE { return true; }
+
+  // Implementation of ScrollHelperDataProvider:
+  virtual int GetContentSize() OVERRIDE;
+  virtual const Rect& GetScreenRect() const OVERRIDE {
+    return Dockable::GetScreenRect();
+  }
+
+ private:
+  int GetHeaderHeight() const;
+  string16 GetColumnText(const ThreadData& thread, int column) const;
+
+  ThreadList threads_;
+  ThreadId current_thread_;
+  DebugPresenterNotify* debug_presenter_notify_;
+  // By id rather than row, as rows move when threads come and go. 0 if
+  // nothing's selected.
+  ThreadId selected_thread_;
+  Point mouse_position_;
+  ScrollHelper scroll_helper_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadsView);
+};
+
+#endif  // SG_THREADS_VIEW_H_
@@ -0,0 +1,99 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/tracepoint_log.h"
+
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "base/strings/string_split.h"
+#include "base/utf_string_conversions.h"
+
+bool ParseTracepointSpec(const string16& text, TracepointSpec* spec) {
+  size_t format_begin = text.find(L'"');
+  if (format_begin == string16::npos)
+    return false;
+  // The location's separated from the format by a comma.
+  string16 location;
+  TrimWhitespace(text.substr(0, format_begin), TRIM_ALL, &location);
+  if (location.empty() || location[location.size() - 1] != L',')
+    return false;
+  location.erase(location.size() - 1);
+  TrimWhitespace(location, TRIM_TRAILING, &location);
+  if (location.empty())
+    return false;
+
+  size_t format_end = format_begin + 1;
+  for (; format_end < text.size() && text[format_end] != L'"'; ++format_end) {
+    if (text[format_end] == L'\\')
+      ++format_end;
+  }
+  if (format_end >= text.size())
+    return false;
+
+  string16 rest;
+  TrimWhitespace(text.substr(format_end + 1), TRIM_ALL, &rest);
+  string16 arguments;
+  if (!rest.empty()) {
+    if (rest[0] != L',')
+      return false;
+    TrimWhitespace(rest.substr(1), TRIM_ALL, &arguments);
+    if (arguments.empty())
+      return false;
+  }
+
+  spec->location = location;
+  spec->format = text.substr(format_begin + 1, format_end - format_begin - 1);
+  spec->arguments = arguments;
+  return true;
+}
+
+bool ParseTracepointFile(const std::string& utf8_text,
+                         std::vector<TracepointSpec>* specs,
+                         string16* error) {
+  std::vector<string16> lines;
+  base::SplitString(UTF8ToUTF16(utf8_text), L'\n', &lines);
+  std::vector<TracepointSpec> result;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    string16 line;
+    TrimWhitespace(lines[i], TRIM_ALL, &line);
+    if (line.empty() || line[0] == L'#')
+      continue;
+    TracepointSpec spec;
+    if (!ParseTracepointSpec(line, &spec)) {
+      *error = L"line " + base::SizeTToString16(i + 1) +
+               L": expected location,\"format\"[,arguments]";
+      return false;
+    }
+    result.push_back(spec);
+  }
+  specs->swap(result);
+  return true;
+}
+
+TracepointLog::TracepointLog(size_t max_hits)
+    : max_hits_(max_hits),
+      total_(0) {
+}
+
+TracepointLog::~TracepointLog() {
+}
+
+void TracepointLog::Append(const TracepointOutputData& data) {
+  total_ += data.hits.size();
+  // A batch bigger than the whole log only leaves its end.
+  size_t skip = 0;
+  if (data.hits.size() > max_hits_) {
+    skip = data.hits.size() - max_hits_;
+    hits_.clear();
+  }
+  size_t keep = max_hits_ - (data.hits.size() - skip);
+  if (hits_.size() > keep)
+    hits_.erase(hits_.begin(), hits_.begin() + (hits_.size() - keep));
+  hits_.insert(hits_.end(), data.hits.begin() + skip, data.hits.end());
+}
+
+void TracepointLog::Clear() {
+  hits_.clear();
+  total_ = 0;
+}
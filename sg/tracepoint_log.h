@@ -0,0 +1,63 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_TRACEPOINT_LOG_H_
+#define SG_TRACEPOINT_LOG_H_
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "sg/backend/backend.h"
+#include "sg/basex/string16.h"
+
+// A tracepoint as written in gdb's dprintf syntax, e.g.
+//   foo.cc:123,"i=%d name=%s\n",i,name.c_str()
+// |format| is kept as written, escapes and all, for the debugger to
+// interpret.
+class TracepointSpec {
+ public:
+  string16 location;
+  string16 format;
+  // Comma separated, or empty if there aren't any.
+  string16 arguments;
+};
+
+bool ParseTracepointSpec(const string16& text, TracepointSpec* spec);
+
+// One tracepoint per line, ignoring blank lines and those starting with #.
+// On failure, |error| says which line is wrong.
+bool ParseTracepointFile(const std::string& utf8_text,
+                         std::vector<TracepointSpec>* specs,
+                         string16* error);
+
+// Model for tracepoint output, in the order it was printed. Only the most
+// recent |max_hits| are kept, so that a tracepoint in a hot loop can run
+// for as long as it likes.
+class TracepointLog {
+ public:
+  explicit TracepointLog(size_t max_hits);
+  ~TracepointLog();
+
+  void Append(const TracepointOutputData& data);
+  void Clear();
+
+  size_t size() const { return hits_.size(); }
+  const TracepointHit& at(size_t i) const { return hits_[i]; }
+
+  // Everything appended since the last Clear(), and how much of that has
+  // been dropped to make room.
+  int64 total() const { return total_; }
+  int64 dropped() const { return total_ - hits_.size(); }
+
+ private:
+  size_t max_hits_;
+  std::deque<TracepointHit> hits_;
+  int64 total_;
+
+  DISALLOW_COPY_AND_ASSIGN(TracepointLog);
+};
+
+#endif  // SG_TRACEPOINT_LOG_H_
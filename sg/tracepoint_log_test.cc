@@ -0,0 +1,89 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/tracepoint_log.h"
+
+#include <gtest/gtest.h>
+
+#include "base/string_number_conversions.h"
+
+namespace {
+
+TracepointOutputData Hits(int tracepoint_id, int first, int count) {
+  TracepointOutputData data;
+  for (int i = first; i < first + count; ++i) {
+    TracepointHit hit;
+    hit.tracepoint_id = tracepoint_id;
+    hit.text = base::IntToString16(i);
+    data.hits.push_back(hit);
+  }
+  return data;
+}
+
+}  // namespace
+
+TEST(TracepointLog, ParseSpec) {
+  TracepointSpec spec;
+  ASSERT_TRUE(ParseTracepointSpec(
+      L"foo.cc:123, \"i=%d, s=\\\"%s\\\"\\n\" , i, f(a, b)", &spec));
+  EXPECT_EQ(L"foo.cc:123", spec.location);
+  EXPECT_EQ(L"i=%d, s=\\\"%s\\\"\\n", spec.format);
+  EXPECT_EQ(L"i, f(a, b)", spec.arguments);
+
+  ASSERT_TRUE(ParseTracepointSpec(L"Function,\"here\"", &spec));
+  EXPECT_EQ(L"Function", spec.location);
+  EXPECT_EQ(L"here", spec.format);
+  EXPECT_EQ(L"", spec.arguments);
+
+  EXPECT_FALSE(ParseTracepointSpec(L"Function", &spec));
+  EXPECT_FALSE(ParseTracepointSpec(L"\"no location\"", &spec));
+  EXPECT_FALSE(ParseTracepointSpec(L"Function \"no comma\"", &spec));
+  EXPECT_FALSE(ParseTracepointSpec(L"Function,\"unterminated", &spec));
+  EXPECT_FALSE(ParseTracepointSpec(L"Function,\"x\" i", &spec));
+  EXPECT_FALSE(ParseTracepointSpec(L"Function,\"x\",", &spec));
+}
+
+TEST(TracepointLog, ParseFile) {
+  std::vector<TracepointSpec> specs;
+  string16 error;
+  ASSERT_TRUE(ParseTracepointFile(
+      "# Comments and blank lines are skipped.\n"
+      "\n"
+      "a.cc:1,\"a\"\r\n"
+      "  b.cc:2,\"b %d\",x\n",
+      &specs, &error));
+  ASSERT_EQ(2, specs.size());
+  EXPECT_EQ(L"a.cc:1", specs[0].location);
+  EXPECT_EQ(L"x", specs[1].arguments);
+
+  EXPECT_FALSE(ParseTracepointFile("a.cc:1,\"a\"\nb.cc:2\n", &specs, &error));
+  EXPECT_EQ(L"line 2: expected location,\"format\"[,arguments]", error);
+  // Left alone on failure.
+  EXPECT_EQ(2, specs.size());
+}
+
+TEST(TracepointLog, Bounded) {
+  TracepointLog log(100);
+  log.Append(Hits(1, 0, 60));
+  log.Append(Hits(2, 60, 60));
+  EXPECT_EQ(120, log.total());
+  EXPECT_EQ(20, log.dropped());
+  ASSERT_EQ(100, log.size());
+  EXPECT_EQ(L"20", log.at(0).text);
+  EXPECT_EQ(1, log.at(39).tracepoint_id);
+  EXPECT_EQ(2, log.at(40).tracepoint_id);
+  EXPECT_EQ(L"119", log.at(99).text);
+
+  // More than fits at once.
+  log.Append(Hits(3, 120, 250));
+  EXPECT_EQ(370, log.total());
+  ASSERT_EQ(100, log.size());
+  EXPECT_EQ(L"270", log.at(0).text);
+  EXPECT_EQ(L"369", log.at(99).text);
+
+  log.Clear();
+  EXPECT_EQ(0, log.size());
+  EXPECT_EQ(0, log.total());
+  EXPECT_EQ(0, log.dropped());
+}
@@ -0,0 +1,145 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sg/tracepoint_log_view.h"
+
+#include <algorithm>
+
+#include "base/string_number_conversions.h"
+#include "sg/render/renderer.h"
+#include "sg/ui/skin.h"
+
+namespace {
+
+const int kHeaderPadding = 3;
+const int kFromSidePadding = 3;
+
+// Enough for a few seconds of a tracepoint in a hot loop. Older output is
+// dropped.
+const size_t kMaxHits = 200000;
+
+}  // namespace
+
+TracepointLogView::TracepointLogView()
+    : log_(kMaxHits),
+      following_(true),
+      scroll_helper_(this, Skin::current().text_line_height()) {
+}
+
+TracepointLogView::~TracepointLogView() {
+}
+
+void TracepointLogView::AddTracepointOutput(const TracepointOutputData& data) {
+  log_.Append(data);
+  if (following_)
+    ScrollToLatest();
+  Invalidate();
+}
+
+void TracepointLogView::Clear() {
+  log_.Clear();
+  following_ = true;
+  scroll_helper_.ScrollToBeginning();
+  Invalidate();
+}
+
+void TracepointLogView::Render(Renderer* renderer) {
+  const Skin& skin = Skin::current();
+
+  if (scroll_helper_.Update())
+    Invalidate();
+
+  renderer->SetDrawColor(skin.GetColorScheme().background());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), Height()));
+
+  int line_height = skin.text_line_height();
+  int header_height = GetHeaderHeight();
+  int y_pixel_scroll = scroll_helper_.GetOffset();
+  int id_width = renderer->MeasureText(skin.mono_font(), L"9999 ").x;
+
+  // Only the rows in view, however much has been logged.
+  int first_row = y_pixel_scroll / line_height;
+  int last_row = std::min(
+      static_cast<int>(log_.size()),
+      first_row + (Height() - header_height) / line_height + 2);
+  for (int i = first_row; i < last_row; ++i) {
+    const TracepointHit& hit = log_.at(i);
+    int y = header_height + i * line_height - y_pixel_scroll;
+    renderer->SetDrawColor(skin.GetColorScheme().margin_text());
+    renderer->RenderText(skin.mono_font(),
+                         Point(kFromSidePadding, y),
+                         base::IntToString16(hit.tracepoint_id));
+    renderer->SetDrawColor(skin.GetColorScheme().text());
+    renderer->RenderText(skin.mono_font(),
+                         Point(kFromSidePadding + id_width, y),
+                         hit.text);
+  }
+
+  // Drawn last, so that it covers any partially scrolled out row.
+  string16 summary = L"No tracepoint output";
+  if (log_.total() > 0) {
+    summary = base::Int64ToString16(log_.total()) + L" hits";
+    if (log_.dropped() > 0) {
+      summary += L", oldest " + base::Int64ToString16(log_.dropped()) +
+                 L" dropped";
+    }
+  }
+  renderer->SetDrawColor(skin.GetColorScheme().margin());
+  renderer->DrawFilledRect(Rect(0, 0, Width(), header_height));
+  renderer->SetDrawColor(skin.GetColorScheme().border());
+  renderer->DrawHorizontalLine(0, 0, Width());
+  renderer->DrawFilledRect(Rect(0, header_height - 1, Width(), 1));
+  renderer->SetDrawColor(skin.GetColorScheme().margin_text());
+  renderer->RenderText(
+      skin.ui_font(), Point(kFromSidePadding, kHeaderPadding), summary);
+
+  scroll_helper_.RenderScrollIndicators(renderer, skin);
+}
+
+bool TracepointLogView::NotifyMouseWheel(
+    int delta, const InputModifiers& modifiers) {
+  bool invalidate, handled;
+  scroll_helper_.CommonMouseWheel(delta, modifiers, &invalidate, &handled);
+  // Scrolling back stops the view jumping to new output.
+  if (delta > 0)
+    following_ = false;
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+bool TracepointLogView::NotifyKey(
+    InputKey key, bool down, const InputModifiers& modifiers) {
+  if (key == kEnd && down) {
+    following_ = true;
+    ScrollToLatest();
+    Invalidate();
+    return true;
+  }
+  bool invalidate, handled;
+  scroll_helper_.CommonNotifyKey(key, down, modifiers, &invalidate, &handled);
+  if (key == kUp || key == kPageUp || key == kHome ||
+      (key == kSpace && modifiers.ShiftPressed())) {
+    following_ = false;
+  }
+  if (invalidate)
+    Invalidate();
+  return handled;
+}
+
+int TracepointLogView::GetContentSize() {
+  return GetHeaderHeight() +
+         Skin::current().text_line_height() * log_.size();
+}
+
+int TracepointLogView::GetHeaderHeight() const {
+  return Skin::current().text_line_height() + kHeaderPadding * 2;
+}
+
+void TracepointLogView::ScrollToLatest() {
+  // ScrollToEnd() leaves the last row at the top, so back up by a screen.
+  scroll_helper_.ScrollToEnd();
+  scroll_helper_.ScrollPixels(
+      -(Height() - GetHeaderHeight() - Skin::current().text_line_height()));
+}
@@ -0,0 +1,54 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SG_TRACEPOINT_LOG_VIEW_H_
+#define SG_TRACEPOINT_LOG_VIEW_H_
+
+#include "sg/backend/backend.h"
+#include "sg/basex/compiler_specific.h"
+#include "sg/basex/string16.h"
+#include "sg/tracepoint_log.h"
+#include "sg/ui/dockable.h"
+#include "sg/ui/scroll_helper.h"
+
+// Shows tracepoint output as it arrives, a batch at a time. Only the rows in
+// view are drawn, and it keeps up with the newest output until it's
+// scrolled back from the end, and again after End.
+class TracepointLogView : public Dockable, public ScrollHelperDataProvider {
+ public:
+  TracepointLogView();
+  virtual ~TracepointLogView();
+
+  virtual void Render(Renderer* renderer) OVERRIDE;
+
+  virtual void AddTracepointOutput(const TracepointOutputData& data);
+  virtual void Clear();
+
+  // Implementation of InputHandler:
+  virtual bool NotifyMouseWheel(
+      int delta, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool NotifyKey(
+      InputKey key, bool down, const InputModifiers& modifiers) OVERRIDE;
+  virtual bool WantMouseEvents() OVERRIDE { return true; }
+  virtual bool WantKeyEvents() OVERRIDE { return true; }
+
+  // Implementation of ScrollHelperDataProvider:
+  virtual int GetContentSize() OVERRIDE;
+  virtual const Rect& GetScreenRect() const OVERRIDE {
+    return Dockable::GetScreenRect();
+  }
+
+ private:
+  int GetHeaderHeight() const;
+  // Scrolls so that the newest output is at the bottom.
+  void ScrollToLatest();
+
+  TracepointLog log_;
+  bool following_;
+  ScrollHelper scroll_helper_;
+
+  DISALLOW_COPY_AND_ASSIGN(TracepointLogView);
+};
+
+#endif  // SG_TRACEPOINT_LOG_VIEW_H_
@@ -8,6 +8,14 @@
 #include "sg/render/renderer.h"
 #include "sg/ui/skin.h"
 
+namespace {
+
+// Output is retained for scrollback, but a chatty target (or gdb) shouldn't
+// be able to grow it without bound.
+const size_t kMaxLines = 10000;
+
+}  // namespace
+
 ScrollingOutputView::ScrollingOutputView()
     : scroll_helper_(this, Skin::current().text_line_height()) {
 }
@@ -49,6 +57,8 @@ void ScrollingOutputView::AddText(const string16& text) {
     if (result[i].size() > 0)
       lines_.push_back(result[i]);
   }
+  while (lines_.size() > kMaxLines)
+    lines_.pop_front();
 
   // TODO(scottmg): This should only happen when the scroll location is
   // already at "end".
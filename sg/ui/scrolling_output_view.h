@@ -5,7 +5,7 @@
 #ifndef SG_UI_SCROLLING_OUTPUT_VIEW_H_
 #define SG_UI_SCROLLING_OUTPUT_VIEW_H_
 
-#include <vector>
+#include <deque>
 
 #include "sg/basex/string16.h"
 #include "sg/ui/dockable.h"
@@ -41,7 +41,9 @@ class ScrollingOutputView : public Dockable, public ScrollHelperDataProvider {
  private:
   bool LineInView(int line_number);
   int GetFirstLineInView();
-  std::vector<string16> lines_;
+
+  // Bounded to kMaxLines, oldest lines are dropped first.
+  std::deque<string16> lines_;
   ScrollHelper scroll_helper_;
 };
 
@@ -6,12 +6,16 @@
 
 #include "base/bind.h"
 #include "sg/app_thread.h"
+#include "sg/breakpoints_view.h"
 #include "sg/debug_presenter_notify.h"
 #include "sg/locals_view.h"
+#include "sg/profile_view.h"
 #include "sg/render/application_window.h"
 #include "sg/source_view.h"
 #include "sg/stack_view.h"
 #include "sg/status_bar.h"
+#include "sg/threads_view.h"
+#include "sg/tracepoint_log_view.h"
 #include "sg/ui/docking_split_container.h"
 #include "sg/ui/docking_resizer.h"
 #include "sg/ui/docking_tool_window.h"
@@ -39,14 +43,23 @@ Workspace::Workspace()
   source_view_ = new SourceView;
   stack_view_ = new StackView;
   stack_view_window_ = new DockingToolWindow(stack_view_, L"Stack");
+  threads_view_ = new ThreadsView;
+  threads_view_window_ = new DockingToolWindow(threads_view_, L"Threads");
   watch_ = Placeholder(L"Watch");
   locals_view_ = new LocalsView;
   locals_view_window_ = new DockingToolWindow(locals_view_, L"Locals");
-  breakpoints_ = Placeholder(L"Breakpoints");
+  breakpoints_view_ = new BreakpointsView;
+  breakpoints_window_ =
+      new DockingToolWindow(breakpoints_view_, L"Breakpoints");
   output_ = new ScrollingOutputView;
   output_window_ = new DockingToolWindow(output_, L"Output");
   log_ = new ScrollingOutputView;
   log_window_ = new DockingToolWindow(log_, L"Log");
+  tracepoint_log_view_ = new TracepointLogView;
+  tracepoint_log_window_ =
+      new DockingToolWindow(tracepoint_log_view_, L"Tracepoints");
+  profile_view_ = new ProfileView;
+  profile_view_window_ = new DockingToolWindow(profile_view_, L"Profile");
 
   // For Invalidate, and interaction with dragger. Could use some sort of
   // broadcast for Invalidate (and coalesce there) and could pass to dragger.
@@ -71,6 +84,11 @@ void Workspace::Init() {
     output_window_->parent()->SplitChild(
         kSplitVertical, output_window_, log_window_);
     output_window_->parent()->SetFraction(.6);
+    log_window_->parent()->SplitChild(
+        kSplitVertical, log_window_, tracepoint_log_window_);
+    output_window_->parent()->SplitChild(
+        kSplitVertical, output_window_, profile_view_window_);
+    output_window_->parent()->SetFraction(.5);
 
     source_view_->parent()->SplitChild(
         kSplitVertical, source_view_, stack_view_window_);
@@ -81,7 +99,10 @@ void Workspace::Init() {
     watch_->parent()->SplitChild(kSplitHorizontal, watch_, locals_view_window_);
     watch_->parent()->SetFraction(.65);
     stack_view_window_->parent()->SplitChild(
-        kSplitHorizontal, stack_view_window_, breakpoints_);
+        kSplitHorizontal, stack_view_window_, breakpoints_window_);
+    stack_view_window_->parent()->SetFraction(.6);
+    stack_view_window_->parent()->SplitChild(
+        kSplitVertical, stack_view_window_, threads_view_window_);
     stack_view_window_->parent()->SetFraction(.6);
   } else {
     source_view_->parent()->SplitChild(
@@ -91,12 +112,18 @@ void Workspace::Init() {
         kSplitVertical, output_window_, log_window_);
     output_window_->parent()->SetFraction(.6);
     log_window_->parent()->SplitChild(
-        kSplitHorizontal, breakpoints_, log_window_);
+        kSplitHorizontal, breakpoints_window_, log_window_);
+    log_window_->parent()->SplitChild(
+        kSplitVertical, log_window_, tracepoint_log_window_);
+    output_window_->parent()->SplitChild(
+        kSplitVertical, output_window_, profile_view_window_);
 
     source_view_->parent()->SplitChild(kSplitVertical, source_view_, watch_);
     watch_->parent()->SplitChild(kSplitHorizontal, watch_, locals_view_window_);
     locals_view_window_->parent()->SplitChild(
         kSplitHorizontal, locals_view_window_, stack_view_window_);
+    stack_view_window_->parent()->SplitChild(
+        kSplitVertical, stack_view_window_, threads_view_window_);
   }
 
   SetFocusedContents(source_view_);
@@ -109,6 +136,9 @@ void Workspace::SetDelegate(ApplicationWindow* delegate) {
 void Workspace::SetDebugPresenterNotify(DebugPresenterNotify* debug_presenter) {
   debug_presenter_notify_ = debug_presenter;
   locals_view_->SetDebugPresenterNotify(debug_presenter);
+  source_view_->SetDebugPresenterNotify(debug_presenter);
+  breakpoints_view_->SetDebugPresenterNotify(debug_presenter);
+  threads_view_->SetDebugPresenterNotify(debug_presenter);
 }
 
 void Workspace::SetScreenRect(const Rect& rect) {
@@ -153,14 +183,22 @@ void Workspace::Render(Renderer* renderer) {
 void Workspace::SetFileName(const string16& filename) {
   /*source_view_container_->SetTitle(source_view_, filename.LossyDisplayName());
    */
+  source_view_->SetFileName(filename);
 }
 
 void Workspace::SetProgramCounterLine(int line_number) {
   source_view_->SetProgramCounterLine(line_number);
 }
 
-void Workspace::SetFileData(const std::string& utf8_text) {
-  source_view_->SetData(utf8_text);
+void Workspace::SetProcessExited(const ProcessExitedData& data) {
+  // Nothing's executing, and there's no stack to show.
+  source_view_->SetProgramCounterLine(0);
+  stack_view_->SetData(std::vector<FrameData>(), 0);
+}
+
+void Workspace::SetFileData(const std::string& utf8_text,
+                            uint64 contents_hash) {
+  source_view_->SetData(utf8_text, contents_hash);
 }
 
 void Workspace::SetRenderTime(double frame_time_in_ms) {
@@ -172,6 +210,39 @@ void Workspace::SetStackData(
   stack_view_->SetData(frame_data, active);
 }
 
+void Workspace::PassiveDisplaysUpdated() {
+}
+
+void Workspace::UpdateThreads(const RetrievedThreadsData& data) {
+  threads_view_->UpdateThreads(data);
+}
+
+void Workspace::SetThreadsRunning(const ThreadsRunningData& data) {
+  threads_view_->SetThreadsRunning(data);
+}
+
+void Workspace::SetCurrentThread(ThreadId thread_id) {
+  threads_view_->SetCurrentThread(thread_id);
+}
+
+void Workspace::SetBreakpoints(const BreakpointList* breakpoints) {
+  source_view_->SetBreakpoints(breakpoints);
+  breakpoints_view_->SetBreakpoints(breakpoints);
+}
+
+void Workspace::BreakpointsChanged() {
+  source_view_->BreakpointsChanged();
+  breakpoints_view_->BreakpointsChanged();
+}
+
+void Workspace::SetProfileData(const ProfileData& data) {
+  profile_view_->SetProfileData(data);
+}
+
+void Workspace::AddTracepointOutput(const TracepointOutputData& data) {
+  tracepoint_log_view_->AddTracepointOutput(data);
+}
+
 void Workspace::AddLocalsChild(
     const std::string& parent_id, const std::string& child_id) {
   locals_view_->AddChild(parent_id, child_id);
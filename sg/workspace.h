@@ -15,13 +15,17 @@
 #include "sg/ui/skin.h"
 
 class ApplicationWindow;
+class BreakpointsView;
 class DebugPresenterNotify;
 class DockingResizer;
 class LocalsView;
+class ProfileView;
 class ScrollingOutputView;
 class SourceView;
 class StackView;
 class StatusBar;
+class ThreadsView;
+class TracepointLogView;
 
 class Workspace : public DebugPresenterDisplay, public InputHandler {
  public:
@@ -51,10 +55,24 @@ class Workspace : public DebugPresenterDisplay, public InputHandler {
 
   // Implementation of DebugPresenterDisplay.
   virtual void SetFileName(const string16& filename) OVERRIDE;
-  virtual void SetFileData(const std::string& utf8_text) OVERRIDE;
+  virtual void SetFileData(const std::string& utf8_text,
+                           uint64 contents_hash) OVERRIDE;
   virtual void SetProgramCounterLine(int line_number) OVERRIDE;
+  virtual void SetProcessExited(const ProcessExitedData& data) OVERRIDE;
   virtual void SetStackData(
       const std::vector<FrameData>& frame_data, int active) OVERRIDE;
+  virtual void PassiveDisplaysUpdated() OVERRIDE;
+
+  virtual void UpdateThreads(const RetrievedThreadsData& data) OVERRIDE;
+  virtual void SetThreadsRunning(const ThreadsRunningData& data) OVERRIDE;
+  virtual void SetCurrentThread(ThreadId thread_id) OVERRIDE;
+
+  virtual void SetBreakpoints(const BreakpointList* breakpoints) OVERRIDE;
+  virtual void BreakpointsChanged() OVERRIDE;
+
+  virtual void SetProfileData(const ProfileData& data) OVERRIDE;
+
+  virtual void AddTracepointOutput(const TracepointOutputData& data) OVERRIDE;
 
   virtual void AddLocalsChild(
       const std::string& parent_id, const std::string& child_id) OVERRIDE;
@@ -82,15 +100,23 @@ class Workspace : public DebugPresenterDisplay, public InputHandler {
   SourceView* source_view_;
   StackView* stack_view_;
   Dockable* stack_view_window_;
+  ThreadsView* threads_view_;
+  Dockable* threads_view_window_;
+  ProfileView* profile_view_;
+  Dockable* profile_view_window_;
   ScrollingOutputView* output_;
   Dockable* output_window_;
   ScrollingOutputView* log_;
   Dockable* log_window_;
+  TracepointLogView* tracepoint_log_view_;
+  Dockable* tracepoint_log_window_;
   LocalsView* locals_view_;
   Dockable* locals_view_window_;
 
+  BreakpointsView* breakpoints_view_;
+  Dockable* breakpoints_window_;
+
   Dockable* watch_;
-  Dockable* breakpoints_;
 
   ApplicationWindow* delegate_;
   DebugPresenterNotify* debug_presenter_notify_;
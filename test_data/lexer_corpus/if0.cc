@@ -0,0 +1,244 @@
+#include "config.h"
+
+#if 0
+// Old version, kept for reference: it's what we had before there up which just.
+static int Old0(const char* s) {
+  printf("such that made isn't quite right\n", s);
+  char c = '"';  /* do or they also for
+  return strlen(s) > 0;
+}
+#if defined(NESTED)
+int nested_0 = 0;
+#endif
+#endif
+
+static int New0(const char* s) {
+  // which what also an what that
+  return s && s[0] == 'y';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before will than about not.
+static int Old1(const char* s) {
+  printf("when what any isn't quite right\n", s);
+  char c = '"';  /* they must up two its
+  return strlen(s) > 1;
+}
+#endif
+
+static int New1(const char* s) {
+  // be more about then so than
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before when by all must.
+static int Old2(const char* s) {
+  printf("may over time isn't quite right\n", s);
+  char c = '"';  /* too which so is at
+  return strlen(s) > 2;
+}
+#endif
+
+static int New2(const char* s) {
+  // there made any used well great
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before as there then about.
+static int Old3(const char* s) {
+  printf("then after if isn't quite right\n", s);
+  char c = '"';  /* right this more may of
+  return strlen(s) > 3;
+}
+#if defined(NESTED)
+int nested_3 = 0;
+#endif
+#endif
+
+static int New3(const char* s) {
+  // is made very what can much
+  return s && s[0] == 'c';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before more one it where.
+static int Old4(const char* s) {
+  printf("on much those isn't quite right\n", s);
+  char c = '"';  /* time by what an many
+  return strlen(s) > 4;
+}
+#endif
+
+static int New4(const char* s) {
+  // have too this its then them
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before then such them do.
+static int Old5(const char* s) {
+  printf("not from made isn't quite right\n", s);
+  char c = '"';  /* also time great if or
+  return strlen(s) > 5;
+}
+#endif
+
+static int New5(const char* s) {
+  // were them it time it over
+  return s && s[0] == 'a';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before just great has just.
+static int Old6(const char* s) {
+  printf("these its were isn't quite right\n", s);
+  char c = '"';  /* just there those are at
+  return strlen(s) > 6;
+}
+#if defined(NESTED)
+int nested_6 = 0;
+#endif
+#endif
+
+static int New6(const char* s) {
+  // his great has over this if
+  return s && s[0] == 'a';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before those other if are.
+static int Old7(const char* s) {
+  printf("many than before isn't quite right\n", s);
+  char c = '"';  /* there it much much some
+  return strlen(s) > 7;
+}
+#endif
+
+static int New7(const char* s) {
+  // when much were his what on
+  return s && s[0] == 'c';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before those very with about.
+static int Old8(const char* s) {
+  printf("a also as isn't quite right\n", s);
+  char c = '"';  /* this up were the like
+  return strlen(s) > 8;
+}
+#endif
+
+static int New8(const char* s) {
+  // right or may there over for
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before back well where in.
+static int Old9(const char* s) {
+  printf("is made first isn't quite right\n", s);
+  char c = '"';  /* by my his would right
+  return strlen(s) > 9;
+}
+#if defined(NESTED)
+int nested_9 = 0;
+#endif
+#endif
+
+static int New9(const char* s) {
+  // them out after very been were
+  return s && s[0] == 'y';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before all if just made.
+static int Old10(const char* s) {
+  printf("to his have isn't quite right\n", s);
+  char c = '"';  /* to over when could into
+  return strlen(s) > 10;
+}
+#endif
+
+static int New10(const char* s) {
+  // it right there was through by
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before than some back time.
+static int Old11(const char* s) {
+  printf("his great for isn't quite right\n", s);
+  char c = '"';  /* into made out used their
+  return strlen(s) > 11;
+}
+#endif
+
+static int New11(const char* s) {
+  // as many my just or these
+  return s && s[0] == 'x';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before must like but them.
+static int Old12(const char* s) {
+  printf("before but by isn't quite right\n", s);
+  char c = '"';  /* its an if but as
+  return strlen(s) > 12;
+}
+#if defined(NESTED)
+int nested_12 = 0;
+#endif
+#endif
+
+static int New12(const char* s) {
+  // also a two they they more
+  return s && s[0] == 'b';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before well would a before.
+static int Old13(const char* s) {
+  printf("a it can isn't quite right\n", s);
+  char c = '"';  /* all only of many right
+  return strlen(s) > 13;
+}
+#endif
+
+static int New13(const char* s) {
+  // made more well can right which
+  return s && s[0] == 'y';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before right so can what.
+static int Old14(const char* s) {
+  printf("be is have isn't quite right\n", s);
+  char c = '"';  /* can only to like be
+  return strlen(s) > 14;
+}
+#endif
+
+static int New14(const char* s) {
+  // them be at about any now
+  return s && s[0] == 'a';
+}
+
+#if 0
+// Old version, kept for reference: it's what we had before them so any are.
+static int Old15(const char* s) {
+  printf("be after very isn't quite right\n", s);
+  char c = '"';  /* their some than all can
+  return strlen(s) > 15;
+}
+#if defined(NESTED)
+int nested_15 = 0;
+#endif
+#endif
+
+static int New15(const char* s) {
+  // their used a but there also
+  return s && s[0] == 'x';
+}
+
@@ -0,0 +1,319 @@
+// Copyright 2013 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+/**
+ * then those that as made on about.
+ * for over were in was these only it has was.
+ * could for very this his right right through for just.
+ * then that his is well or would only from most.
+ * just what well not be through.
+ * too but into on where it very for must all.
+ * made could so first through like about will one.
+ * one with just will after such them.
+ * may if much as this some only an them at now.
+ * is great as well just so them do where.
+ * through like it was when any great it for.
+ * what many just may if than great do a first can.
+ * before by such for were if are.
+ *
+ * @param value_0  one then then such with.
+ * @return an may its where.
+ */
+int Function0(int value_0) {
+  // these where there only can other
+  // at with have at been used
+  // of now back not more if
+  // from only made into before
+  return value_0 * 1;  // very so are some
+}
+
+/**
+ * those that like well then then its then be my too.
+ * for but it all two which by them where.
+ * be the very at made on.
+ * before to as all before other at too.
+ * do much about any this by now first.
+ * my what with from be them more my which.
+ * a all after about from most to after will many.
+ * more also about an can his.
+ * most over out too his before but has its been.
+ * also such can to to there any.
+ * but much do may do about with his.
+ * been any they them all my.
+ * before the my those do many with used this than.
+ * they my have these too out was then first its with.
+ * which an are to at back first those from before where.
+ * used do at where where are a of those.
+ * after or these but were to.
+ *
+ * @param value_1  their were would over has.
+ * @return back up more most.
+ */
+int Function1(int value_1) {
+  // for can like used through also
+  // over are made at after some a two
+  // much the at have from any
+  // this well for up also after well my be
+  // for one but there is on over may well
+  return value_1 * 2;  // to it two up
+}
+
+/**
+ * much some they there may some made my over one.
+ * also more well they may or only this then two so.
+ * great has could as were great.
+ * this at many used about from their or.
+ * his on then now which great his which these.
+ * its them only they can so was about a them.
+ * like two a than out also must would some it.
+ * been be with more when is.
+ * when are could those more its at.
+ * some just such up was there for not could as.
+ * a too was more with much his it.
+ * this like of them where only when must.
+ * is after has by which more that.
+ * they what right what after all would.
+ * over those have when do a their in of.
+ * over where but some any one.
+ * be used those these used such most then over.
+ *
+ * @param value_2  what were been them they.
+ * @return too or its do.
+ */
+int Function2(int value_2) {
+  // of as right their these which
+  // with great other over great
+  return value_2 * 3;  // if where one would
+}
+
+/**
+ * not which when may the more about out where.
+ * one in what were can not the out.
+ * with any there over those they one over the.
+ * more was from its back is.
+ * a will will right been with through after at.
+ * where than up such at if must many from is some.
+ * could over or after over very a through many been with.
+ * is or too about be other.
+ *
+ * @param value_3  may well that right a.
+ * @return right made one now.
+ */
+int Function3(int value_3) {
+  // like it over made was
+  // after it any their as more has all been those
+  // such other as my if is before right
+  // they as where from out their those will must very
+  return value_3 * 4;  // or of my for
+}
+
+/**
+ * those on were those now would also if.
+ * first first this where they what with any a.
+ * like as over may when than all all.
+ * through was from after more about.
+ * much right some there by about been.
+ * now then to which the now may its will.
+ * from only do other so this out the up them then.
+ * they of would their into it.
+ * than back as about could there that there be.
+ * used if too at one when.
+ * some so but into could to right its where.
+ * all with that time may before or many if now.
+ * where are an any only them.
+ * will their those more its those has will.
+ * well great then this an many which as all.
+ *
+ * @param value_4  over such where his may.
+ * @return out may could or.
+ */
+int Function4(int value_4) {
+  // was have them well was so
+  // into more very they a time
+  // time after all other when them for such
+  return value_4 * 5;  // there just about are
+}
+
+/**
+ * after right were was when one than its many may.
+ * what a are in could any back now the.
+ * then after first may one be.
+ * at at also be many like with.
+ * is the are been very in many will are right.
+ * after too these by on as will after.
+ * but than more his where the of made will like.
+ * so many one any after has where one.
+ * time those what for a but.
+ * those many only with their been great could into.
+ * such in them only about then they.
+ * would over it all such they.
+ * but been first his more would be must.
+ * before not his now only great for where from.
+ * that were to where from only that for not.
+ * may so by with an out but not those.
+ * first in what great other into out two an be.
+ * with there with do only this.
+ *
+ * @param value_5  well all other can what.
+ * @return these was that any.
+ */
+int Function5(int value_5) {
+  // most may but up about any to
+  // time one right its is other in first it for
+  // but it much them about when out
+  return value_5 * 6;  // before is more so
+}
+
+/**
+ * the where too it to been be any.
+ * first than their these such are such not of will at.
+ * has up so like about where with some they then.
+ * one time it those in my where.
+ * up which could be as more must with all on.
+ * such may have been or only like must those.
+ * made great this would would there very.
+ * into their more they two one not one.
+ * at if through but up it then.
+ * one over after been those on those first.
+ * be the any been may into.
+ * would been this that but where.
+ *
+ * @param value_6  through but as into some.
+ * @return have may much more.
+ */
+int Function6(int value_6) {
+  // too where must do were
+  // into them from is all
+  return value_6 * 7;  // their in where those
+}
+
+/**
+ * up time those into not must.
+ * as all in such where my it time.
+ * then used where at too made.
+ * those which then when time if.
+ * what only that what very can only only a about many.
+ * then its all the these which could.
+ * was its just about like which.
+ * of that where from many then was.
+ * must into over an from do if which also an.
+ * be than now they will are.
+ * my so that much too than.
+ *
+ * @param value_7  was must which too his.
+ * @return must its before they.
+ */
+int Function7(int value_7) {
+  // very were is its also which
+  // can this at one but is well those
+  // great up this than where
+  // where right what those only what through one
+  // than used into may over two have a
+  return value_7 * 8;  // the must now first
+}
+
+/**
+ * must like have any its be it are can.
+ * about was two over some used is is too.
+ * with so some with that over other.
+ * or to it before by but are now if an his.
+ * do before their which up before.
+ * like from their over my all back more.
+ * over has so into in they not its which too.
+ * those up other an more by after that.
+ * about may well also through be their made right then into.
+ * other into just from about out with two.
+ * have before that would also their what.
+ *
+ * @param value_8  too through used so the.
+ * @return in his at would.
+ */
+int Function8(int value_8) {
+  // some about that are now been before those
+  // a that the very can
+  // be also can made his time through
+  // back or all about must any which
+  // of one at may on it
+  return value_8 * 9;  // too from great when
+}
+
+/**
+ * of for many well do where many through.
+ * much also such one an the is for made.
+ * its not has which for be.
+ * before where used they from time.
+ * also much many over many many only.
+ * have some what it will right that my made the.
+ * these first with those may have his be more.
+ * many in this out more that when.
+ * where those these also more would many were with over of.
+ * more has they which up but than.
+ * where has other right great made any any.
+ * the to these been just what were then must through.
+ * very an from in to by.
+ * must which do from to to.
+ *
+ * @param value_9  is or many too is.
+ * @return it is it back.
+ */
+int Function9(int value_9) {
+  // made great it than be one
+  // all by in in too was
+  // right if my on are on many all would so
+  // could more a do their if that
+  return value_9 * 10;  // into up much over
+}
+
+/**
+ * must to time to these also on do.
+ * that made very were was just if an these.
+ * after they if that the do.
+ * on now not such back do some more just.
+ * if were been such an by too.
+ * now well be right up can.
+ * its then was could many to.
+ * all will more could most over an other.
+ * been like are made where much many in do through up.
+ * at may used where up an first two their through.
+ * are out first many has over but.
+ * will must at at one up much also.
+ * which has up but more be an used.
+ * they than at from will will.
+ * there they be too be there all than first.
+ *
+ * @param value_10  in of its these his.
+ * @return over right would first.
+ */
+int Function10(int value_10) {
+  // their much its the one these
+  // just back many only been great those many through been
+  return value_10 * 11;  // those not many this
+}
+
+/**
+ * so more right on only one its right which.
+ * could my like a must time also those.
+ * not those up of than now be in their most were.
+ * they also do on just like most.
+ * any some a too into also them.
+ * like all not then some this before can too.
+ * their there other its for of.
+ * only only right those can through.
+ * be his will its after his then first.
+ * an are it too but any many.
+ * his from can great too time first would where those.
+ * any can been when other their could.
+ * not my the there can one those will up my now.
+ * must too with used about at will than for.
+ * very up or after do too.
+ *
+ * @param value_11  through of used of all.
+ * @return as those would their.
+ */
+int Function11(int value_11) {
+  // from been not may do at all its made
+  // before much was great where too
+  return value_11 * 12;  // will they such were
+}
+
@@ -0,0 +1,230 @@
+// Generated opcode tables.
+
+#ifndef OPCODES_H_
+#define OPCODES_H_
+
+#define CONCAT_INNER(a, b) a##b
+#define CONCAT(a, b) CONCAT_INNER(a, b)
+#define STRINGIZE_INNER(x) #x
+#define STRINGIZE(x) STRINGIZE_INNER(x)
+
+#define FOR_EACH_OPCODE(V) \
+  V(Out_Do, 0x00, 3, "my") \
+  V(One_Out, 0x01, 2, "have") \
+  V(By_Will, 0x02, 0, "well") \
+  V(Like_On, 0x03, 0, "which") \
+  V(Where_Then, 0x04, 3, "in") \
+  V(In_Is, 0x05, 0, "time") \
+  V(Many_Are, 0x06, 3, "just") \
+  V(Can_As, 0x07, 2, "used") \
+  V(Which_About, 0x08, 1, "used") \
+  V(Was_Out, 0x09, 0, "many") \
+  V(My_Will, 0x0a, 1, "more") \
+  V(On_Be, 0x0b, 1, "by") \
+  V(At_Such, 0x0c, 2, "made") \
+  V(Most_This, 0x0d, 2, "first") \
+  V(One_Which, 0x0e, 0, "over") \
+  V(Their_About, 0x0f, 1, "if") \
+  V(Its_Well, 0x10, 1, "are") \
+  V(Has_Made, 0x11, 1, "on") \
+  V(Of_Be, 0x12, 0, "now") \
+  V(Just_All, 0x13, 1, "was") \
+  V(An_At, 0x14, 2, "to") \
+  V(Could_Then, 0x15, 0, "would") \
+  V(Very_This, 0x16, 0, "used") \
+  V(Through_Were, 0x17, 1, "one") \
+  V(Where_Some, 0x18, 0, "one") \
+  V(As_Where, 0x19, 2, "on") \
+  V(Is_Were, 0x1a, 1, "will") \
+  V(Them_With, 0x1b, 3, "back") \
+  V(Not_Of, 0x1c, 2, "time") \
+  V(Time_In, 0x1d, 0, "one") \
+  V(From_Some, 0x1e, 1, "at") \
+  V(Do_Or, 0x1f, 1, "they") \
+  V(His_Out, 0x20, 0, "the") \
+  V(My_In, 0x21, 3, "after") \
+  V(Out_It, 0x22, 0, "they") \
+  V(Right_That, 0x23, 2, "time") \
+  V(Was_Those, 0x24, 2, "through") \
+  V(Which_Such, 0x25, 3, "or") \
+  V(More_Will, 0x26, 0, "first") \
+  V(Back_An, 0x27, 3, "than") \
+  V(Too_Some, 0x28, 2, "back") \
+  V(Made_Those, 0x29, 0, "it") \
+  V(Their_Been, 0x2a, 1, "they") \
+  V(Back_Like, 0x2b, 1, "such") \
+  V(Just_That, 0x2c, 3, "used") \
+  V(Then_Right, 0x2d, 2, "other") \
+  V(Its_Was, 0x2e, 1, "those") \
+  V(Those_Them, 0x2f, 3, "what") \
+  V(The_Will, 0x30, 3, "much") \
+  V(A_By, 0x31, 3, "only") \
+  V(Time_Much, 0x32, 2, "like") \
+  V(From_Out, 0x33, 1, "with") \
+  V(Can_Then, 0x34, 3, "must") \
+  V(In_Would, 0x35, 2, "was") \
+  V(When_Not, 0x36, 3, "time") \
+  V(Used_Made, 0x37, 1, "this") \
+  V(Were_Right, 0x38, 0, "other") \
+  V(Not_Than, 0x39, 2, "out") \
+  V(At_About, 0x3a, 1, "his") \
+  V(Do_Before, 0x3b, 3, "what") \
+  V(Such_So, 0x3c, 1, "which") \
+  V(Then_After, 0x3d, 0, "the") \
+  V(Have_Be, 0x3e, 1, "like") \
+  V(Very_Used, 0x3f, 2, "can") \
+  V(Those_On, 0x40, 3, "or") \
+  V(Their_Great, 0x41, 3, "as") \
+  V(Some_Must, 0x42, 2, "two") \
+  V(When_Would, 0x43, 2, "what") \
+  V(Used_Right, 0x44, 3, "also") \
+  V(Those_For, 0x45, 3, "such") \
+  V(About_A, 0x46, 0, "this") \
+  V(Well_Other, 0x47, 3, "what") \
+  V(Some_At, 0x48, 3, "in") \
+  V(Up_My, 0x49, 1, "the") \
+  V(When_From, 0x4a, 1, "back") \
+  V(Just_Some, 0x4b, 0, "then") \
+  V(Have_Back, 0x4c, 2, "right") \
+  V(Has_Would, 0x4d, 0, "only") \
+  V(Where_Time, 0x4e, 0, "those") \
+  V(Too_Other, 0x4f, 3, "about") \
+  /* end */
+
+#define SUM1(a0) \
+  ((a0))
+#define SUM2(a0, a1) \
+  ((a0) + (a1))
+#define SUM3(a0, a1, a2) \
+  ((a0) + (a1) + (a2))
+#define SUM4(a0, a1, a2, a3) \
+  ((a0) + (a1) + (a2) + (a3))
+#define SUM5(a0, a1, a2, a3, a4) \
+  ((a0) + (a1) + (a2) + (a3) + (a4))
+#define SUM6(a0, a1, a2, a3, a4, a5) \
+  ((a0) + (a1) + (a2) + (a3) + (a4) + (a5))
+#define SUM7(a0, a1, a2, a3, a4, a5, a6) \
+  ((a0) + (a1) + (a2) + (a3) + (a4) + (a5) + (a6))
+#define SUM8(a0, a1, a2, a3, a4, a5, a6, a7) \
+  ((a0) + (a1) + (a2) + (a3) + (a4) + (a5) + (a6) + (a7))
+
+#define DECLARE_OPCODE(name, value, operands, mnemonic) \
+  k##name = value,
+enum Opcode {
+  FOR_EACH_OPCODE(DECLARE_OPCODE)
+};
+#undef DECLARE_OPCODE
+
+#define OPCODE_NAME(name, value, operands, mnemonic) \
+  case k##name: \
+    return STRINGIZE(name) " (" mnemonic ")";
+inline const char* OpcodeName(Opcode opcode) {
+  switch (opcode) {
+    FOR_EACH_OPCODE(OPCODE_NAME)
+  }
+  return NULL;
+}
+#undef OPCODE_NAME
+
+#if defined(OPCODE_CHECK_0) && OPCODE_CHECK_0 > 0
+#define CHECK_0(x) SUM3(x, 0, SUM2(x, 0))
+#else
+#define CHECK_0(x) (x)
+#endif
+#if defined(OPCODE_CHECK_1) && OPCODE_CHECK_1 > 1
+#define CHECK_1(x) SUM3(x, 1, SUM2(x, 1))
+#else
+#define CHECK_1(x) (x)
+#endif
+#if defined(OPCODE_CHECK_2) && OPCODE_CHECK_2 > 2
+#define CHECK_2(x) SUM3(x, 2, SUM2(x, 2))
+#else
+#define CHECK_2(x) (x)
+#endif
+#if defined(OPCODE_CHECK_3) && OPCODE_CHECK_3 > 3
+#define CHECK_3(x) SUM3(x, 3, SUM2(x, 3))
+#else
+#define CHECK_3(x) (x)
+#endif
+#if defined(OPCODE_CHECK_4) && OPCODE_CHECK_4 > 4
+#define CHECK_4(x) SUM3(x, 4, SUM2(x, 4))
+#else
+#define CHECK_4(x) (x)
+#endif
+#if defined(OPCODE_CHECK_5) && OPCODE_CHECK_5 > 5
+#define CHECK_5(x) SUM3(x, 5, SUM2(x, 5))
+#else
+#define CHECK_5(x) (x)
+#endif
+#if defined(OPCODE_CHECK_6) && OPCODE_CHECK_6 > 6
+#define CHECK_6(x) SUM3(x, 6, SUM2(x, 6))
+#else
+#define CHECK_6(x) (x)
+#endif
+#if defined(OPCODE_CHECK_7) && OPCODE_CHECK_7 > 7
+#define CHECK_7(x) SUM3(x, 7, SUM2(x, 7))
+#else
+#define CHECK_7(x) (x)
+#endif
+#if defined(OPCODE_CHECK_8) && OPCODE_CHECK_8 > 8
+#define CHECK_8(x) SUM3(x, 8, SUM2(x, 8))
+#else
+#define CHECK_8(x) (x)
+#endif
+#if defined(OPCODE_CHECK_9) && OPCODE_CHECK_9 > 9
+#define CHECK_9(x) SUM3(x, 9, SUM2(x, 9))
+#else
+#define CHECK_9(x) (x)
+#endif
+#if defined(OPCODE_CHECK_10) && OPCODE_CHECK_10 > 10
+#define CHECK_10(x) SUM3(x, 10, SUM2(x, 10))
+#else
+#define CHECK_10(x) (x)
+#endif
+#if defined(OPCODE_CHECK_11) && OPCODE_CHECK_11 > 11
+#define CHECK_11(x) SUM3(x, 11, SUM2(x, 11))
+#else
+#define CHECK_11(x) (x)
+#endif
+#if defined(OPCODE_CHECK_12) && OPCODE_CHECK_12 > 12
+#define CHECK_12(x) SUM3(x, 12, SUM2(x, 12))
+#else
+#define CHECK_12(x) (x)
+#endif
+#if defined(OPCODE_CHECK_13) && OPCODE_CHECK_13 > 13
+#define CHECK_13(x) SUM3(x, 13, SUM2(x, 13))
+#else
+#define CHECK_13(x) (x)
+#endif
+#if defined(OPCODE_CHECK_14) && OPCODE_CHECK_14 > 14
+#define CHECK_14(x) SUM3(x, 14, SUM2(x, 14))
+#else
+#define CHECK_14(x) (x)
+#endif
+#if defined(OPCODE_CHECK_15) && OPCODE_CHECK_15 > 15
+#define CHECK_15(x) SUM3(x, 15, SUM2(x, 15))
+#else
+#define CHECK_15(x) (x)
+#endif
+#if defined(OPCODE_CHECK_16) && OPCODE_CHECK_16 > 16
+#define CHECK_16(x) SUM3(x, 16, SUM2(x, 16))
+#else
+#define CHECK_16(x) (x)
+#endif
+#if defined(OPCODE_CHECK_17) && OPCODE_CHECK_17 > 17
+#define CHECK_17(x) SUM3(x, 17, SUM2(x, 17))
+#else
+#define CHECK_17(x) (x)
+#endif
+#if defined(OPCODE_CHECK_18) && OPCODE_CHECK_18 > 18
+#define CHECK_18(x) SUM3(x, 18, SUM2(x, 18))
+#else
+#define CHECK_18(x) (x)
+#endif
+#if defined(OPCODE_CHECK_19) && OPCODE_CHECK_19 > 19
+#define CHECK_19(x) SUM3(x, 19, SUM2(x, 19))
+#else
+#define CHECK_19(x) (x)
+#endif
+
+#endif  // OPCODES_H_
@@ -0,0 +1 @@
+int f0(int a,int b){return a*0+b/(a|1)-0x0;}static const char*s0="than which these";struct S0{int x;double y;S0():x(0),y(0.5f){}};int f1(int a,int b){return a*1+b/(a|1)-0x1;}int f2(int a,int b){return a*2+b/(a|1)-0x2;}int f3(int a,int b){return a*3+b/(a|1)-0x3;}int f4(int a,int b){return a*4+b/(a|1)-0x4;}int f5(int a,int b){return a*5+b/(a|1)-0x5;}static const char*s5="or or of";int f6(int a,int b){return a*6+b/(a|1)-0x6;}int f7(int a,int b){return a*7+b/(a|1)-0x7;}struct S7{int x;double y;S7():x(7),y(7.5f){}};int f8(int a,int b){return a*8+b/(a|1)-0x8;}int f9(int a,int b){return a*9+b/(a|1)-0x9;}int f10(int a,int b){return a*10+b/(a|1)-0xa;}static const char*s10="by were through";int f11(int a,int b){return a*11+b/(a|1)-0xb;}int f12(int a,int b){return a*12+b/(a|1)-0xc;}int f13(int a,int b){return a*13+b/(a|1)-0xd;}int f14(int a,int b){return a*14+b/(a|1)-0xe;}struct S14{int x;double y;S14():x(14),y(14.5f){}};int f15(int a,int b){return a*15+b/(a|1)-0xf;}static const char*s15="made other to";int f16(int a,int b){return a*16+b/(a|1)-0x10;}int f17(int a,int b){return a*17+b/(a|1)-0x11;}int f18(int a,int b){return a*18+b/(a|1)-0x12;}int f19(int a,int b){return a*19+b/(a|1)-0x13;}int f20(int a,int b){return a*20+b/(a|1)-0x14;}static const char*s20="of was first";int f21(int a,int b){return a*21+b/(a|1)-0x15;}struct S21{int x;double y;S21():x(21),y(21.5f){}};int f22(int a,int b){return a*22+b/(a|1)-0x16;}int f23(int a,int b){return a*23+b/(a|1)-0x17;}int f24(int a,int b){return a*24+b/(a|1)-0x18;}int f25(int a,int b){return a*25+b/(a|1)-0x19;}static const char*s25="is all just";int f26(int a,int b){return a*26+b/(a|1)-0x1a;}int f27(int a,int b){return a*27+b/(a|1)-0x1b;}int f28(int a,int b){return a*28+b/(a|1)-0x1c;}struct S28{int x;double y;S28():x(28),y(28.5f){}};int f29(int a,int b){return a*29+b/(a|1)-0x1d;}int f30(int a,int b){return a*30+b/(a|1)-0x1e;}static const char*s30="made as up";int f31(int a,int b){return a*31+b/(a|1)-0x1f;}int f32(int a,int b){return a*32+b/(a|1)-0x20;}int f33(int a,int b){return a*33+b/(a|1)-0x21;}int f34(int a,int b){return a*34+b/(a|1)-0x22;}int f35(int a,int b){return a*35+b/(a|1)-0x23;}static const char*s35="them must well";struct S35{int x;double y;S35():x(35),y(35.5f){}};int f36(int a,int b){return a*36+b/(a|1)-0x24;}int f37(int a,int b){return a*37+b/(a|1)-0x25;}int f38(int a,int b){return a*38+b/(a|1)-0x26;}int f39(int a,int b){return a*39+b/(a|1)-0x27;}int f40(int a,int b){return a*40+b/(a|1)-0x28;}static const char*s40="first now too";int f41(int a,int b){return a*41+b/(a|1)-0x29;}int f42(int a,int b){return a*42+b/(a|1)-0x2a;}struct S42{int x;double y;S42():x(42),y(42.5f){}};int f43(int a,int b){return a*43+b/(a|1)-0x2b;}int f44(int a,int b){return a*44+b/(a|1)-0x2c;}int f45(int a,int b){return a*45+b/(a|1)-0x2d;}static const char*s45="all the one";int f46(int a,int b){return a*46+b/(a|1)-0x2e;}int f47(int a,int b){return a*47+b/(a|1)-0x2f;}int f48(int a,int b){return a*48+b/(a|1)-0x30;}int f49(int a,int b){return a*49+b/(a|1)-0x31;}struct S49{int x;double y;S49():x(49),y(49.5f){}};int f50(int a,int b){return a*50+b/(a|1)-0x32;}static const char*s50="all can other";int f51(int a,int b){return a*51+b/(a|1)-0x33;}int f52(int a,int b){return a*52+b/(a|1)-0x34;}int f53(int a,int b){return a*53+b/(a|1)-0x35;}int f54(int a,int b){return a*54+b/(a|1)-0x36;}int f55(int a,int b){return a*55+b/(a|1)-0x37;}static const char*s55="be on back";int f56(int a,int b){return a*56+b/(a|1)-0x38;}struct S56{int x;double y;S56():x(56),y(56.5f){}};int f57(int a,int b){return a*57+b/(a|1)-0x39;}int f58(int a,int b){return a*58+b/(a|1)-0x3a;}int f59(int a,int b){return a*59+b/(a|1)-0x3b;}int f60(int a,int b){return a*60+b/(a|1)-0x3c;}static const char*s60="are they two";int f61(int a,int b){return a*61+b/(a|1)-0x3d;}int f62(int a,int b){return a*62+b/(a|1)-0x3e;}int f63(int a,int b){return a*63+b/(a|1)-0x3f;}struct S63{int x;double y;S63():x(63),y(63.5f){}};int f64(int a,int b){return a*64+b/(a|1)-0x40;}int f65(int a,int b){return a*65+b/(a|1)-0x41;}static const char*s65="like just through";int f66(int a,int b){return a*66+b/(a|1)-0x42;}int f67(int a,int b){return a*67+b/(a|1)-0x43;}int f68(int a,int b){return a*68+b/(a|1)-0x44;}int f69(int a,int b){return a*69+b/(a|1)-0x45;}int f70(int a,int b){return a*70+b/(a|1)-0x46;}static const char*s70="too two it";struct S70{int x;double y;S70():x(70),y(70.5f){}};int f71(int a,int b){return a*71+b/(a|1)-0x47;}int f72(int a,int b){return a*72+b/(a|1)-0x48;}int f73(int a,int b){return a*73+b/(a|1)-0x49;}int f74(int a,int b){return a*74+b/(a|1)-0x4a;}int f75(int a,int b){return a*75+b/(a|1)-0x4b;}static const char*s75="very that any";int f76(int a,int b){return a*76+b/(a|1)-0x4c;}int f77(int a,int b){return a*77+b/(a|1)-0x4d;}struct S77{int x;double y;S77():x(77),y(77.5f){}};int f78(int a,int b){return a*78+b/(a|1)-0x4e;}int f79(int a,int b){return a*79+b/(a|1)-0x4f;}int f80(int a,int b){return a*80+b/(a|1)-0x50;}static const char*s80="an its those";int f81(int a,int b){return a*81+b/(a|1)-0x51;}int f82(int a,int b){return a*82+b/(a|1)-0x52;}int f83(int a,int b){return a*83+b/(a|1)-0x53;}int f84(int a,int b){return a*84+b/(a|1)-0x54;}struct S84{int x;double y;S84():x(84),y(84.5f){}};int f85(int a,int b){return a*85+b/(a|1)-0x55;}static const char*s85="those has those";int f86(int a,int b){return a*86+b/(a|1)-0x56;}int f87(int a,int b){return a*87+b/(a|1)-0x57;}int f88(int a,int b){return a*88+b/(a|1)-0x58;}int f89(int a,int b){return a*89+b/(a|1)-0x59;}int f90(int a,int b){return a*90+b/(a|1)-0x5a;}static const char*s90="any any much";int f91(int a,int b){return a*91+b/(a|1)-0x5b;}struct S91{int x;double y;S91():x(91),y(91.5f){}};int f92(int a,int b){return a*92+b/(a|1)-0x5c;}int f93(int a,int b){return a*93+b/(a|1)-0x5d;}int f94(int a,int b){return a*94+b/(a|1)-0x5e;}int f95(int a,int b){return a*95+b/(a|1)-0x5f;}static const char*s95="from this such";int f96(int a,int b){return a*96+b/(a|1)-0x60;}int f97(int a,int b){return a*97+b/(a|1)-0x61;}int f98(int a,int b){return a*98+b/(a|1)-0x62;}struct S98{int x;double y;S98():x(98),y(98.5f){}};int f99(int a,int b){return a*99+b/(a|1)-0x63;}int f100(int a,int b){return a*100+b/(a|1)-0x64;}static const char*s100="where other it";int f101(int a,int b){return a*101+b/(a|1)-0x65;}int f102(int a,int b){return a*102+b/(a|1)-0x66;}int f103(int a,int b){return a*103+b/(a|1)-0x67;}int f104(int a,int b){return a*104+b/(a|1)-0x68;}int f105(int a,int b){return a*105+b/(a|1)-0x69;}static const char*s105="has been the";struct S105{int x;double y;S105():x(105),y(105.5f){}};int f106(int a,int b){return a*106+b/(a|1)-0x6a;}int f107(int a,int b){return a*107+b/(a|1)-0x6b;}int f108(int a,int b){return a*108+b/(a|1)-0x6c;}int f109(int a,int b){return a*109+b/(a|1)-0x6d;}int f110(int a,int b){return a*110+b/(a|1)-0x6e;}static const char*s110="then very his";int f111(int a,int b){return a*111+b/(a|1)-0x6f;}int f112(int a,int b){return a*112+b/(a|1)-0x70;}struct S112{int x;double y;S112():x(112),y(112.5f){}};int f113(int a,int b){return a*113+b/(a|1)-0x71;}int f114(int a,int b){return a*114+b/(a|1)-0x72;}int f115(int a,int b){return a*115+b/(a|1)-0x73;}static const char*s115="too many in";int f116(int a,int b){return a*116+b/(a|1)-0x74;}int f117(int a,int b){return a*117+b/(a|1)-0x75;}int f118(int a,int b){return a*118+b/(a|1)-0x76;}int f119(int a,int b){return a*119+b/(a|1)-0x77;}struct S119{int x;double y;S119():x(119),y(119.5f){}};int f120(int a,int b){return a*120+b/(a|1)-0x78;}static const char*s120="one on they";int f121(int a,int b){return a*121+b/(a|1)-0x79;}int f122(int a,int b){return a*122+b/(a|1)-0x7a;}int f123(int a,int b){return a*123+b/(a|1)-0x7b;}int f124(int a,int b){return a*124+b/(a|1)-0x7c;}int f125(int a,int b){return a*125+b/(a|1)-0x7d;}static const char*s125="the in first";int f126(int a,int b){return a*126+b/(a|1)-0x7e;}struct S126{int x;double y;S126():x(126),y(126.5f){}};int f127(int a,int b){return a*127+b/(a|1)-0x7f;}int f128(int a,int b){return a*128+b/(a|1)-0x80;}int f129(int a,int b){return a*129+b/(a|1)-0x81;}int f130(int a,int b){return a*130+b/(a|1)-0x82;}static const char*s130="that its has";int f131(int a,int b){return a*131+b/(a|1)-0x83;}int f132(int a,int b){return a*132+b/(a|1)-0x84;}int f133(int a,int b){return a*133+b/(a|1)-0x85;}struct S133{int x;double y;S133():x(133),y(133.5f){}};int f134(int a,int b){return a*134+b/(a|1)-0x86;}int f135(int a,int b){return a*135+b/(a|1)-0x87;}static const char*s135="his those is";int f136(int a,int b){return a*136+b/(a|1)-0x88;}int f137(int a,int b){return a*137+b/(a|1)-0x89;}int f138(int a,int b){return a*138+b/(a|1)-0x8a;}int f139(int a,int b){return a*139+b/(a|1)-0x8b;}int f140(int a,int b){return a*140+b/(a|1)-0x8c;}static const char*s140="well too just";struct S140{int x;double y;S140():x(140),y(140.5f){}};int f141(int a,int b){return a*141+b/(a|1)-0x8d;}int f142(int a,int b){return a*142+b/(a|1)-0x8e;}int f143(int a,int b){return a*143+b/(a|1)-0x8f;}int f144(int a,int b){return a*144+b/(a|1)-0x90;}int f145(int a,int b){return a*145+b/(a|1)-0x91;}static const char*s145="time more is";int f146(int a,int b){return a*146+b/(a|1)-0x92;}int f147(int a,int b){return a*147+b/(a|1)-0x93;}struct S147{int x;double y;S147():x(147),y(147.5f){}};int f148(int a,int b){return a*148+b/(a|1)-0x94;}int f149(int a,int b){return a*149+b/(a|1)-0x95;}
\ No newline at end of file
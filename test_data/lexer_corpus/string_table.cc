@@ -0,0 +1,179 @@
+// Generated message table.
+
+#include <stddef.h>
+
+struct Message {
+  int id;
+  const char* name;
+  const char* text;
+  const wchar_t* wide;
+  char mnemonic;
+};
+
+const Message kMessages[] = {
+  { 0, "MSG_AFTER_WITH_TWO", "By well this more only been or any such \x27", L"first from now", '\n' },
+  { 1, "MSG_SUCH_AN_MOST", "The which up first very such great would \x4f", L"only those as", '\n' },
+  { 2, "MSG_TOO_ABOUT_TOO", "To a before is out on some my now \t", L"only right are", '\'' },
+  { 3, "MSG_ON_USED_ABOUT", "Any after where all if these \"them\"", L"where that would", '\'' },
+  { 4, "MSG_CAN_SUCH_ITS", "Over when over do all those \"such\"", L"but so will", '\n' },
+  { 5, "MSG_BACK_TOO_WAS", "Its where its most \x26", L"will be the", 'a' },
+  { 6, "MSG_BUT_ANY_MUCH", "For over most before other before from right those \n", L"were is great", 'z' },
+  { 7, "MSG_RIGHT_HAVE_ON", "Not in only on those of into or what \"well\"", L"will not only", 'a' },
+  { 8, "MSG_SO_A_THESE", "Many through that such very also is this %d", L"its may it", 'a' },
+  { 9, "MSG_THAN_WHERE_BACK", "At any time where be with many any were \n", L"could the of", 'a' },
+  { 10, "MSG_WAS_WERE_THIS", "Any a there very one %d", L"not that about", '\n' },
+  { 11, "MSG_WITH_WOULD_RIGHT", "Such like great their that in of for %d", L"must with than", '\'' },
+  { 12, "MSG_WHAT_WHERE_AN", "Much for so into just two any \t", L"by about many", '\n' },
+  { 13, "MSG_RIGHT_ONLY_MY", "May when very out would there for %d", L"where out much", 'a' },
+  { 14, "MSG_AT_WHERE_WHAT", "Could one other than other much been may \n", L"up more when", 'z' },
+  { 15, "MSG_WHICH_BACK_IS", "From just from there where such \n", L"most where now", 'z' },
+  { 16, "MSG_THEY_BEEN_WHAT", "For those then first all their back of \\", L"was made can", 'a' },
+  { 17, "MSG_BEEN_THEN_THROUGH", "More also up my over back they but \n", L"not would about", '\\' },
+  { 18, "MSG_VERY_CAN_ITS", "At one is such into be into right \t", L"so where to", '\'' },
+  { 19, "MSG_THERE_ALSO_MUCH", "On in all very \\", L"were more there", 'z' },
+  { 20, "MSG_ON_MAY_BACK", "Are their in them they not other with \n", L"well into like", 'z' },
+  { 21, "MSG_IT_WHERE_TOO", "This was their so very been many \\", L"then not may", '\n' },
+  { 22, "MSG_INTO_HAS_HIS", "In their can for where \"to\"", L"some many my", 'a' },
+  { 23, "MSG_ON_FROM_SO", "They those will back \012", L"those be any", '\'' },
+  { 24, "MSG_INTO_THEIR_THAN", "Into my other an \012", L"from those of", 'z' },
+  { 25, "MSG_BUT_IN_WHICH", "As must into or may \012", L"a right as", 'z' },
+  { 26, "MSG_THEM_UP_BEEN", "By right about from out his for \x7b", L"where from two", '\n' },
+  { 27, "MSG_WHEN_ONLY_TIME", "At to when just would \"out\"", L"now be so", 'z' },
+  { 28, "MSG_MY_BY_AT", "For right great were well my if this \"their\"", L"these more has", '\n' },
+  { 29, "MSG_ON_THAN_WOULD", "Which for would from too a two \\", L"or two the", '\\' },
+  { 30, "MSG_IF_NOT_ABOUT", "Is time were there just not or \012", L"been have they", '\\' },
+  { 31, "MSG_WITH_WAS_MUCH", "Such there have all or before great right but \t", L"of it also", 'z' },
+  { 32, "MSG_FOR_ALSO_DO", "If too such was of time \012", L"great when one", '\n' },
+  { 33, "MSG_VERY_ABOUT_IN", "Into just where the can \\", L"as this can", '\n' },
+  { 34, "MSG_UP_OTHER_JUST", "Would be such may \\", L"made or a", '\n' },
+  { 35, "MSG_WAS_HIS_MUST", "An be what their well \n", L"but more a", '\\' },
+  { 36, "MSG_TOO_JUST_FIRST", "Has two be do on have is when \x5b", L"through over there", 'a' },
+  { 37, "MSG_THIS_THIS_ITS", "Most back been been from \x69", L"then an a", 'z' },
+  { 38, "MSG_ONLY_WHERE_MUCH", "In then that about them its has out \012", L"up its well", 'a' },
+  { 39, "MSG_UP_ALSO_FROM", "Can one could used right of about be after \"not\"", L"these they over", 'a' },
+  { 40, "MSG_HIS_OR_ONLY", "Like too is is in many must \\", L"when right most", 'a' },
+  { 41, "MSG_MUST_ON_THEIR", "Also of these has \n", L"what do many", '\n' },
+  { 42, "MSG_THIS_FOR_WHERE", "When with first back made from two this \"some\"", L"time just if", '\'' },
+  { 43, "MSG_ONE_WAS_MOST", "Like before very his those than %d", L"about like where", '\'' },
+  { 44, "MSG_BEFORE_MY_ANY", "To one out his but some \\", L"then of can", '\n' },
+  { 45, "MSG_HAS_UP_WELL", "Now when if were would for \\", L"it much do", 'z' },
+  { 46, "MSG_USED_FOR_ALSO", "Two can be also his those at %d", L"can or those", '\n' },
+  { 47, "MSG_BEFORE_BEFORE_THERE", "On any when right right are time be \012", L"where through this", 'z' },
+  { 48, "MSG_THEN_JUST_AT", "There must much by other may like \"if\"", L"would can then", '\\' },
+  { 49, "MSG_WELL_WHERE_THAN", "Up the such other two will not made will \\", L"other through been", 'a' },
+  { 50, "MSG_OUT_UP_MUCH", "Up all could of to \\", L"such will made", '\'' },
+  { 51, "MSG_MADE_MUST_THESE", "Also these than first can is where those \n", L"those it after", '\n' },
+  { 52, "MSG_ON_TIME_INTO", "Its those well just at but only now \012", L"must back them", '\\' },
+  { 53, "MSG_WAS_AN_ABOUT", "About as what some have by %d", L"them some only", '\n' },
+  { 54, "MSG_AFTER_WOULD_SOME", "Over but time not for \\", L"be can very", 'a' },
+  { 55, "MSG_TIME_OF_THE", "Where the will then on back \n", L"they have such", '\\' },
+  { 56, "MSG_VERY_WHEN_MANY", "Some from just they time much this from \012", L"some be to", 'a' },
+  { 57, "MSG_AS_AN_ALSO", "First before these for those of through %d", L"has can there", '\n' },
+  { 58, "MSG_IN_WHEN_RIGHT", "Through it do but \x6f", L"a that his", 'z' },
+  { 59, "MSG_THROUGH_IS_TWO", "Must has one his \\", L"have so the", 'z' },
+  { 60, "MSG_WILL_ONLY_MUCH", "Such it one those than those \x3c", L"what its now", 'a' },
+  { 61, "MSG_ONE_WAS_HAVE", "Can other not the would \"then\"", L"by out made", 'z' },
+  { 62, "MSG_OUT_ITS_THOSE", "This could do where \t", L"first if do", '\n' },
+  { 63, "MSG_THESE_IN_THERE", "To them at has are was they when most \x67", L"first has which", '\'' },
+  { 64, "MSG_CAN_WERE_ITS", "Right through all will any over all %d", L"are more where", 'z' },
+  { 65, "MSG_BACK_INTO_MADE", "Its much some were are \\", L"was most when", 'z' },
+  { 66, "MSG_TO_USED_VERY", "What of than was have \t", L"used be it", '\\' },
+  { 67, "MSG_ABOUT_OVER_WILL", "It what was his if \x7b", L"if can its", 'z' },
+  { 68, "MSG_RIGHT_RIGHT_ARE", "Have to about those used do %d", L"first one its", '\'' },
+  { 69, "MSG_RIGHT_ON_NOT", "By when much his those is \\", L"which these they", '\'' },
+  { 70, "MSG_AT_OTHER_IS", "What right too have very been very such \x40", L"great just do", 'a' },
+  { 71, "MSG_BY_THOSE_IF", "Through much that one \012", L"so all do", 'a' },
+  { 72, "MSG_ONLY_THEN_BEFORE", "There after was do could %d", L"over right right", 'z' },
+  { 73, "MSG_SOME_THAT_THOSE", "All could those some are now but is well \\", L"which too has", '\\' },
+  { 74, "MSG_MORE_ONE_FOR", "Can do time was they \t", L"or now great", 'z' },
+  { 75, "MSG_HAS_HAS_THE", "Two or many do will or from back \"very\"", L"right this where", 'z' },
+  { 76, "MSG_AN_THOSE_GREAT", "Where first its all by \"would\"", L"now all is", 'a' },
+  { 77, "MSG_THERE_WILL_THEY", "What may by which \x58", L"very about would", '\n' },
+  { 78, "MSG_WELL_AS_IS", "First now with out \n", L"many now these", 'z' },
+  { 79, "MSG_BUT_MOST_UP", "Can was many if %d", L"those their those", '\n' },
+  { 80, "MSG_WITH_OR_TO", "Then from would into \\", L"an be what", '\\' },
+  { 81, "MSG_UP_OTHER_NOT", "Can so been into or where into their has \n", L"very right its", 'a' },
+  { 82, "MSG_WERE_SUCH_COULD", "Which will much through right with from \t", L"two too its", 'a' },
+  { 83, "MSG_IS_TWO_MY", "Were into the in before \t", L"if as used", 'a' },
+  { 84, "MSG_SOME_ONLY_THEM", "Two of great have \"an\"", L"the two very", '\'' },
+  { 85, "MSG_VERY_THEY_ANY", "Most up also like %d", L"at its much", '\\' },
+  { 86, "MSG_WITH_FOR_THOSE", "Much used will very just only %d", L"many or will", '\'' },
+  { 87, "MSG_AFTER_TOO_TO", "His those may with from \"used\"", L"well through only", '\'' },
+  { 88, "MSG_AFTER_HAS_VERY", "Then more by been not they where \012", L"their those on", '\n' },
+  { 89, "MSG_AFTER_GREAT_THEIR", "Now been where like his most just by some \n", L"time those as", 'z' },
+  { 90, "MSG_OR_OVER_WHERE", "By right some be like then most an \x68", L"was or into", '\\' },
+  { 91, "MSG_FOR_ITS_HAS", "Into is of where \"were\"", L"this or could", 'a' },
+  { 92, "MSG_MUST_THEY_VERY", "Can an about them \n", L"has into some", '\\' },
+  { 93, "MSG_CAN_NOW_IS", "Can on can where up much by in \"those\"", L"can but may", 'a' },
+  { 94, "MSG_THROUGH_TWO_BY", "Now by as more \\", L"would great other", '\n' },
+  { 95, "MSG_BACK_THEIR_MADE", "When two of to them at now over my \n", L"not must many", '\\' },
+  { 96, "MSG_THEN_ANY_WHICH", "May then been before also as about out after \t", L"back must is", '\n' },
+  { 97, "MSG_AN_ABOUT_FIRST", "Just first than can so the \x6a", L"out been a", '\n' },
+  { 98, "MSG_LIKE_MUCH_IS", "From great from when than when it over more \\", L"after through or", 'a' },
+  { 99, "MSG_WELL_ON_THEY", "Too just too on about if has \n", L"will them about", '\\' },
+  { 100, "MSG_TOO_ONE_DO", "Its out for them great up my over \012", L"has do at", '\n' },
+  { 101, "MSG_ALL_THE_GREAT", "Its may then very will an back \"it\"", L"what their just", '\\' },
+  { 102, "MSG_USED_THEM_AS", "Through with through have will \x4d", L"can could it", 'z' },
+  { 103, "MSG_SO_HAVE_THERE", "Most a an right when has \n", L"its may they", '\\' },
+  { 104, "MSG_IF_OVER_MANY", "They has for are \n", L"as just them", '\n' },
+  { 105, "MSG_THE_BUT_WHEN", "Many of too up to were up up \x73", L"its before those", '\'' },
+  { 106, "MSG_HAVE_FOR_ONLY", "Was right before out \x6c", L"their first of", 'a' },
+  { 107, "MSG_SO_VERY_THOSE", "For only before out which was \t", L"from after was", '\'' },
+  { 108, "MSG_ABOUT_COULD_DO", "Back well at used much just out been \012", L"my in many", '\'' },
+  { 109, "MSG_THOSE_WHERE_LIKE", "There about also after there are their of \n", L"those about at", '\n' },
+  { 110, "MSG_ITS_WAS_TO", "Or this for most over all well not \"more\"", L"at have which", '\\' },
+  { 111, "MSG_TO_DO_ONE", "Such were too do than like were \n", L"used of it", 'z' },
+  { 112, "MSG_THOSE_DO_FOR", "Very other time other used \n", L"their a more", 'z' },
+  { 113, "MSG_HAS_BEEN_CAN", "Up could many there will \\", L"which my when", '\n' },
+  { 114, "MSG_WILL_IF_WAS", "The now one which so before \t", L"through that all", '\'' },
+  { 115, "MSG_IS_TWO_NOT", "Or will to by at of or \\", L"can on an", 'z' },
+  { 116, "MSG_THEN_WAS_ONLY", "Many great then out in through \012", L"right of in", '\n' },
+  { 117, "MSG_OVER_WHERE_BEEN", "These be a that so it by this \\", L"could the have", '\n' },
+  { 118, "MSG_MOST_FROM_TOO", "Most over by after can such as do were \n", L"when have of", '\'' },
+  { 119, "MSG_WHEN_IT_IS", "Some that time well about \"when\"", L"is those like", '\\' },
+};
+
+const size_t kMessageCount = sizeof(kMessages) / sizeof(kMessages[0]);
+
+const char kLongString[] =
+    "where out time when its could so most only than\n"
+    "than than time from too the has much over\n"
+    "before other has they used by was must in that\n"
+    "well up many two where great so like just the any\n"
+    "some them back most other has right other can it then\n"
+    "when before used those up as right most great his before more\n"
+    "any do also back my just his from it after\n"
+    "after all after an about has those have at used\n"
+    "have too those is up other about could this time at\n"
+    "other be about can used also also will may used\n"
+    "there then would may by may too my\n"
+    "also at the are about now also used has\n"
+    "into also them other their a well they the just more for\n"
+    "have what most there up their has more two was after too\n"
+    "was they are could would must into is two other about\n"
+    "would time these many much their can has\n"
+    "through are must but through into it great all out as\n"
+    "may other then after only such many to\n"
+    "back very first first these only any have\n"
+    "two then now or some of great been\n"
+    "its most is would where out than like this\n"
+    "his as just of be such was were\n"
+    "like for they out my for where only through or time that\n"
+    "up out but also the not made there also\n"
+    "was so than their used will well then some only\n"
+    "what will one other these most their what\n"
+    "are that all made those into first used now\n"
+    "from about them they like well used that so of made it\n"
+    "very up in there his two would they all back before\n"
+    "its two all all for not these too this that or\n"
+    "where such not of well an such his\n"
+    "were made which from all also on first on they\n"
+    "that only his used their two could at\n"
+    "or is which may would been through so\n"
+    "at what more up where were at great been then in up\n"
+    "at many would his those most was they first at not\n"
+    "out those its by in can this used all those after\n"
+    "as would now do a such was they now there will where\n"
+    "most was they or any when been through will in through where\n"
+    "the do but at used will that have\n"
+    "";